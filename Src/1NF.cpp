@@ -27,40 +27,54 @@
 #include "TernaryGrayCode.h"
 
 #include "1NF.h"
+#include "Nearsort2.h"
 
-/// Create a ternary Gray code generator and set the first layer to the
-/// identity matching, which places comparators between channels 0 and 1,
-/// 2 and 3, 4 and 5, etc.
-
-C1NF::C1NF(): CSortingNetwork(){
-  delete m_pGrayCode;
-  m_pGrayCode = new CTernaryGrayCode;
+/// Set the first layer to the identity matching, which places comparators
+/// between channels 0 and 1, 2 and 3, 4 and 5, etc., and allocate the level
+/// transfer tables if they are to be used.
 
+template<size_t N, size_t D, class T> C1NF<N, D, T>::C1NF(): Base(){
   //first layer is the identity matching
 
-  const size_t n = evenfloor(m_nWidth); 
+  const size_t n = evenfloor(N); 
 
   for(size_t i=0; i<n; i++)
-    m_nComparator[0][i] = i ^ 1;
+    m_nComparator[0][i] = (uint8_t)(i ^ 1);
+
+  if(m_eEngine == eEngine::Table)
+    m_pLevelTable = new CLevelTable<N, D>;
 } //constructor
 
+/// Delete the level transfer tables.
+
+template<size_t N, size_t D, class T> C1NF<N, D, T>::~C1NF(){
+  delete m_pLevelTable;
+} //destructor
+
 /// Initialize the network for the sorting test, that is, make the Gray code
 /// word for input be all zeros, and the values on every channel at every level
 /// be zero.
 
-void C1NF::Initialize(){ 
-  m_pGrayCode->Initialize(); //initialize the Gray code to all zeros.
-  InitValues(1, m_nDepth - 1); //initialize the network values to all zeros.
-  m_nZeros = m_nWidth; //all zeros
+template<size_t N, size_t D, class T> void C1NF<N, D, T>::Initialize(){ 
+  m_cGrayCode.Initialize(); //initialize the Gray code to all zeros.
+  InitValues(1, D - 1); //initialize the network values to all zeros.
+  m_nZeros = N; //all zeros
 } //initialize
 
 /// Check that sorting network sorts when the current input has channel flipped.
 /// \param delta Index of channel to flip.
 /// \return true if it still sorts when channel is flipped.
 
-bool C1NF::StillSorts(const size_t delta){
-  const size_t nTarget = m_nValue[1][delta]? m_nZeros: m_nZeros - 1;
-  return FlipInput(delta, 1, m_nDepth - 1) == nTarget;
+template<size_t N, size_t D, class T> bool C1NF<N, D, T>::StillSorts(const size_t delta){
+  const size_t nTarget = ((m_nValue[1] >> delta) & 1)? m_nZeros: m_nZeros - 1;
+  
+  if(FlipInput(delta, 1, D - 1) == nTarget)
+    return true;
+
+  const uint32_t t = GetTransition(delta); //this change is a counterexample
+  m_cWitness.Insert(&t, 1);
+
+  return false;
 } //StillSorts
 
 /// Check whether sorting network sorts all inputs. Works for even number of
@@ -70,13 +84,15 @@ bool C1NF::StillSorts(const size_t delta){
 /// hypothetical last even-numbered channel will not be changed.
 /// \return true iff it sorts
 
-bool C1NF::EvenSorts(){ 
+template<size_t N, size_t D, class T> bool C1NF<N, D, T>::EvenSorts(){ 
   size_t i = 0;  //index of bit to flip
   bool bSorts = true; //assume it sorts until we find otherwise
 
-  while(bSorts && i < m_nWidth){ //bail if it doesn't sort, or we've tried all binary inputs
-    i = m_pGrayCode->Next(); //next bit to flip in Gray code order
-    bSorts = bSorts && (i >= m_nWidth || StillSorts(i)); //check whether it still sorts when this bit is flipped
+  while(bSorts && i < N){ //bail if it doesn't sort, or we've tried all binary inputs
+    i = m_cGrayCode.Next(); //next bit to flip in Gray code order
+    bSorts = bSorts && (i >= N || static_cast<Derived*>(this)->StillSorts(i)); //check whether it still sorts when this bit is flipped
+    m_nTested++;
+    m_cStats.CountVector();
   } //while
 
   return bSorts;
@@ -86,25 +102,143 @@ bool C1NF::EvenSorts(){
 /// number of channels. The difference between this and `CSortingNetwork::sorts()`
 /// is that this version has to handle any hypothetical last even-numbered
 /// channel separately, testing it first with value zero then with value 1.
+/// If the sorting test engine is `eEngine::BitSlice`, then all inputs are
+/// pushed through the comparator network at once instead, and if it is
+/// `eEngine::Table`, they are pushed through the level transfer tables
+/// instead. Otherwise, the
+/// counterexample cache is tried before the Gray code sweep.
 /// \return true iff it sorts
 
-bool C1NF::Sorts(){ 
+template<size_t N, size_t D, class T> bool C1NF<N, D, T>::Sorts(){ 
+  if(m_eEngine == eEngine::BitSlice){ //test all inputs at once
+    m_cBitSlice.Evaluate(m_nComparator, D - 1);
+    return m_cBitSlice.Sorted();
+  } //if
+
+  if(m_eEngine == eEngine::Table){ //one table lookup per level
+    m_pLevelTable->Evaluate(m_nComparator, D - 1);
+    return m_pLevelTable->Sorted();
+  } //if
+
+  if(Refuted(m_cWitness, D - 1, 0, 0, 0))
+    return false; //a recent counterexample still works
+
   //first handle the case where n is even, and the case where n is odd
   //and fails to sort an input that ends with a zero
-  Initialize(); //set all channels to zero
-  if(!EvenSorts())return false;  //test inputs ending in zero
+  static_cast<Derived*>(this)->Initialize(); //set all channels to zero
+  bool bSorts = EvenSorts(); //test inputs ending in zero
 
   //if odd number of inputs, check input that end with a one 
-  if(odd(m_nWidth)){   
-    Initialize(); //set all channels to zero
+  if(bSorts && odd(N)){   
+    static_cast<Derived*>(this)->Initialize(); //set all channels to zero
 
-    for(int j=0; j<m_nDepth; j++) //set all values on last channel to one
-      m_nValue[j][m_nWidth - 1] = 1;
+    for(int j=0; j<D; j++) //set all values on last channel to one
+      m_nValue[j] |= 1 << (N - 1);
 
-    m_nZeros = m_nWidth - 1; //correct the count of zeros
+    m_nInput = (size_t)1 << (N - 1); //input ends with a one
+    m_nZeros = N - 1; //correct the count of zeros
 
-    if(!EvenSorts())return false; //test inputs ending with one
+    bSorts = EvenSorts(); //test inputs ending with one
   } //if
 
-  return true; //Oh, we made it this far? Then I must be a sorting network. Hurray!
+  if(!bSorts)
+    m_cWitness.Reject(m_nTested);
+
+  return bSorts; //if true, I must be a sorting network. Hurray!
 } //sorts
+
+/// Encode the test input change that has just been made, that is, the input
+/// to the second level before channel delta was flipped, together with delta.
+/// This must be called after `CSortingNetwork::FlipInput()`.
+/// \param delta Index of the channel that was flipped.
+/// \return Input in the low 16 bits and delta in the high 16 bits.
+
+template<size_t N, size_t D, class T>
+uint32_t C1NF<N, D, T>::GetTransition(const size_t delta) const{
+  return (uint32_t)(m_nInput ^ ((size_t)1 << delta)) | (uint32_t)delta << 16;
+} //GetTransition
+
+/// Try the witnesses in a counterexample cache on the current candidate.
+/// Each witness is pushed through the comparator network from the second
+/// level down to a given level all at once, bit-sliced as in `CBitSlice`.
+/// Each test input change in it then connects the channel whose value
+/// changes to the channel of the sorted output that changes, unless they are
+/// the same channel. The witness refutes the candidate if the channels so
+/// connected break the same thresholds as the reachability heuristic of
+/// `CNearsort::StillNearsorts()`. Thresholds of 0 give the sorting test, and
+/// thresholds of 1 give the autocomplete test, since the last level must then
+/// be a matching. This also starts the count of test input changes tried on
+/// the candidate.
+/// \param cache Counterexample cache.
+/// \param last Last level.
+/// \param nFrom Maximum number of channels reachable from any channel.
+/// \param nTo Maximum number of channels that can reach any channel.
+/// \param nBoth Maximum number of channels reachable from or to any channel.
+/// \return true if some cached witness refutes the candidate.
+
+template<size_t N, size_t D, class T>
+bool C1NF<N, D, T>::Refuted(CWitnessCache& cache, const size_t last, const size_t nFrom,
+  const size_t nTo, const size_t nBoth)
+{
+  m_nTested = 0; //new candidate
+  cache.Lookup();
+
+  for(size_t w=0; w<cache.GetSize(); w++){ //for each witness
+    uint32_t mask[N]; //values before and after each change
+    const uint32_t* witness = cache.GetMask(w);
+    const uint8_t* target = cache.GetTarget(w);
+
+    for(size_t j=0; j<N; j++)
+      mask[j] = witness[j];
+
+    for(size_t i=1; i<=last; i++) //for each level in range
+      for(size_t j=0; j<N; j++){ //for each channel
+        const size_t k = m_nComparator[i][j]; //channel joined via a comparator
+
+        if(k > j){ //comparator between j and k, minimum goes to j
+          const uint32_t a = mask[j];
+          mask[j] = a & mask[k];
+          mask[k] = a | mask[k];
+        } //if
+      } //for
+
+    uint32_t nReachFrom[N] = {0}; //channels reachable from each channel
+    uint32_t nReachTo[N] = {0}; //channels reachable to each channel
+
+    for(size_t j=0; j<N; j++){ //for each channel
+      uint32_t nChanged = (mask[j] ^ (mask[j] >> 16)) & 0xFFFF; //changes on j
+
+      while(nChanged){ //for each change on channel j
+        const size_t k = target[LowBit(nChanged)]; //sorted output channel
+        nChanged &= nChanged - 1;
+
+        if(j != k){ //j reaches k
+          nReachFrom[j] |= 1 << k;
+          nReachTo[k] |= 1 << j;
+        } //if
+      } //while
+    } //for
+
+    m_nTested += cache.GetLength(w);
+
+    for(size_t j=0; j<N; j++) //check thresholds
+      if(PopCount(nReachFrom[j]) > nFrom || PopCount(nReachTo[j]) > nTo ||
+        PopCount(nReachFrom[j] | nReachTo[j]) > nBoth)
+      {
+        cache.Hit(w);
+        cache.Reject(m_nTested);
+        return true;
+      } //if
+  } //for
+
+  return false;
+} //Refuted
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class C1NF<n, d, C2NF<n, d>>; \
+  template class C1NF<n, d, CAutocomplete<n, d>>; \
+  template class C1NF<n, d, CNearsort<n, d>>; \
+  template class C1NF<n, d, CNearsort2<n, d>>;
+FOR_EACH_SHAPE(INSTANTIATE)
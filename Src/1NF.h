@@ -26,7 +26,28 @@
 #ifndef __1NF_h__
 #define __1NF_h__
 
+#include <type_traits>
+
 #include "SortingNetwork.h"
+#include "TernaryGrayCode.h"
+#include "BitSlice.h"
+#include "LevelTable.h"
+#include "WitnessCache.h"
+#include "Stats.h"
+
+/// \brief Most derived class.
+///
+/// The searchable sorting network classes from `C1NF` down use the curiously
+/// recurring template pattern: each takes as its last template parameter the
+/// most derived class `T`, or `void` if it is the most derived class itself,
+/// and calls the functions that its descendants override through a pointer
+/// to `MostDerived<T, Self>`. These calls are resolved at compile time and can
+/// be inlined, unlike virtual function calls.
+/// \tparam T Most derived class, or `void`.
+/// \tparam Self The class that uses this.
+
+template<class T, class Self> using MostDerived =
+  typename std::conditional<std::is_void<T>::value, Self, T>::type;
 
 /// \brief Sorting network in first normal form.
 ///
@@ -57,10 +78,50 @@
 /// the sorting test since we need only test ternary Gray code strings
 /// (00, 01, and 11 as inputs to pairs of channels) instead of binary Gray code
 /// strings. These are generated using an instance of `CTernaryGrayCode`
-/// instead of the instance of `CBinaryGrayCode`. 
+/// instead of the instance of `CBinaryGrayCode`. Alternatively, if the
+/// sorting test engine is `eEngine::BitSlice`, all of these inputs are tested
+/// at once using an instance of `CBitSlice`, and if it is `eEngine::Table`,
+/// they are pushed through the precomputed level transfer tables of an
+/// instance of `CLevelTable`, which is allocated only in that case since
+/// its tables are large.
+///
+/// With the Gray code engine, the test inputs that made the previous candidates
+/// fail are kept in a counterexample cache `CWitnessCache` and tried first by
+/// `C1NF::Refuted()`.
+///
+/// The search statistics counters `C1NF::m_cStats` are kept here so that the
+/// sorting and nearsort tests can count the test inputs that they try.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
 
-class C1NF: public CSortingNetwork{
+template<size_t N, size_t D, class T = void>
+class C1NF: public CSortingNetwork<N, D, CTernaryGrayCode<N>>{
   protected: 
+    typedef MostDerived<T, C1NF> Derived; ///< Most derived class.
+    typedef CSortingNetwork<N, D, CTernaryGrayCode<N>> Base; ///< Base class.
+
+    using Base::m_eEngine;
+    using Base::m_nComparator;
+    using Base::m_cGrayCode;
+    using Base::m_nValue;
+    using Base::m_nZeros;
+    using Base::m_nInput;
+    using Base::InitValues;
+    using Base::FlipInput;
+
+    CBitSlice<N, D> m_cBitSlice; ///< Bit-sliced sorting test.
+    CLevelTable<N, D>* m_pLevelTable = nullptr; ///< Level transfer table sorting test, if used.
+
+    CWitnessCache m_cWitness; ///< Counterexample cache for the sorting test.
+    uint32_t m_nPairWitness[N][N] = {{0}}; ///< Test input change that first connected each pair of channels.
+    size_t m_nTested = 0; ///< Number of test input changes tried on the current candidate.
+    CStats m_cStats; ///< Search statistics counters.
+
+    uint32_t GetTransition(const size_t) const; ///< Encode the last test input change.
+    bool Refuted(CWitnessCache&, const size_t, const size_t, const size_t, const size_t); ///< Try cached witnesses.
+
     void Initialize(); ///< Initialize the sorting test.
     bool Sorts(); ///< Does it sort all inputs?
 
@@ -69,6 +130,7 @@ class C1NF: public CSortingNetwork{
 
   public:
     C1NF(); ///< Constructor.
+    ~C1NF(); ///< Destructor.
 }; //C1NF
 
 #endif //__1NF_h__
\ No newline at end of file
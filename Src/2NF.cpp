@@ -23,47 +23,117 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <sstream>
+
 #include "2NF.h"
+#include "Nearsort2.h"
 #include "Defines.h"
 
 /// Constructor.
-/// \param L2Matching Level 2 matching.
-/// \param index Lexicographic number of level 2 matching.
+/// \param prefix Prefix of fixed levels.
+/// \param index Index of task.
+/// \param first Index of first matching at the level below the prefix.
+/// \param last One more than the index of the last matching at that level.
 
-C2NF::C2NF(CMatching& L2Matching, const size_t index): 
-  CSearchable(),
-  m_nLevel2Index(index)
+template<size_t N, size_t D, class T>
+C2NF<N, D, T>::C2NF(const CPrefix<N>& prefix, const size_t index,
+  const size_t first, const size_t last): 
+  Base(),
+  m_nTaskIndex(index),
+  m_nFixed(prefix.GetNumLevels()),
+  m_stlSymmetry(prefix.GetSymmetries())
 {
-  m_nStack[0] = 0;
   InitMatchingRepresentations(0); //the level 1 matching is the identity
 
-  for(int j=0; j<m_nWidth; j++)
-    m_cMatching[1][j] = L2Matching[j]; //install second level candidate
+  for(size_t i=1; i<m_nFixed; i++) //install the rest of the prefix
+    for(size_t j=0; j<N; j++)
+      m_nComparator[i][j] = prefix.GetLevel(i)[j];
+
+  m_nTop = m_nFixed; //the level below the prefix
+  m_nFirst = first;
+  m_nLast = last;
+  this->m_nRoot = index; //its own root unless it is split off another task
 } //constructor
 
+/// Check whether the matching on the stack at a given level should be
+/// skipped, that is, if `CSearchable::Skip()` says so, or if it is the third
+/// level and one of the symmetries of the prefix in `m_stlSymmetry` maps it
+/// to a smaller one.
+/// \param level A level whose predecessors are synchronized.
+/// \return true if the matching should be skipped.
+
+template<size_t N, size_t D, class T> bool C2NF<N, D, T>::Skip(size_t level){
+  if(Base::Skip(level))
+    return true;
+
+  if(level != 2)
+    return false;
+
+  return !CPrefix<N>::Smallest(m_stlSymmetry, CMatchingTable<N>::GetComparators(m_nStack[level]));
+} //Skip
+
 /// Initialize and then start a backtracking search for all sorting networks
-/// in Second Normal Form of given width and depth.
+/// in Second Normal Form of given width and depth that start with the prefix,
+/// or if resuming, carry on after the candidate that was processed last.
+
+template<size_t N, size_t D, class T> void C2NF<N, D, T>::Backtrack(){ 
+  if(m_bStarted){ //resuming
+    if(NextComparatorNetwork()) //move on from the last candidate processed
+      Search(); //resume search
+  } //if
 
-void C2NF::Backtrack(){ 
-  if(odd(m_nWidth))m_cMatching[1][m_nWidth] = m_nWidth; 
-  SynchMatchingRepresentations(1); //synch representation for testing
-  FirstComparatorNetwork(2); //initialize from there down
-  Search(); //begin actual search
+  else if(FirstComparatorNetwork(m_nFixed)) //initialize from there down
+    Search(); //begin actual search
 } //Backtrack
 
-/// Save a generated sorting network into a file with a suitable name.
-/// Save comparator network to a file whose name encodes number of inputs,
-/// depth, second level index, and order found. For example, an 8-input 
-/// comparator network of depth 5 with second level index 99 that is the 20th
-/// sorting network found with that second level, would be saved to file 
-/// `w8d5x99n20.txt`.
-
-void C2NF::Save(){
-  std::string filename = //construct file name
-    "w" + std::to_string(m_nWidth) + 
-    "d" + std::to_string(m_nDepth) +
-    "x" + std::to_string(m_nLevel2Index) +
-    "n" + std::to_string(m_nCount) + ".txt"; 
-
-  CComparatorNetwork::Save(filename); //save to file with that name
+/// Save the task index, the prefix that is fixed above the topmost level,
+/// the range of matchings at the topmost level, and then the rest of the
+/// resumable state from `CSearchable::Checkpoint()`. A search that carries
+/// on from this state is made by constructing the most derived class from
+/// the first four and then calling `CSearchable::Resume()`.
+/// \param s [out] Stream to save to.
+
+template<size_t N, size_t D, class T>
+void C2NF<N, D, T>::Checkpoint(std::ostream& s) const{
+  s << m_nTaskIndex << " " << m_nTop; //task index and number of fixed levels
+
+  for(size_t i=1; i<m_nTop; i++) //prefix below the identity first level
+    for(size_t j=0; j<N; j++)
+      s << " " << (int)m_nComparator[i][j];
+
+  s << " " << m_nFirst << " " << m_nLast; //range at topmost level
+
+  Base::Checkpoint(s);
+} //Checkpoint
+
+/// Reader function for the task index.
+/// \return The task index.
+
+template<size_t N, size_t D, class T> const size_t C2NF<N, D, T>::GetIndex() const{
+  return m_nTaskIndex;
+} //GetIndex
+
+/// Save a generated sorting network into a file whose name encodes number of
+/// inputs, depth, task index, and order found, from `CSettings::GetFileName()`,
+/// or if `KeepNetworks()` has been called, keep it in memory so that a worker
+/// can send it to the coordinator, which saves it to that file.
+
+template<size_t N, size_t D, class T> void C2NF<N, D, T>::Save(){
+  if(this->m_bKeep){ //keep it in memory
+    std::ostringstream s;
+    CComparatorNetwork<N, D>::Save(s);
+    this->m_stlNetworks.push_back(s.str());
+  } //if
+
+  else CComparatorNetwork<N, D>::Save(CSettings::GetFileName(N, D, m_nTaskIndex,
+    m_nCount));
 } //Save
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class C2NF<n, d>; \
+  template class C2NF<n, d, CAutocomplete<n, d>>; \
+  template class C2NF<n, d, CNearsort<n, d>>; \
+  template class C2NF<n, d, CNearsort2<n, d>>;
+FOR_EACH_SHAPE(INSTANTIATE)
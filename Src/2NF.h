@@ -26,25 +26,75 @@
 #ifndef __2NF_h_
 #define __2NF_h_
 
+#include <vector>
+
 #include "Searchable.h"
 #include "Level2Search.h"
+#include "Prefix.h"
 
 /// \brief Second normal form searchable sorting network.
 ///
 /// A first normal form sorting network that will be given its second level
 /// from a generator `CLevel2Search` that provides second level candidates
-/// unique up to symmetry.
+/// unique up to symmetry, or more generally, a prefix of fixed levels
+/// from `CPrefixSearch`.
+///
+/// The symmetries used by `CLevel2Search`, namely permutations of the pairs
+/// of channels in the first level, possibly followed by reflection, may
+/// still map the first two levels to themselves. Each of these maps any third
+/// level to an equivalent one, after untwisting any second level comparators
+/// that it turns upside down. If `CSettings::m_bSymmetry` is true, then
+/// `CPrefix` finds the resulting permutations of the third level once per
+/// second level, and `C2NF::Skip()` skips every third level that one of them
+/// maps to a smaller one in the order of their testable representations.
+///
+/// A task need not enumerate every matching at the level below its prefix.
+/// It may instead be given a contiguous range of indices into
+/// `CMatchingTable` for that level, so that the work under a large prefix
+/// can be split between several tasks.
+///
+/// `C2NF::Checkpoint()` saves enough to reconstruct the task, followed by the
+/// state of its search, and a task reconstructed from it resumes where the
+/// saved one left off.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
+
+template<size_t N, size_t D, class T = void>
+class C2NF: public CSearchable<N, D, MostDerived<T, C2NF<N, D, T>>>{
+  template<size_t, size_t, class> friend class CSearchable;
 
-class C2NF: public CSearchable{ 
   protected:
-    size_t m_nLevel2Index = 0; ///< Index of current level 2 candidate.
+    typedef MostDerived<T, C2NF> Derived; ///< Most derived class.
+    typedef CSearchable<N, D, Derived> Base; ///< Base class.
+
+    using Base::m_nCount;
+    using Base::m_nComparator;
+    using Base::m_nStack;
+    using Base::m_nFirst;
+    using Base::m_nLast;
+    using Base::m_nTop;
+    using Base::m_bStarted;
+    using Base::Skip;
+    using Base::FirstComparatorNetwork;
+    using Base::InitMatchingRepresentations;
+    using Base::NextComparatorNetwork;
+    using Base::Search;
+
+    size_t m_nTaskIndex = 0; ///< Index of this task.
+    size_t m_nFixed = 2; ///< Number of fixed levels in the prefix.
+    std::vector<uint8_t> m_stlSymmetry; ///< Permutations of the third level, `N` entries each.
 
     void Save(); ///< Save comparator network.
+    bool Skip(size_t); ///< Should a matching be skipped?
 
   public:
-    C2NF(CMatching&, const size_t); ///< Constructor.
+    C2NF(const CPrefix<N>&, const size_t, const size_t, const size_t); ///< Constructor.
 
     void Backtrack();  ///< Backtracking search.
+    void Checkpoint(std::ostream&) const; ///< Save resumable state.
+    const size_t GetIndex() const; ///< Get task index.
 }; //C2NF
 
 #endif //__2NF_h_
\ No newline at end of file
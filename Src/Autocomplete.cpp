@@ -24,15 +24,20 @@
 // IN THE SOFTWARE.
 
 #include "Autocomplete.h"
+#include "Nearsort2.h"
 
 #include "Defines.h"
 
 /// Constructor.
-/// \param L2Matching Level 2 matching.
-/// \param index Lexicographics number of level 2 matching.
-
-CAutocomplete::CAutocomplete(CMatching& L2Matching, const size_t index):
-  C2NF(L2Matching, index){
+/// \param prefix Prefix of fixed levels.
+/// \param index Index of task.
+/// \param first Index of first matching at the level below the prefix.
+/// \param last One more than the index of the last matching at that level.
+
+template<size_t N, size_t D, class T>
+CAutocomplete<N, D, T>::CAutocomplete(const CPrefix<N>& prefix, const size_t index,
+  const size_t first, const size_t last):
+  Base(prefix, index, first, last){
 } //constructor
 
 /// Check whether stub of a sorting network sorts when the current input has
@@ -41,9 +46,10 @@ CAutocomplete::CAutocomplete(CMatching& L2Matching, const size_t index):
 /// \param delta Index of channel to flip.
 /// \return true if it still sorts when channel is flipped.
 
-bool CAutocomplete::StillSorts(const size_t delta){
-  size_t k = m_nValue[1][delta]? m_nZeros: m_nZeros - 1; //destination channel
-  size_t j = FlipInput(delta, 1, m_nDepth - 2);
+template<size_t N, size_t D, class T>
+bool CAutocomplete<N, D, T>::StillSorts(const size_t delta){
+  size_t k = ((m_nValue[1] >> delta) & 1)? m_nZeros: m_nZeros - 1; //destination channel
+  size_t j = FlipInput(delta, 1, D - 2);
 
   //Build last layer, if necessary. Changed channel is currently j.
   
@@ -51,20 +57,30 @@ bool CAutocomplete::StillSorts(const size_t delta){
     return true; //success
 
   else{  
-    size_t& cj = m_nComparator[m_nDepth - 1][j]; //one end of comparator
-    size_t& ck = m_nComparator[m_nDepth - 1][k]; //other end of comparator
+    uint8_t& cj = m_nComparator[D - 1][j]; //one end of comparator
+    uint8_t& ck = m_nComparator[D - 1][k]; //other end of comparator
     
     if(cj == k && ck == j)
       return true; //comparator already exists  
 
     else if(cj == j && ck == k){ //both channels free
-      cj = k; 
-      ck = j; //insert comparator
+      cj = (uint8_t)k; 
+      ck = (uint8_t)j; //insert comparator
+      m_nPairWitness[j][k] = m_nPairWitness[k][j] = GetTransition(delta); //remember why
 
       return true;
     } //else if
 
-    else return false; //can't put a comparator in, so fail
+    else{ //can't put a comparator in, so fail
+      uint32_t witness[3]; //counterexample
+      size_t n = 0; //its length
+      witness[n++] = GetTransition(delta); //this change
+      if(cj != j)witness[n++] = m_nPairWitness[j][cj]; //change that put j in a comparator
+      if(ck != k)witness[n++] = m_nPairWitness[k][ck]; //change that put k in a comparator
+      m_cWitness.Insert(witness, n);
+
+      return false;
+    } //else
   } //else
 } //StillSorts
 
@@ -73,52 +89,94 @@ bool CAutocomplete::StillSorts(const size_t delta){
 /// be zero. Yhis differs from `C1NF::Initialize()` in that
 /// it doesn't initialize values in the first and last levels.
 
-void CAutocomplete::Initialize(){   
-  m_pGrayCode->Initialize(); //initialize the Gray code to all zeros.
-  InitValues(1, m_nDepth - 2); //initialize the network values to all zeros.
-  m_nZeros = m_nWidth; //all zeros
+template<size_t N, size_t D, class T> void CAutocomplete<N, D, T>::Initialize(){   
+  m_cGrayCode.Initialize(); //initialize the Gray code to all zeros.
+  InitValues(1, D - 2); //initialize the network values to all zeros.
+  m_nZeros = N; //all zeros
 } //initialize
 
 /// Initializes the testable representation of the last level of the sorting 
 /// network to be empty, that is, containing no comparators.
 
-void CAutocomplete::initLastLevel(){
-  for(int j=0; j<m_nWidth; j++) //for each channel
-    m_nComparator[m_nDepth - 1][j] = j;
+template<size_t N, size_t D, class T> void CAutocomplete<N, D, T>::initLastLevel(){
+  m_cBitSlice.Invalidate(D - 1); //cached bit-sliced outputs are out of date
+
+  if(m_pLevelTable)
+    m_pLevelTable->Invalidate(D - 1); //cached level table outputs too
+
+  for(int j=0; j<N; j++) //for each channel
+    m_nComparator[D - 1][j] = (uint8_t)j;
 } //initLastLevel
 
 /// Check whether sorting network sorts all inputs.
 /// The difference between this and `CSortingNetwork::Sorts()` is that
 /// this version has to handle any hypothetical last even-numbered channel 
 /// separately, testing it first with value zero then with value 1.
+/// If the sorting test engine is `eEngine::BitSlice`, then all inputs are
+/// pushed through to the second-last level at once and the last level is
+/// constructed from the result by `CBitSlice::Autocomplete()`. Otherwise,
+/// the counterexample cache is tried first, and a witness consists of the
+/// test input change that failed together with the ones that put its two
+/// channels into comparators in the last level.
 /// \return true iff it sorts
 
-bool CAutocomplete::Sorts(){ 
+template<size_t N, size_t D, class T> bool CAutocomplete<N, D, T>::Sorts(){ 
   initLastLevel(); //set last level to be empty, will be constructed on-the-fly
 
+  if(m_eEngine == eEngine::BitSlice){ //test all inputs at once
+    m_cBitSlice.Evaluate(m_nComparator, D - 2);
+    const bool bSorts = m_cBitSlice.Autocomplete(m_nComparator[D - 1]);
+    m_cStats.CountInsertions(m_nComparator[D - 1], N);
+    return bSorts;
+  } //if
+
+  if(m_eEngine == eEngine::Table){ //one table lookup per level
+    m_pLevelTable->Evaluate(m_nComparator, D - 2);
+    const bool bSorts = m_pLevelTable->Autocomplete(m_nComparator[D - 1]);
+    m_cStats.CountInsertions(m_nComparator[D - 1], N);
+    return bSorts;
+  } //if
+
+  if(Refuted(m_cWitness, D - 2, 1, 1, 1))
+    return false; //a recent counterexample still works
+
   //first handle the case where n is even, and the case where n is odd
   //and fails to sort an input that ends with a zero
 
   Initialize(); //set all channels to zero
-  if(!EvenSorts())return false;  //test inputs ending in zero
+  bool bSorts = EvenSorts(); //test inputs ending in zero
 
   //if odd number of inputs, check input that end with a one 
-  if(odd(m_nWidth)){   
+  if(bSorts && odd(N)){   
     Initialize(); //set all channels to zero
 
-    for(int j=0; j<m_nDepth; j++) //set all values on last channel to one
-      m_nValue[j][m_nWidth - 1] = 1;
+    for(int j=0; j<D; j++) //set all values on last channel to one
+      m_nValue[j] |= 1 << (N - 1);
 
-    m_nZeros = m_nWidth - 1; //correct the count of zeros
+    m_nInput = (size_t)1 << (N - 1); //input ends with a one
+    m_nZeros = N - 1; //correct the count of zeros
 
-    if(!EvenSorts())return false; //test inputs ending with one
+    bSorts = EvenSorts(); //test inputs ending with one
   } //if
 
-  return true; //Oh, we made it this far? Then I must be a sorting network. Hurray!
+  m_cStats.CountInsertions(m_nComparator[D - 1], N);
+
+  if(!bSorts)
+    m_cWitness.Reject(m_nTested);
+
+  return bSorts; //if true, I must be a sorting network. Hurray!
 } //sorts
 
 /// Set top of stack `m_nToS` to the second-last level of the sorting network.
 
-void CAutocomplete::SetToS(){
-  m_nToS = (int)m_nDepth - 2;
+template<size_t N, size_t D, class T> void CAutocomplete<N, D, T>::SetToS(){
+  m_nToS = (int)D - 2;
 } //SetToS
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class CAutocomplete<n, d>; \
+  template class CAutocomplete<n, d, CNearsort<n, d>>; \
+  template class CAutocomplete<n, d, CNearsort2<n, d>>;
+FOR_EACH_SHAPE(INSTANTIATE)
@@ -36,10 +36,39 @@
 /// (left) and the autocompleted path followed by a change of a zero to a one
 /// (right)."
 /// \image html autocomplete.png width=55% 
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
+
+template<size_t N, size_t D, class T = void>
+class CAutocomplete: public C2NF<N, D, MostDerived<T, CAutocomplete<N, D, T>>>{
+  template<size_t, size_t, class> friend class C1NF;
+  template<size_t, size_t, class> friend class CSearchable;
+
+  protected:
+    typedef MostDerived<T, CAutocomplete> Derived; ///< Most derived class.
+    typedef C2NF<N, D, Derived> Base; ///< Base class.
 
+    using Base::m_eEngine;
+    using Base::m_nComparator;
+    using Base::m_cGrayCode;
+    using Base::m_nValue;
+    using Base::m_nZeros;
+    using Base::m_nInput;
+    using Base::m_cBitSlice;
+    using Base::m_pLevelTable;
+    using Base::m_cWitness;
+    using Base::m_nPairWitness;
+    using Base::m_nTested;
+    using Base::m_cStats;
+    using Base::m_nToS;
+    using Base::InitValues;
+    using Base::FlipInput;
+    using Base::GetTransition;
+    using Base::Refuted;
+    using Base::EvenSorts;
 
-class CAutocomplete: public C2NF{
-  protected:  
     void SetToS(); ///< Set top of stack.
     bool StillSorts(const size_t); ///< Does it still sort when a bit is changed?
     void Initialize(); ///< Initialize the sorting test. 
@@ -47,7 +76,7 @@ class CAutocomplete: public C2NF{
     bool Sorts(); ///< Does it sort?
 
   public:
-    CAutocomplete(CMatching&, const size_t); ///< Constructor.
+    CAutocomplete(const CPrefix<N>&, const size_t, const size_t, const size_t); ///< Constructor.
 }; //CAutocomplete
 
 #endif //__Autocomplete_h__
@@ -30,10 +30,10 @@
 /// Reset Gray code generator to the first word in Gray code order, which is
 /// the all-zero word.
 
-void CBinaryGrayCode::Initialize(){ 
-  for(size_t i=0; i<=m_nWidth+2; i++){
+template<size_t N> void CBinaryGrayCode<N>::Initialize(){ 
+  for(size_t i=0; i<=N+2; i++){
     m_nBit[i] = 0; //all zeros
-    m_nStack[i] = i + 1; //recursion stack initial conditions
+    m_nStack[i] = (uint8_t)(i + 1); //recursion stack initial conditions
   } //for
 } //initialize
 
@@ -42,13 +42,13 @@ void CBinaryGrayCode::Initialize(){
 /// \return Index of the bit that has changed. 
 /// Out of range means we're finished.
 
-size_t CBinaryGrayCode::Next(){
+template<size_t N> size_t CBinaryGrayCode<N>::Next(){
   const size_t i = m_nStack[0]; //bit to change
 
   m_nStack[0] = 1; 
   m_nBit[i] ^= 1; //change bit
   m_nStack[i - 1] = m_nStack[i];
-  m_nStack[i] = i + 1;
+  m_nStack[i] = (uint8_t)(i + 1);
 
   return i - 1; //return bit changed
 } //Next
@@ -56,12 +56,17 @@ size_t CBinaryGrayCode::Next(){
 /// Print to the console a sequence of Gray code changes, that is, the
 /// index of the bit that flips to get the next binary string.
 
-void CBinaryGrayCode::Print(){
+template<size_t N> void CBinaryGrayCode<N>::Print(){
   Initialize();
   size_t i = Next(); //current index
 
-  while(i < m_nWidth){ //while not finished
+  while(i < N){ //while not finished
     std::cout << i << std::endl;
     i = Next(); //next index
   } //while
 } //Print
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CBinaryGrayCode<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
@@ -26,6 +26,8 @@
 #ifndef __BinaryGrayCode_h__
 #define __BinaryGrayCode_h__
 
+#include <cstdint>
+
 #include "Defines.h"
 #include "Settings.h"
 
@@ -62,11 +64,13 @@
 /// > Bitner, Ehrlich, and Reingold, "Efficient generation of the Binary
 /// > Reflected Gray Code and its applications", _Communications of the ACM_,
 /// > Vol. 19, No. 9, pp 517-521, 1976.
+///
+/// \tparam N Number of bits.
 
-class CBinaryGrayCode: public CSettings{
+template<size_t N> class CBinaryGrayCode: public CSettings{
   protected:
-    size_t m_nBit[MAXINPUTS + 3] = {0}; ///< Current code word.
-    size_t m_nStack[MAXINPUTS + 3] = {0}; ///< Stack to remove recursion.
+    uint8_t m_nBit[N + 3] = {0}; ///< Current code word.
+    uint8_t m_nStack[N + 3] = {0}; ///< Stack to remove recursion.
 
   public:
     virtual void Initialize(); ///< Get first code word.
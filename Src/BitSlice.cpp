@@ -0,0 +1,273 @@
+/// \file BitSlice.cpp
+/// \brief Code for the bit-sliced sorting test `CBitSlice`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "BitSlice.h"
+#include "TernaryGrayCode.h"
+
+template<size_t N, size_t D> size_t CBitSlice<N, D>::m_nNumVectors = 0;
+template<size_t N, size_t D> size_t CBitSlice<N, D>::m_nNumWords = 0;
+
+template<size_t N, size_t D>
+uint64_t CBitSlice<N, D>::m_nInput[N][MAXWORDS] = {0};
+template<size_t N, size_t D>
+uint64_t CBitSlice<N, D>::m_nTarget[N][MAXWORDS] = {0};
+template<size_t N, size_t D> uint64_t CBitSlice<N, D>::m_nTransition[MAXWORDS] = {0};
+template<size_t N, size_t D> uint8_t CBitSlice<N, D>::m_nTargetChannel[MAXVECTORS] = {0};
+
+template<size_t N, size_t D> LevelKernel CBitSlice<N, D>::m_pLevel = LevelScalar;
+template<size_t N, size_t D> UnsortedKernel CBitSlice<N, D>::m_pUnsorted = UnsortedScalar;
+template<size_t N, size_t D> MovedKernel CBitSlice<N, D>::m_pMoved = MovedScalar;
+
+/// Generate the test inputs in the same order as `C1NF::Sorts()` does, that
+/// is, in ternary Gray code order with the last channel set to zero, followed
+/// (if the width is odd) by the same with the last channel set to one. For
+/// each test input, record which channel of the sorted output changes from
+/// the previous test input. Finally, select the widest kernel supported by
+/// the CPU. This must be called after the width is set and before any
+/// instance is used.
+
+template<size_t N, size_t D> void CBitSlice<N, D>::Initialize(){
+  for(size_t j=0; j<N; j++) //clear everything
+    for(size_t w=0; w<MAXWORDS; w++)
+      m_nInput[j][w] = m_nTarget[j][w] = 0;
+
+  for(size_t w=0; w<MAXWORDS; w++)
+    m_nTransition[w] = 0;
+
+  CTernaryGrayCode<N> graycode; //test input generator
+  size_t t = 0; //index of current test input
+  const size_t nSweeps = odd(N)? 2: 1; //number of Gray code sweeps
+
+  for(size_t s=0; s<nSweeps; s++){ //for each sweep
+    size_t nInput = s? (size_t)1 << (N - 1): 0; //first test input
+    size_t nZeros = s? N - 1: N; //number of zeros in it
+    size_t i = 0; //index of bit to flip
+
+    graycode.Initialize(); //start at the all-zero word
+
+    while(i < N){ //for each test input in this sweep
+      for(size_t j=0; j<N; j++) //record test input
+        if((nInput >> j) & 1)
+          m_nInput[j][t/64] |= (uint64_t)1 << (t%64);
+
+      i = graycode.Next(); //next bit to flip
+
+      if(i < N){ //flip it
+        const size_t nTarget = (nInput >> i) & 1? nZeros: nZeros - 1; //changed sorted output
+        nZeros += (nInput >> i) & 1? 1: -1;
+        nInput ^= (size_t)1 << i;
+        t++; //next test input
+
+        m_nTarget[nTarget][t/64] |= (uint64_t)1 << (t%64);
+        m_nTransition[t/64] |= (uint64_t)1 << (t%64);
+        m_nTargetChannel[t] = (uint8_t)nTarget;
+      } //if
+    } //while
+
+    t++; //first test input of next sweep does not follow from this one
+  } //for
+
+  m_nNumVectors = t;
+  SetKernel(m_eKernel);
+} //Initialize
+
+/// Set the kernel instruction set and round the number of words per channel
+/// up to a whole number of registers. The padding words are all zero in every
+/// test input, target, and transition mask, and hence never affect the result.
+/// \param k Kernel instruction set.
+
+template<size_t N, size_t D> void CBitSlice<N, D>::SetKernel(const eKernel k){
+  switch(k){
+    case eKernel::SSE2:
+      m_pLevel = LevelSSE2;
+      m_pUnsorted = UnsortedSSE2;
+      m_pMoved = MovedSSE2;
+    break;
+
+    case eKernel::AVX2:
+      m_pLevel = LevelAVX2;
+      m_pUnsorted = UnsortedAVX2;
+      m_pMoved = MovedAVX2;
+    break;
+
+    case eKernel::AVX512:
+      m_pLevel = LevelAVX512;
+      m_pUnsorted = UnsortedAVX512;
+      m_pMoved = MovedAVX512;
+    break;
+
+    default:
+      m_pLevel = LevelScalar;
+      m_pUnsorted = UnsortedScalar;
+      m_pMoved = MovedScalar;
+    break;
+  } //switch
+
+  const size_t r = GetKernelWords(k); //words per register
+  m_nNumWords = r*((m_nNumVectors + 64*r - 1)/(64*r));
+} //SetKernel
+
+/// Report that a level of the comparator network has changed, which means
+/// that the cached output of that level and all levels below it are invalid.
+/// \param level Index of the level that changed.
+
+template<size_t N, size_t D> void CBitSlice<N, D>::Invalidate(const size_t level){
+  if(level < m_nValid)
+    m_nValid = level;
+} //Invalidate
+
+/// Push all test inputs through the levels of a comparator network from the
+/// second level down to a given level, starting from the cached output of the
+/// lowest level that has not changed since the last call.
+/// \param comparator Comparator array.
+/// \param last Last level.
+
+template<size_t N, size_t D>
+void CBitSlice<N, D>::Evaluate(const uint8_t comparator[][N], const size_t last){
+  if(m_nValid == 0){ //load test inputs as output of first level
+    for(size_t j=0; j<N; j++)
+      for(size_t w=0; w<m_nNumWords; w++)
+        m_nMask[0][j][w] = m_nInput[j][w];
+
+    m_nValid = 1;
+  } //if
+
+  for(size_t i=m_nValid; i<=last; i++){ //for each level that has changed
+    for(size_t j=0; j<N; j++) //start with the output of the level above
+      for(size_t w=0; w<m_nNumWords; w++)
+        m_nMask[i][j][w] = m_nMask[i - 1][j][w];
+
+    m_pLevel(m_nMask[i], comparator[i], N, m_nNumWords);
+  } //for
+
+  if(last >= m_nValid)
+    m_nValid = last + 1;
+
+  m_nLast = last;
+} //Evaluate
+
+/// Check whether all test inputs are sorted after the last level evaluated.
+/// \return true if every channel has a zero wherever the channel below it does.
+
+template<size_t N, size_t D> bool CBitSlice<N, D>::Sorted() const{
+  return !m_pUnsorted(m_nMask[m_nLast], N, m_nNumWords);
+} //Sorted
+
+/// Construct a level of comparators that sorts the outputs of the last level
+/// evaluated, if there is one. This is the bit-sliced version of the
+/// construction in `CAutocomplete::StillSorts()`. For each test input,
+/// the single channel whose value changed from the previous test input must
+/// be joined by a comparator to the single channel of the sorted output that
+/// changes, unless they are the same channel. The construction succeeds iff
+/// these comparators form a matching.
+/// \param comparator [in, out] Testable representation of the level to be
+/// constructed, initially with no comparators.
+/// \return true if a level of comparators that sorts was constructed.
+
+template<size_t N, size_t D>
+bool CBitSlice<N, D>::Autocomplete(uint8_t comparator[]) const{
+  for(size_t j=0; j<N; j++){ //for each channel
+    alignas(64) uint64_t nMoved[MAXWORDS]; //test inputs for which change must leave channel j
+
+    if(m_pMoved(m_nMask[m_nLast][j], m_nTarget[j], m_nTransition, nMoved, m_nNumWords)){
+      //the change must move to another channel
+
+      size_t w = 0; //find first word with a change in it
+      while(nMoved[w] == 0)w++;
+
+      const size_t k = m_nTargetChannel[64*w + LowBit(nMoved[w])]; //destination
+
+      for(; w<m_nNumWords; w++) //all changes must go to channel k
+        if(nMoved[w] & ~m_nTarget[k][w])
+          return false; //no room for two comparators on channel j
+
+      uint8_t& cj = comparator[j]; //one end of comparator
+      uint8_t& ck = comparator[k]; //other end of comparator
+
+      if(cj == j && ck == k){ //both channels free
+        cj = (uint8_t)k;
+        ck = (uint8_t)j; //insert comparator
+      } //if
+
+      else if(cj != k || ck != j) //not already there
+        return false; //can't put a comparator in, so fail
+    } //if
+  } //for
+
+  return true;
+} //Autocomplete
+
+/// Apply the reachability heuristic of `CNearsort::StillNearsorts()` to the
+/// outputs of the last level evaluated, for all test inputs at once.
+/// For each test input, the single channel `j` whose value changed from the
+/// previous test input must reach the single channel `k` of the sorted output
+/// that changes, unless they are the same channel. Since the thresholds are
+/// applied to the set of such pairs, the order in which they are found does
+/// not matter.
+/// \param nFrom Maximum number of channels reachable from any channel.
+/// \param nTo Maximum number of channels that can reach any channel.
+/// \param nBoth Maximum number of channels reachable from or to any channel.
+/// \return true if the thresholds are met.
+
+template<size_t N, size_t D>
+bool CBitSlice<N, D>::Nearsorted(const size_t nFrom, const size_t nTo,
+  const size_t nBoth) const
+{
+  uint64_t nReachFrom[N] = {0}; //channels reachable from each channel
+  uint64_t nReachTo[N] = {0}; //channels reachable to each channel
+
+  for(size_t j=0; j<N; j++){ //for each channel
+    alignas(64) uint64_t nMoved[MAXWORDS]; //test inputs for which change must leave channel j
+
+    if(m_pMoved(m_nMask[m_nLast][j], m_nTarget[j], m_nTransition, nMoved, m_nNumWords)){
+      for(size_t k=0; k<N; k++){ //for each possible destination
+        uint64_t nAny = 0; //nonzero if some change goes from j to k
+
+        for(size_t w=0; w<m_nNumWords; w++)
+          nAny |= nMoved[w] & m_nTarget[k][w];
+
+        if(nAny){ //j reaches k
+          nReachFrom[j] |= (uint64_t)1 << k;
+          nReachTo[k] |= (uint64_t)1 << j;
+        } //if
+      } //for
+
+      if(PopCount(nReachFrom[j]) > nFrom)
+        return false; //too many channels reachable from j
+    } //if
+  } //for
+
+  for(size_t j=0; j<N; j++) //for each channel
+    if(PopCount(nReachTo[j]) > nTo ||
+      PopCount(nReachFrom[j] | nReachTo[j]) > nBoth)
+        return false; //too many channels reachable to, or from or to, j
+
+  return true;
+} //Nearsorted
+
+//explicit instantiation for every width and depth
+
+#define INSTANTIATE(n, d) template class CBitSlice<n, d>;
+FOR_EACH_SHAPE(INSTANTIATE)
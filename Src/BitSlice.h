@@ -0,0 +1,101 @@
+/// \file BitSlice.h
+/// \brief Interface for the bit-sliced sorting test `CBitSlice`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __BitSlice_h__
+#define __BitSlice_h__
+
+#include <cstdint>
+
+#include "Defines.h"
+#include "Settings.h"
+#include "Kernel.h"
+
+/// \brief Bit-sliced sorting test.
+///
+/// Instead of pushing one input at a time through a comparator network,
+/// a bit-sliced test pushes all of them through at once. Each channel
+/// holds a bit mask with one bit per test input, so that a comparator between
+/// channels `j < k` replaces the mask on channel `j` with the bitwise AND of
+/// the two masks (the minimum) and the mask on channel `k` with the bitwise OR
+/// (the maximum). The comparator network sorts iff at the outputs no mask has
+/// a bit that is missing from the mask on the channel below it.
+///
+/// The test inputs are the inputs to the second level of a first normal form
+/// comparator network, listed in the order in which they are generated by
+/// `CTernaryGrayCode`, with a second sweep in which the last channel is set to
+/// one if the width is odd. Keeping them in Gray code order means that
+/// consecutive test inputs differ in exactly one bit, which in turn means that
+/// the values on exactly one channel differ at each level. This lets
+/// `CBitSlice::Autocomplete()` construct the last level exactly the way that
+/// `CAutocomplete::StillSorts()` does, but for all test inputs at once.
+/// The test inputs, which depend only on the width, are generated once by
+/// `CBitSlice::Initialize()` and shared by all instances.
+///
+/// The inner loops are delegated to kernels (see `Kernel.h`) that process
+/// 64, 128, 256, or 512 test inputs per instruction. `CBitSlice::Initialize()`
+/// selects the widest one supported by the CPU it is running on, and pads the
+/// channel masks with zeros to a whole number of registers.
+///
+/// The backtracking search in `CSearchable` changes only the levels from the
+/// top of its stack down, so the upper levels of consecutive candidates are
+/// usually the same. `CBitSlice` therefore keeps the channel masks at the
+/// output of every level, and `CBitSlice::Evaluate()` recomputes them only from
+/// the highest level changed since the last call, as reported by
+/// `CBitSlice::Invalidate()`. The test inputs themselves are the output of the
+/// first level, which is the identity matching.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+
+template<size_t N, size_t D> class CBitSlice: public CSettings{
+  private:
+    static size_t m_nNumVectors; ///< Number of test inputs.
+    static size_t m_nNumWords; ///< Number of words per channel.
+
+    alignas(64) static uint64_t m_nInput[N][MAXWORDS]; ///< Test inputs.
+    alignas(64) static uint64_t m_nTarget[N][MAXWORDS]; ///< Changes to the sorted output.
+    alignas(64) static uint64_t m_nTransition[MAXWORDS]; ///< Test inputs that differ by one bit from the previous one.
+    static uint8_t m_nTargetChannel[MAXVECTORS]; ///< Sorted output channel that changes at each test input.
+
+    static LevelKernel m_pLevel; ///< Level kernel.
+    static UnsortedKernel m_pUnsorted; ///< Unsorted kernel.
+    static MovedKernel m_pMoved; ///< Moved kernel.
+
+    alignas(64) uint64_t m_nMask[D][N][MAXWORDS]; ///< Values on each channel at the output of each level.
+    size_t m_nValid = 0; ///< Number of levels whose cached output is valid.
+    size_t m_nLast = 0; ///< Last level evaluated.
+
+  public:
+    static void Initialize(); ///< Generate the test inputs.
+    static void SetKernel(const eKernel); ///< Set kernel instruction set.
+
+    void Invalidate(const size_t); ///< A level has changed.
+    void Evaluate(const uint8_t[][N], const size_t); ///< Push test inputs through levels.
+    bool Sorted() const; ///< Are all outputs sorted?
+    bool Autocomplete(uint8_t[]) const; ///< Construct a level that sorts all outputs.
+    bool Nearsorted(const size_t, const size_t, const size_t) const; ///< Reachability heuristic.
+}; //CBitSlice
+
+#endif //__BitSlice_h__
@@ -31,34 +31,48 @@
 /// Initialize the matching array to represent a comparator network with no
 /// comparators.
 
-CComparatorNetwork::CComparatorNetwork(){
-  //for(size_t i=0; i<m_nDepth; i++) //for each level
-  //  for(size_t j=0; j<m_nWidth; j++) //for each channel
+template<size_t N, size_t D> CComparatorNetwork<N, D>::CComparatorNetwork(){
+  //for(size_t i=0; i<D; i++) //for each level
+  //  for(size_t j=0; j<N; j++) //for each channel
   //    m_nComparator[i][j] = j; //connected to self means no comparator
 } //constructor
 
 /// Virtual destructor.
 
-CComparatorNetwork::~CComparatorNetwork(){
+template<size_t N, size_t D> CComparatorNetwork<N, D>::~CComparatorNetwork(){
 } //destructor
 
 /// Save comparator network to a text file.
 /// \param fname File name string.
 
-void CComparatorNetwork::Save(const std::string& fname){
+template<size_t N, size_t D>
+void CComparatorNetwork<N, D>::Save(const std::string& fname){
   std::ofstream output(fname); //output file stream
 
   if(output.is_open()){ //file opened correctly
-    for(size_t i=0; i<m_nDepth; i++){ //for each level
-      for(size_t j=0; j<m_nWidth; j++){ //for each channel
-        const size_t k = m_nComparator[i][j]; //between channels j, k at level i
-        if(k > j) //not already printed
-          output << j << " " << k << " "; //print comparator
-      } //for
+    Save(output);
+    output.close(); //end of file
+  } //if
+} //Save
+
+/// Save comparator network to a stream in the same format as a text file,
+/// one line per level.
+/// \param output Output stream.
 
-      output << std::endl; //end of line
+template<size_t N, size_t D>
+void CComparatorNetwork<N, D>::Save(std::ostream& output) const{
+  for(size_t i=0; i<D; i++){ //for each level
+    for(size_t j=0; j<N; j++){ //for each channel
+      const size_t k = m_nComparator[i][j]; //between channels j, k at level i
+      if(k > j) //not already printed
+        output << j << " " << k << " "; //print comparator
     } //for
 
-    output.close(); //end of file
-  } //if
+    output << std::endl; //end of line
+  } //for
 } //Save
+
+//explicit instantiation for every width and depth
+
+#define INSTANTIATE(n, d) template class CComparatorNetwork<n, d>;
+FOR_EACH_SHAPE(INSTANTIATE)
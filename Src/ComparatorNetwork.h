@@ -26,7 +26,9 @@
 #ifndef __ComparatorNetwork_h__
 #define __ComparatorNetwork_h__
 
+#include <iostream>
 #include <string>
+#include <cstdint>
 
 #include "Defines.h"
 #include "Settings.h"
@@ -43,16 +45,22 @@
 /// For example, in the above diagram at left there is a comparator between
 /// channels 0 and 1 at level 1, and in the table at right
 /// `m_nComparator[0][0] == 1`and `m_nComparator[0][1] == 0`.
+/// Channel numbers are stored in single bytes and the array is aligned to a
+/// cache line, so that the whole network fits in two cache lines.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
 
-class CComparatorNetwork: public CSettings{
+template<size_t N, size_t D> class CComparatorNetwork: public CSettings{
   protected: 
-    size_t m_nComparator[MAXDEPTH][MAXINPUTS] = {0}; ///< Comparator array.
+    alignas(64) uint8_t m_nComparator[D][N] = {{0}}; ///< Comparator array.
 
   public: 
     CComparatorNetwork(); ///< Constructor.
     virtual ~CComparatorNetwork(); ///< Destructor.
 
     void Save(const std::string&); ///< Save to file.
+    void Save(std::ostream&) const; ///< Save to stream.
 }; //CComparatorNetwork
 
 #endif //__ComparatorNetwork_h__
\ No newline at end of file
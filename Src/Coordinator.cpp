@@ -0,0 +1,275 @@
+/// \file Coordinator.cpp
+/// \brief Code for the coordinator `CCoordinator`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Coordinator.h"
+#include "Settings.h"
+#include "Defines.h"
+
+/// Constructor.
+/// \param strSettings Settings line that the tasks were made with.
+/// \param n Width.
+/// \param d Depth.
+
+CCoordinator::CCoordinator(const std::string& strSettings, const size_t n,
+  const size_t d):
+  m_strSettings(strSettings),
+  m_nWidth(n),
+  m_nDepth(d)
+{
+} //constructor
+
+/// Destructor. Close the connections to any workers that are left.
+
+CCoordinator::~CCoordinator(){
+  for(CConnection* p: m_stlConnection)
+    delete p;
+} //destructor
+
+/// Add a task to the queue. Tasks are assumed to be numbered consecutively
+/// from zero, but may be added in any order.
+/// \param strTask Task description starting with its index.
+
+void CCoordinator::AddTask(const std::string& strTask){
+  std::istringstream s(strTask);
+  size_t index = 0; //task index
+  s >> index;
+
+  if(index >= m_stlTask.size()){
+    m_stlTask.resize(index + 1);
+    m_stlDone.resize(index + 1, false);
+  } //if
+
+  m_stlTask[index] = strTask;
+  m_stlQueue.push_back(index);
+} //AddTask
+
+/// Listen for workers on a port.
+/// \param nPort Port number.
+/// \return true if listening.
+
+bool CCoordinator::Listen(const unsigned short nPort){
+  return m_cListener.Listen(nPort, false);
+} //Listen
+
+/// Accept workers and handle their messages until all tasks have been
+/// completed, checking every second for workers that have gone silent.
+/// Then tell the workers that are still connected that the search is done.
+
+void CCoordinator::Run(){
+  std::vector<CSocket*> sockets; //sockets to wait for
+  std::vector<bool> ready; //whether each can be read from
+
+  while(m_nNumDone < m_stlTask.size()){
+    sockets.assign(1, &m_cListener);
+
+    for(CConnection* p: m_stlConnection)
+      sockets.push_back(&p->m_cSocket);
+
+    CSocket::Select(sockets, ready, 1000);
+
+    const std::chrono::steady_clock::time_point tNow =
+      std::chrono::steady_clock::now(); //current time
+
+    for(size_t i=m_stlConnection.size(); i-->0;){ //for each worker, backwards so that it can be dropped
+      CConnection* p = m_stlConnection[i];
+
+      if(ready[i + 1]){ //something has arrived
+        if(!p->m_cSocket.Receive()){ //closed
+          Drop(i);
+          continue;
+        } //if
+
+        p->m_tHeard = tNow;
+        std::string strLine; //message
+
+        while(p->m_cSocket.GetLine(strLine))
+          Handle(p, strLine);
+      } //if
+
+      else if(tNow - p->m_tHeard > std::chrono::seconds(WORKERTIMEOUT))
+        Drop(i); //silent
+    } //for
+
+    if(ready[0]){ //a worker is connecting
+      CConnection* p = new CConnection;
+
+      if(m_cListener.Accept(p->m_cSocket)){
+        p->m_tHeard = tNow;
+        m_stlConnection.push_back(p);
+        m_nNumWorkers++;
+      } //if
+
+      else delete p;
+    } //if
+  } //while
+
+  for(CConnection* p: m_stlConnection)
+    p->m_cSocket.Send("done");
+} //Run
+
+/// Handle a message from a worker.
+/// \param p Pointer to the worker's connection.
+/// \param strLine Message.
+
+void CCoordinator::Handle(CConnection* p, const std::string& strLine){
+  std::istringstream s(strLine);
+  std::string strTag; //message type
+  s >> strTag;
+
+  if(strTag == "hello")
+    p->m_cSocket.Send("settings " + m_strSettings);
+
+  else if(strTag == "next")
+    Issue(p);
+
+  else if(strTag == "network")
+    SaveNetwork(p, s);
+
+  else if(strTag == "result"){
+    size_t index = 0; //task index
+    size_t nCount = 0; //number of sorting networks found
+    double fCPU = 0; //CPU time
+    s >> index >> nCount >> fCPU;
+
+    for(size_t i=0; i<p->m_stlTask.size(); i++)
+      if(p->m_stlTask[i] == index){ //it was issued to this worker
+        p->m_stlTask.erase(p->m_stlTask.begin() + i);
+
+        if(!m_stlDone[index]){ //first result for this task
+          m_stlDone[index] = true;
+          m_nNumDone++;
+          m_nCount += nCount;
+          m_fCPU += fCPU;
+        } //if
+
+        break;
+      } //if
+  } //else if
+} //Handle
+
+/// Issue the task at the front of the queue to a worker, or if there are none
+/// left, tell it to wait or that the search is done.
+/// \param p Pointer to the worker's connection.
+
+void CCoordinator::Issue(CConnection* p){
+  while(!m_stlQueue.empty() && m_stlDone[m_stlQueue.front()])
+    m_stlQueue.pop_front(); //completed by a worker it was issued to before
+
+  if(m_stlQueue.empty())
+    p->m_cSocket.Send(m_nNumDone < m_stlTask.size()? "wait": "done");
+
+  else{
+    const size_t index = m_stlQueue.front(); //task index
+    m_stlQueue.pop_front();
+    p->m_stlTask.push_back(index);
+    p->m_cSocket.Send("task " + m_stlTask[index]);
+  } //else
+} //Issue
+
+/// Save a sorting network sent by a worker to the file named by
+/// `CSettings::GetFileName()` from the task index and order found, provided
+/// that the task was issued to that worker and has not been completed by it.
+/// \param p Pointer to the worker's connection.
+/// \param s [in, out] Stream holding the task index, the order found, and the
+/// lines of the network separated by `|`.
+
+void CCoordinator::SaveNetwork(CConnection* p, std::istream& s){
+  size_t index = 0; //task index
+  size_t i = 0; //number of sorting networks found by the task before this one
+  s >> index >> i >> std::ws;
+
+  if(s.fail() || std::find(p->m_stlTask.begin(), p->m_stlTask.end(), index) ==
+    p->m_stlTask.end())
+    return; //not a task issued to this worker
+
+  std::string strContents; //lines separated by '|'
+  std::getline(s, strContents);
+
+  std::ofstream f(CSettings::GetFileName(m_nWidth, m_nDepth, index, i));
+  std::istringstream lines(strContents);
+  std::string strLine; //one line of the file
+
+  while(std::getline(lines, strLine, '|'))
+    f << strLine << std::endl;
+} //SaveNetwork
+
+/// Drop a worker, and put the tasks issued to it that have not been
+/// completed back at the front of the queue.
+/// \param i Index of the worker's connection.
+
+void CCoordinator::Drop(const size_t i){
+  CConnection* p = m_stlConnection[i];
+
+  for(const size_t index: p->m_stlTask)
+    if(!m_stlDone[index]){
+      m_stlQueue.push_front(index);
+      m_nReissued++;
+    } //if
+
+  delete p;
+  m_stlConnection.erase(m_stlConnection.begin() + i);
+} //Drop
+
+/// Reader function for the number of sorting networks found.
+/// \return The count.
+
+const size_t CCoordinator::GetCount() const{
+  return m_nCount;
+} //GetCount
+
+/// Reader function for the number of tasks.
+/// \return The number of tasks.
+
+const size_t CCoordinator::GetNumTasks() const{
+  return m_stlTask.size();
+} //GetNumTasks
+
+/// Reader function for the CPU time used by workers on the tasks that were
+/// counted.
+/// \return The CPU time in seconds.
+
+const double CCoordinator::GetCPUSeconds() const{
+  return m_fCPU;
+} //GetCPUSeconds
+
+/// Reader function for the number of workers that have connected.
+/// \return The number of workers.
+
+const size_t CCoordinator::GetNumWorkers() const{
+  return m_nNumWorkers;
+} //GetNumWorkers
+
+/// Reader function for the number of tasks that were issued again because
+/// the worker they were issued to was dropped.
+/// \return The number of tasks issued again.
+
+const size_t CCoordinator::GetNumReissued() const{
+  return m_nReissued;
+} //GetNumReissued
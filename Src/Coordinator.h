@@ -0,0 +1,114 @@
+/// \file Coordinator.h
+/// \brief Header for the coordinator `CCoordinator`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Coordinator_h__
+#define __Coordinator_h__
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "Socket.h"
+
+/// \brief Worker connection.
+///
+/// The coordinator's record of a connection from a worker.
+
+class CConnection{
+  public:
+    CSocket m_cSocket; ///< Socket connected to the worker.
+    std::vector<size_t> m_stlTask; ///< Indices of tasks issued to the worker and not completed.
+    std::chrono::steady_clock::time_point m_tHeard; ///< When the worker was last heard from.
+}; //CConnection
+
+/// \brief Coordinator.
+///
+/// The coordinator owns the task queue of a search that is distributed over
+/// worker processes, which connect to it over TCP, possibly from other
+/// hosts, and may join at any time. Each task is described by a line saved
+/// by `CThreadManager::Checkpoint()` before it has started, beginning with
+/// its index. Messages are lines of text whose first word says what they are.
+/// A worker sends:
+///
+/// - `hello`, to which the coordinator replies `settings` followed by the
+///   settings line that the tasks were made with;
+/// - `next`, to which the coordinator replies `task` followed by a task
+///   description, or `wait` if all tasks have been issued but some have not
+///   been completed, or `done` if all tasks have been completed;
+/// - `network` followed by the index of a task issued to the worker, the
+///   number of sorting networks that the task found before this one, and the
+///   lines of this one separated by `|`, which the coordinator saves to the
+///   file named by `CSettings::GetFileName()`, ignoring networks for tasks that
+///   were not issued to that worker;
+/// - `result` followed by a task index, the number of sorting networks found,
+///   and the CPU time in seconds, after the networks;
+/// - `alive` every `HEARTBEATINTERVAL` seconds.
+///
+/// A worker that is not heard from for `WORKERTIMEOUT` seconds, or whose
+/// connection closes, is dropped, and the tasks issued to it that have not
+/// been completed are put back at the front of the queue to be issued again.
+/// Only the first result for each task is counted, so a task that was issued
+/// again because its first worker was only slow is not counted twice, and its
+/// networks are saved again to the same files.
+
+class CCoordinator{
+  private:
+    CSocket m_cListener; ///< Socket listening for workers.
+    std::string m_strSettings; ///< Settings line.
+    size_t m_nWidth = 0; ///< Width, for network file names.
+    size_t m_nDepth = 0; ///< Depth, for network file names.
+    std::vector<std::string> m_stlTask; ///< Description of each task.
+    std::vector<bool> m_stlDone; ///< Whether each task has been completed.
+    std::deque<size_t> m_stlQueue; ///< Indices of tasks waiting to be issued.
+    std::vector<CConnection*> m_stlConnection; ///< Connections from workers.
+
+    size_t m_nNumDone = 0; ///< Number of tasks completed.
+    size_t m_nCount = 0; ///< Number of sorting networks found.
+    double m_fCPU = 0; ///< CPU time used by workers, in seconds.
+    size_t m_nNumWorkers = 0; ///< Number of workers that have connected.
+    size_t m_nReissued = 0; ///< Number of tasks issued again.
+
+    void Handle(CConnection*, const std::string&); ///< Handle a message.
+    void Issue(CConnection*); ///< Issue a task to a worker.
+    void SaveNetwork(CConnection*, std::istream&); ///< Save a network from a worker.
+    void Drop(const size_t); ///< Drop a worker.
+
+  public:
+    CCoordinator(const std::string&, const size_t, const size_t); ///< Constructor.
+    ~CCoordinator(); ///< Destructor.
+
+    void AddTask(const std::string&); ///< Add a task.
+    bool Listen(const unsigned short); ///< Listen for workers.
+    void Run(); ///< Run until all tasks are completed.
+
+    const size_t GetCount() const; ///< Get count.
+    const size_t GetNumTasks() const; ///< Get number of tasks.
+    const double GetCPUSeconds() const; ///< Get CPU time used by workers.
+    const size_t GetNumWorkers() const; ///< Get number of workers.
+    const size_t GetNumReissued() const; ///< Get number of tasks issued again.
+}; //CCoordinator
+
+#endif //__Coordinator_h__
@@ -27,10 +27,37 @@
 #define __Defines_h__
 
 #define MAXINPUTS 12 ///< Maximum width, that is, number of inputs.
-#define MAXDEPTH 7 ///< Maximum depth.
+#define MAXDEPTH 8 ///< Maximum depth.
+#define MAXVECTORS 729 ///< Maximum number of first normal form test inputs.
+#define MAXWORDS 16 ///< Maximum number of 64-bit words to hold one bit per test input, padded for AVX-512.
+#define MAXWITNESSES 8 ///< Number of counterexamples in a witness cache.
+#define MAXWITNESSLEN 16 ///< Maximum number of test input changes in a counterexample.
+#define MAXSUBSUMENODES 4096 ///< Maximum number of partial channel permutations tried in a subsumption test.
+#define MAXTHREADS 1024 ///< Maximum number of threads that can be asked for on the command line.
+#define MAXTRANSFERBYTES (256 << 20) ///< Maximum number of bytes of level transfer tables shared by all tasks.
+#define CHECKPOINTINTERVAL 600 ///< Number of seconds between checkpoints.
+#define PROGRESSINTERVAL 60 ///< Default number of seconds between progress reports.
+#define HEARTBEATINTERVAL 10 ///< Number of seconds between messages from a busy worker to the coordinator.
+#define WORKERTIMEOUT 60 ///< Number of seconds after which the coordinator drops a silent worker.
+#define SCRAPETIMEOUT 1000 ///< Number of milliseconds to wait for the request line of a metrics scrape.
+#define ESTIMATEPROBES 1000 ///< Maximum number of random probes of each task when estimating search tree size.
+#define ESTIMATESECONDS 10 ///< Number of seconds to spend on random probes when estimating search tree size.
+#define TRACESLOWEST 5 ///< Number of slowest tasks to list after a search.
+
+#ifndef NOSTATS
+  #define STATS ///< Count search statistics for the run report, unless `NOSTATS` is defined.
+#endif //NOSTATS
+
+/// Apply a macro to every width from 3 to `MAXINPUTS`.
+#define FOR_EACH_WIDTH(X) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12)
+
+/// Apply a macro to every width and depth accepted by `CheckParams()`.
+#define FOR_EACH_SHAPE(X) \
+  X(3, 3) X(4, 3) X(5, 4) X(5, 5) X(6, 4) X(6, 5) X(7, 5) X(7, 6) X(8, 5) \
+  X(8, 6) X(9, 6) X(9, 7) X(10, 6) X(10, 7) X(11, 7) X(11, 8) X(12, 7) X(12, 8)
 
 #define odd(n) ((n) & 1) ///< Oddness test.
-#define xor(i, j) (((i) && (j)) || !((i) || (j))) ///< Exclusive-or.
+#define xnor(i, j) (((i) && (j)) || !((i) || (j))) ///< Exclusive-nor, true if both or neither are true.
 
 #define oddfloor(n) (odd(n)?(n):((n)-1)) ///< If even, round down to make odd.
 #define evenfloor(n) (odd(n)?(n)-1:((n))) ///< If odd, round down to make even.
@@ -0,0 +1,86 @@
+/// \file Estimate.cpp
+/// \brief Code for the search tree size estimate `CEstimate`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "Estimate.h"
+
+/// Add the estimates from one probe.
+/// \param fNodes Estimated number of nodes.
+/// \param fCandidates Estimated number of candidates.
+/// \param fSeconds Estimated time in seconds.
+
+void CEstimate::Add(const double fNodes, const double fCandidates,
+  const double fSeconds)
+{
+  m_nProbes++;
+  m_fNodes += fNodes;
+  m_fCandidates += fCandidates;
+  m_fSeconds += fSeconds;
+  m_fSquares += fSeconds*fSeconds;
+} //Add
+
+/// Reader function for the number of probes.
+/// \return Number of probes.
+
+const size_t CEstimate::GetNumProbes() const{
+  return m_nProbes;
+} //GetNumProbes
+
+/// Reader function for the estimated number of nodes, which is the mean of
+/// the estimates from the probes.
+/// \return Estimated number of nodes.
+
+const double CEstimate::GetNodes() const{
+  return m_nProbes? m_fNodes/m_nProbes: 0;
+} //GetNodes
+
+/// Reader function for the estimated number of candidates, which is the mean
+/// of the estimates from the probes.
+/// \return Estimated number of candidates.
+
+const double CEstimate::GetCandidates() const{
+  return m_nProbes? m_fCandidates/m_nProbes: 0;
+} //GetCandidates
+
+/// Reader function for the estimated CPU time, which is the mean of the
+/// estimates from the probes.
+/// \return Estimated CPU time in seconds.
+
+const double CEstimate::GetCPUSeconds() const{
+  return m_nProbes? m_fSeconds/m_nProbes: 0;
+} //GetCPUSeconds
+
+/// Reader function for the variance of the estimated CPU time, that is, the
+/// sample variance of the estimates from the probes divided by the number of
+/// probes.
+/// \return Variance of the estimated CPU time in square seconds.
+
+const double CEstimate::GetVariance() const{
+  if(m_nProbes < 2)return 0;
+
+  const double fMean = m_fSeconds/m_nProbes; //mean of estimates
+  const double fVariance = (m_fSquares - m_nProbes*fMean*fMean)/(m_nProbes - 1); //sample variance
+
+  return fVariance > 0? fVariance/m_nProbes: 0;
+} //GetVariance
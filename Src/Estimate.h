@@ -0,0 +1,64 @@
+/// \file Estimate.h
+/// \brief Interface for the search tree size estimate `CEstimate`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Estimate_h__
+#define __Estimate_h__
+
+#include <cstddef>
+
+/// \brief Search tree size estimate.
+///
+/// Knuth's estimator of the size of a backtracking tree follows a single
+/// path from the root, choosing a child uniformly at random at each node.
+/// If the nodes on the path have \f$c_1, c_2, \ldots\f$ children, then
+/// \f$c_1 c_2 \cdots c_i\f$ is an unbiased estimate of the number of nodes at
+/// depth \f$i\f$, and the cost of a node at depth \f$i\f$ multiplied by the
+/// same product is an unbiased estimate of the total cost of the nodes at
+/// that depth. `CEstimate` averages these estimates over the random probes
+/// of one task made by `CSearchable::Probe()`, that is, the number of nodes
+/// at the levels that the search enumerates, the number of those that are
+/// candidates processed by the sorting test, and the time that the sorting
+/// test takes on them. The variance of the time estimate is kept too, since
+/// Knuth's estimator can have a very large variance.
+
+class CEstimate{
+  private:
+    size_t m_nProbes = 0; ///< Number of probes.
+    double m_fNodes = 0; ///< Sum of node count estimates.
+    double m_fCandidates = 0; ///< Sum of candidate count estimates.
+    double m_fSeconds = 0; ///< Sum of time estimates in seconds.
+    double m_fSquares = 0; ///< Sum of squares of time estimates.
+
+  public:
+    void Add(const double, const double, const double); ///< Add the result of a probe.
+
+    const size_t GetNumProbes() const; ///< Get number of probes.
+    const double GetNodes() const; ///< Get estimated number of nodes.
+    const double GetCandidates() const; ///< Get estimated number of candidates.
+    const double GetCPUSeconds() const; ///< Get estimated CPU time.
+    const double GetVariance() const; ///< Get variance of estimated CPU time.
+}; //CEstimate
+
+#endif //__Estimate_h__
@@ -0,0 +1,512 @@
+/// \file Kernel.cpp
+/// \brief Code for the bit-sliced sorting test kernels.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "Kernel.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+  #define KERNEL_X86 ///< Compile the SSE2, AVX2, and AVX-512 kernels.
+#endif
+
+#ifdef KERNEL_X86
+  #ifdef _MSC_VER
+    #include <intrin.h>
+    #define TARGET(isa) ///< MSVC needs no permission to use intrinsics.
+  #else
+    #include <immintrin.h>
+    #define TARGET(isa) __attribute__((target(isa))) ///< Permission to use intrinsics.
+  #endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Dispatch
+
+/// Detect the widest vector unit that is supported by both the CPU and the
+/// operating system.
+/// \return The widest kernel that can be used on this CPU.
+
+eKernel DetectKernel(){
+  #ifdef KERNEL_X86
+    #ifdef _MSC_VER
+      int r[4] = {0}; //registers eax, ebx, ecx, edx
+      
+      __cpuid(r, 0);
+      const int nMaxLeaf = r[0]; //highest function parameter
+
+      __cpuid(r, 1);
+      const bool bSSE2 = (r[3] & (1 << 26)) != 0;
+      const bool bOSXSAVE = (r[2] & (1 << 27)) != 0;
+      const unsigned long long xcr0 = bOSXSAVE? _xgetbv(0): 0; //register state saved by OS
+
+      bool bAVX2 = false, bAVX512 = false;
+
+      if(nMaxLeaf >= 7){
+        __cpuidex(r, 7, 0);
+        bAVX2 = (r[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06;
+        bAVX512 = (r[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+      } //if
+    #else
+      __builtin_cpu_init();
+      const bool bSSE2 = __builtin_cpu_supports("sse2") != 0;
+      const bool bAVX2 = __builtin_cpu_supports("avx2") != 0;
+      const bool bAVX512 = __builtin_cpu_supports("avx512f") != 0;
+    #endif
+
+    if(bAVX512)return eKernel::AVX512;
+    if(bAVX2)return eKernel::AVX2;
+    if(bSSE2)return eKernel::SSE2;
+  #endif
+
+  return eKernel::Scalar;
+} //DetectKernel
+
+/// Get the number of 64-bit words in a register used by a kernel. The
+/// number of words in each channel mask must be a multiple of this.
+/// \param k Kernel.
+/// \return Number of 64-bit words per register.
+
+size_t GetKernelWords(const eKernel k){
+  switch(k){
+    case eKernel::SSE2: return 2;
+    case eKernel::AVX2: return 4;
+    case eKernel::AVX512: return 8;
+    default: return 1;
+  } //switch
+} //GetKernelWords
+
+/// Get the name of a kernel instruction set for the run summary.
+/// \param k Kernel.
+/// \return Name of the kernel instruction set.
+
+const char* GetKernelName(const eKernel k){
+  switch(k){
+    case eKernel::SSE2: return "SSE2";
+    case eKernel::AVX2: return "AVX2";
+    case eKernel::AVX512: return "AVX-512";
+    default: return "scalar";
+  } //switch
+} //GetKernelName
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalar kernels
+
+/// Push the channel masks through one level of comparators using 64-bit
+/// general purpose registers.
+/// \param mask [in, out] Channel masks.
+/// \param comparator Testable representation of the level.
+/// \param n Width.
+/// \param words Number of words per channel mask.
+
+void LevelScalar(uint64_t mask[][MAXWORDS], const uint8_t comparator[],
+  const size_t n, const size_t words)
+{
+  for(size_t j=0; j<n; j++){ //for each channel
+    const size_t k = comparator[j]; //channel joined via a comparator
+
+    if(k > j) //comparator between j and k, minimum goes to j
+      for(size_t w=0; w<words; w++){
+        const uint64_t a = mask[j][w];
+        const uint64_t b = mask[k][w];
+        mask[j][w] = a & b; //minimum
+        mask[k][w] = a | b; //maximum
+      } //for
+  } //for
+} //LevelScalar
+
+/// Check whether any test input has a one above a zero using 64-bit
+/// general purpose registers.
+/// \param mask Channel masks.
+/// \param n Width.
+/// \param words Number of words per channel mask.
+/// \return true if some test input is unsorted.
+
+bool UnsortedScalar(const uint64_t mask[][MAXWORDS], const size_t n,
+  const size_t words)
+{
+  uint64_t acc = 0; //test inputs with a 1 above a 0
+
+  for(size_t j=0; j+1<n; j++)
+    for(size_t w=0; w<words; w++)
+      acc |= mask[j][w] & ~mask[j + 1][w];
+
+  return acc != 0;
+} //UnsortedScalar
+
+/// Find the test inputs that change the value on a channel from the previous
+/// test input but do not change the sorted output on that channel, using
+/// 64-bit general purpose registers.
+/// \param mask Channel mask.
+/// \param target Sorted output change mask for this channel.
+/// \param transition Mask of test inputs that follow from the previous one.
+/// \param moved [out] Result mask.
+/// \param words Number of words per channel mask.
+/// \return true if the result mask is nonzero.
+
+bool MovedScalar(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  uint64_t acc = 0; //OR of result words
+  uint64_t carry = 0; //bit carried from previous word
+
+  for(size_t w=0; w<words; w++){
+    const uint64_t x = mask[w];
+    const uint64_t changed = x ^ ((x << 1) | carry); //changed from previous
+    carry = x >> 63;
+    moved[w] = changed & transition[w] & ~target[w];
+    acc |= moved[w];
+  } //for
+
+  return acc != 0;
+} //MovedScalar
+
+#ifdef KERNEL_X86
+
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+
+/// Push the channel masks through one level of comparators using 128-bit
+/// SSE2 registers.
+/// \param mask [in, out] Channel masks.
+/// \param comparator Testable representation of the level.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 2.
+
+TARGET("sse2") void LevelSSE2(uint64_t mask[][MAXWORDS],
+  const uint8_t comparator[], const size_t n, const size_t words)
+{
+  for(size_t j=0; j<n; j++){ //for each channel
+    const size_t k = comparator[j]; //channel joined via a comparator
+
+    if(k > j){ //comparator between j and k, minimum goes to j
+      __m128i* pj = (__m128i*)mask[j];
+      __m128i* pk = (__m128i*)mask[k];
+
+      for(size_t w=0; w<words/2; w++){
+        const __m128i a = _mm_loadu_si128(pj + w);
+        const __m128i b = _mm_loadu_si128(pk + w);
+        _mm_storeu_si128(pj + w, _mm_and_si128(a, b)); //minimum
+        _mm_storeu_si128(pk + w, _mm_or_si128(a, b)); //maximum
+      } //for
+    } //if
+  } //for
+} //LevelSSE2
+
+/// Check whether any test input has a one above a zero using 128-bit
+/// SSE2 registers.
+/// \param mask Channel masks.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 2.
+/// \return true if some test input is unsorted.
+
+TARGET("sse2") bool UnsortedSSE2(const uint64_t mask[][MAXWORDS],
+  const size_t n, const size_t words)
+{
+  __m128i acc = _mm_setzero_si128(); //test inputs with a 1 above a 0
+
+  for(size_t j=0; j+1<n; j++){
+    const __m128i* pj = (const __m128i*)mask[j];
+    const __m128i* pk = (const __m128i*)mask[j + 1];
+
+    for(size_t w=0; w<words/2; w++)
+      acc = _mm_or_si128(acc, _mm_andnot_si128(_mm_loadu_si128(pk + w),
+        _mm_loadu_si128(pj + w)));
+  } //for
+
+  const __m128i zero = _mm_setzero_si128();
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF;
+} //UnsortedSSE2
+
+/// Find the test inputs that change the value on a channel from the previous
+/// test input but do not change the sorted output on that channel, using
+/// 128-bit SSE2 registers.
+/// \param mask Channel mask.
+/// \param target Sorted output change mask for this channel.
+/// \param transition Mask of test inputs that follow from the previous one.
+/// \param moved [out] Result mask.
+/// \param words Number of words per channel mask, a multiple of 2.
+/// \return true if the result mask is nonzero.
+
+TARGET("sse2") bool MovedSSE2(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  __m128i acc = _mm_setzero_si128(); //OR of result words
+  __m128i prev = _mm_setzero_si128(); //previous register
+
+  for(size_t w=0; w<words/2; w++){
+    const __m128i x = _mm_loadu_si128((const __m128i*)mask + w);
+    const __m128i y = _mm_castpd_si128(_mm_shuffle_pd( //words shifted up by one
+      _mm_castsi128_pd(prev), _mm_castsi128_pd(x), 1));
+    const __m128i shifted = _mm_or_si128(_mm_slli_epi64(x, 1),
+      _mm_srli_epi64(y, 63)); //bits shifted up by one
+    const __m128i changed = _mm_xor_si128(x, shifted); //changed from previous
+    const __m128i t = _mm_loadu_si128((const __m128i*)transition + w);
+    const __m128i m = _mm_andnot_si128(
+      _mm_loadu_si128((const __m128i*)target + w), _mm_and_si128(changed, t));
+
+    _mm_storeu_si128((__m128i*)moved + w, m);
+    acc = _mm_or_si128(acc, m);
+    prev = x;
+  } //for
+
+  const __m128i zero = _mm_setzero_si128();
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF;
+} //MovedSSE2
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+
+/// Push the channel masks through one level of comparators using 256-bit
+/// AVX2 registers.
+/// \param mask [in, out] Channel masks.
+/// \param comparator Testable representation of the level.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 4.
+
+TARGET("avx2") void LevelAVX2(uint64_t mask[][MAXWORDS],
+  const uint8_t comparator[], const size_t n, const size_t words)
+{
+  for(size_t j=0; j<n; j++){ //for each channel
+    const size_t k = comparator[j]; //channel joined via a comparator
+
+    if(k > j){ //comparator between j and k, minimum goes to j
+      __m256i* pj = (__m256i*)mask[j];
+      __m256i* pk = (__m256i*)mask[k];
+
+      for(size_t w=0; w<words/4; w++){
+        const __m256i a = _mm256_loadu_si256(pj + w);
+        const __m256i b = _mm256_loadu_si256(pk + w);
+        _mm256_storeu_si256(pj + w, _mm256_and_si256(a, b)); //minimum
+        _mm256_storeu_si256(pk + w, _mm256_or_si256(a, b)); //maximum
+      } //for
+    } //if
+  } //for
+} //LevelAVX2
+
+/// Check whether any test input has a one above a zero using 256-bit
+/// AVX2 registers.
+/// \param mask Channel masks.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 4.
+/// \return true if some test input is unsorted.
+
+TARGET("avx2") bool UnsortedAVX2(const uint64_t mask[][MAXWORDS],
+  const size_t n, const size_t words)
+{
+  __m256i acc = _mm256_setzero_si256(); //test inputs with a 1 above a 0
+
+  for(size_t j=0; j+1<n; j++){
+    const __m256i* pj = (const __m256i*)mask[j];
+    const __m256i* pk = (const __m256i*)mask[j + 1];
+
+    for(size_t w=0; w<words/4; w++)
+      acc = _mm256_or_si256(acc, _mm256_andnot_si256(
+        _mm256_loadu_si256(pk + w), _mm256_loadu_si256(pj + w)));
+  } //for
+
+  return !_mm256_testz_si256(acc, acc);
+} //UnsortedAVX2
+
+/// Find the test inputs that change the value on a channel from the previous
+/// test input but do not change the sorted output on that channel, using
+/// 256-bit AVX2 registers.
+/// \param mask Channel mask.
+/// \param target Sorted output change mask for this channel.
+/// \param transition Mask of test inputs that follow from the previous one.
+/// \param moved [out] Result mask.
+/// \param words Number of words per channel mask, a multiple of 4.
+/// \return true if the result mask is nonzero.
+
+TARGET("avx2") bool MovedAVX2(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  __m256i acc = _mm256_setzero_si256(); //OR of result words
+  __m256i prev = _mm256_setzero_si256(); //previous register rotated up one word
+
+  for(size_t w=0; w<words/4; w++){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)mask + w);
+    const __m256i r = _mm256_permute4x64_epi64(x, 0x93); //rotated up one word
+    const __m256i y = _mm256_blend_epi32(r, prev, 0x03); //words shifted up by one
+    const __m256i shifted = _mm256_or_si256(_mm256_slli_epi64(x, 1),
+      _mm256_srli_epi64(y, 63)); //bits shifted up by one
+    const __m256i changed = _mm256_xor_si256(x, shifted); //changed from previous
+    const __m256i t = _mm256_loadu_si256((const __m256i*)transition + w);
+    const __m256i m = _mm256_andnot_si256(
+      _mm256_loadu_si256((const __m256i*)target + w), _mm256_and_si256(changed, t));
+
+    _mm256_storeu_si256((__m256i*)moved + w, m);
+    acc = _mm256_or_si256(acc, m);
+    prev = r;
+  } //for
+
+  return !_mm256_testz_si256(acc, acc);
+} //MovedAVX2
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX-512 kernels
+//
+// Some of the unmasked AVX-512 intrinsics are implemented in the g++ headers
+// as masked ones that merge into an uninitialized register, which makes
+// -Wmaybe-uninitialized complain. The masked intrinsics with all lanes
+// selected and an explicitly zeroed source are used in their place.
+
+#define ALLLANES ((__mmask8)0xFF) ///< Mask selecting all eight 64-bit lanes.
+
+/// Push the channel masks through one level of comparators using 512-bit
+/// AVX-512 registers.
+/// \param mask [in, out] Channel masks.
+/// \param comparator Testable representation of the level.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 8.
+
+TARGET("avx512f") void LevelAVX512(uint64_t mask[][MAXWORDS],
+  const uint8_t comparator[], const size_t n, const size_t words)
+{
+  for(size_t j=0; j<n; j++){ //for each channel
+    const size_t k = comparator[j]; //channel joined via a comparator
+
+    if(k > j) //comparator between j and k, minimum goes to j
+      for(size_t w=0; w<words; w+=8){
+        const __m512i a = _mm512_loadu_si512(mask[j] + w);
+        const __m512i b = _mm512_loadu_si512(mask[k] + w);
+        _mm512_storeu_si512(mask[j] + w, _mm512_and_si512(a, b)); //minimum
+        _mm512_storeu_si512(mask[k] + w, _mm512_or_si512(a, b)); //maximum
+      } //for
+  } //for
+} //LevelAVX512
+
+/// Check whether any test input has a one above a zero using 512-bit
+/// AVX-512 registers.
+/// \param mask Channel masks.
+/// \param n Width.
+/// \param words Number of words per channel mask, a multiple of 8.
+/// \return true if some test input is unsorted.
+
+TARGET("avx512f") bool UnsortedAVX512(const uint64_t mask[][MAXWORDS],
+  const size_t n, const size_t words)
+{
+  const __m512i zero = _mm512_setzero_si512(); //source for masked intrinsics
+  __m512i acc = _mm512_setzero_si512(); //test inputs with a 1 above a 0
+
+  for(size_t j=0; j+1<n; j++)
+    for(size_t w=0; w<words; w+=8)
+      acc = _mm512_or_si512(acc, _mm512_mask_andnot_epi64(zero, ALLLANES,
+        _mm512_loadu_si512(mask[j + 1] + w), _mm512_loadu_si512(mask[j] + w)));
+
+  return _mm512_test_epi64_mask(acc, acc) != 0;
+} //UnsortedAVX512
+
+/// Find the test inputs that change the value on a channel from the previous
+/// test input but do not change the sorted output on that channel, using
+/// 512-bit AVX-512 registers.
+/// \param mask Channel mask.
+/// \param target Sorted output change mask for this channel.
+/// \param transition Mask of test inputs that follow from the previous one.
+/// \param moved [out] Result mask.
+/// \param words Number of words per channel mask, a multiple of 8.
+/// \return true if the result mask is nonzero.
+
+TARGET("avx512f") bool MovedAVX512(const uint64_t mask[],
+  const uint64_t target[], const uint64_t transition[], uint64_t moved[],
+  const size_t words)
+{
+  const __m512i zero = _mm512_setzero_si512(); //source for masked intrinsics
+  __m512i acc = _mm512_setzero_si512(); //OR of result words
+  __m512i prev = _mm512_setzero_si512(); //previous register
+
+  for(size_t w=0; w<words; w+=8){
+    const __m512i x = _mm512_loadu_si512(mask + w);
+    const __m512i y = _mm512_mask_alignr_epi64(zero, ALLLANES, x, prev, 7); //words shifted up by one
+    const __m512i shifted = _mm512_or_si512(
+      _mm512_mask_slli_epi64(zero, ALLLANES, x, 1),
+      _mm512_mask_srli_epi64(zero, ALLLANES, y, 63)); //bits shifted up by one
+    const __m512i changed = _mm512_xor_si512(x, shifted); //changed from previous
+    const __m512i t = _mm512_loadu_si512(transition + w);
+    const __m512i m = _mm512_mask_andnot_epi64(zero, ALLLANES,
+      _mm512_loadu_si512(target + w), _mm512_and_si512(changed, t));
+
+    _mm512_storeu_si512(moved + w, m);
+    acc = _mm512_or_si512(acc, m);
+    prev = x;
+  } //for
+
+  return _mm512_test_epi64_mask(acc, acc) != 0;
+} //MovedAVX512
+
+#else //not x86, so fall back to the scalar kernels
+
+void LevelSSE2(uint64_t mask[][MAXWORDS], const uint8_t comparator[],
+  const size_t n, const size_t words)
+{
+  LevelScalar(mask, comparator, n, words);
+} //LevelSSE2
+
+void LevelAVX2(uint64_t mask[][MAXWORDS], const uint8_t comparator[],
+  const size_t n, const size_t words)
+{
+  LevelScalar(mask, comparator, n, words);
+} //LevelAVX2
+
+void LevelAVX512(uint64_t mask[][MAXWORDS], const uint8_t comparator[],
+  const size_t n, const size_t words)
+{
+  LevelScalar(mask, comparator, n, words);
+} //LevelAVX512
+
+bool UnsortedSSE2(const uint64_t mask[][MAXWORDS], const size_t n,
+  const size_t words)
+{
+  return UnsortedScalar(mask, n, words);
+} //UnsortedSSE2
+
+bool UnsortedAVX2(const uint64_t mask[][MAXWORDS], const size_t n,
+  const size_t words)
+{
+  return UnsortedScalar(mask, n, words);
+} //UnsortedAVX2
+
+bool UnsortedAVX512(const uint64_t mask[][MAXWORDS], const size_t n,
+  const size_t words)
+{
+  return UnsortedScalar(mask, n, words);
+} //UnsortedAVX512
+
+bool MovedSSE2(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  return MovedScalar(mask, target, transition, moved, words);
+} //MovedSSE2
+
+bool MovedAVX2(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  return MovedScalar(mask, target, transition, moved, words);
+} //MovedAVX2
+
+bool MovedAVX512(const uint64_t mask[], const uint64_t target[],
+  const uint64_t transition[], uint64_t moved[], const size_t words)
+{
+  return MovedScalar(mask, target, transition, moved, words);
+} //MovedAVX512
+
+#endif //KERNEL_X86
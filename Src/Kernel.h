@@ -0,0 +1,122 @@
+/// \file Kernel.h
+/// \brief Interface for the bit-sliced sorting test kernels.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __Kernel_h__
+#define __Kernel_h__
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#endif
+
+#include "Defines.h"
+
+/// \brief Kernel instruction set.
+///
+/// The widest vector unit used by the bit-sliced sorting test `CBitSlice`.
+
+enum class eKernel{
+  Scalar, ///< 64-bit general purpose registers.
+  SSE2, ///< 128-bit SSE2 registers.
+  AVX2, ///< 256-bit AVX2 registers.
+  AVX512 ///< 512-bit AVX-512 registers.
+}; //eKernel
+
+/// \brief Level kernel.
+///
+/// Push the channel masks through one level of comparators.
+/// The parameters are the channel masks, the testable representation of
+/// the level, the width, and the number of words per channel mask.
+
+typedef void (*LevelKernel)(uint64_t[][MAXWORDS], const uint8_t[], const size_t,
+  const size_t);
+
+/// \brief Unsorted kernel.
+///
+/// Check whether any test input has a one above a zero. The parameters are
+/// the channel masks, the width, and the number of words per channel mask.
+
+typedef bool (*UnsortedKernel)(const uint64_t[][MAXWORDS], const size_t,
+  const size_t);
+
+/// \brief Moved kernel.
+///
+/// Find the test inputs that change the value on a channel from the previous
+/// test input but do not change the sorted output on that channel. The
+/// parameters are the channel mask, the sorted output change mask for that
+/// channel, the mask of test inputs that follow from the previous one, the
+/// result mask, and the number of words per channel mask.
+
+typedef bool (*MovedKernel)(const uint64_t[], const uint64_t[], const uint64_t[],
+  uint64_t[], const size_t);
+
+eKernel DetectKernel(); ///< Detect the widest kernel supported by this CPU.
+size_t GetKernelWords(const eKernel); ///< Number of words per register.
+const char* GetKernelName(const eKernel); ///< Get kernel instruction set name.
+
+void LevelScalar(uint64_t[][MAXWORDS], const uint8_t[], const size_t, const size_t); ///< Scalar level kernel.
+void LevelSSE2(uint64_t[][MAXWORDS], const uint8_t[], const size_t, const size_t); ///< SSE2 level kernel.
+void LevelAVX2(uint64_t[][MAXWORDS], const uint8_t[], const size_t, const size_t); ///< AVX2 level kernel.
+void LevelAVX512(uint64_t[][MAXWORDS], const uint8_t[], const size_t, const size_t); ///< AVX-512 level kernel.
+
+bool UnsortedScalar(const uint64_t[][MAXWORDS], const size_t, const size_t); ///< Scalar unsorted kernel.
+bool UnsortedSSE2(const uint64_t[][MAXWORDS], const size_t, const size_t); ///< SSE2 unsorted kernel.
+bool UnsortedAVX2(const uint64_t[][MAXWORDS], const size_t, const size_t); ///< AVX2 unsorted kernel.
+bool UnsortedAVX512(const uint64_t[][MAXWORDS], const size_t, const size_t); ///< AVX-512 unsorted kernel.
+
+bool MovedScalar(const uint64_t[], const uint64_t[], const uint64_t[], uint64_t[], const size_t); ///< Scalar moved kernel.
+bool MovedSSE2(const uint64_t[], const uint64_t[], const uint64_t[], uint64_t[], const size_t); ///< SSE2 moved kernel.
+bool MovedAVX2(const uint64_t[], const uint64_t[], const uint64_t[], uint64_t[], const size_t); ///< AVX2 moved kernel.
+bool MovedAVX512(const uint64_t[], const uint64_t[], const uint64_t[], uint64_t[], const size_t); ///< AVX-512 moved kernel.
+
+/// Get the index of the least significant one bit in a nonzero word.
+/// \param x A nonzero word.
+/// \return Index of the least significant one bit in x.
+
+inline size_t LowBit(const uint64_t x){
+  #ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (size_t)i;
+  #else
+    return (size_t)__builtin_ctzll(x);
+  #endif
+} //LowBit
+
+/// Count the one bits in a word.
+/// \param x A word.
+/// \return Number of one bits in x.
+
+inline size_t PopCount(const uint64_t x){
+  #ifdef _MSC_VER
+    return (size_t)__popcnt64(x);
+  #else
+    return (size_t)__builtin_popcountll(x);
+  #endif
+} //PopCount
+
+#endif //__Kernel_h__
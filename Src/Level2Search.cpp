@@ -30,21 +30,32 @@
 #include "Level2Search.h"
 
 /// Perform a search for level 2 matchings and store them in lexicographic
-/// order in m_stlResults. Print information to the console and the log file.
+/// order in m_stlResults. A matching is kept only if its index is the smallest
+/// of all matchings obtained from it by permuting pairs of channels, or if
+/// `CSettings::m_bReflect` is true, by reflection or by both. Print
+/// information to the console and the log file.
 
-CLevel2Search::CLevel2Search(){
+template<size_t N> CLevel2Search<N>::CLevel2Search(){
   size_t m_nCurIndex = 0; //index of current matching - no need to call GetIndex
 
-  CMatching curMatching; //current matching
+  CMatching<N> curMatching; //current matching
   curMatching.Initialize();
 
   do{ //for each matching
-    //if(odd(m_nWidth))curMatching[m_nWidth] = m_nWidth; //dummy last channel for odd width networks
-    CMatching copy(curMatching);
+    //if(odd(N))curMatching[N] = N; //dummy last channel for odd width networks
+    CMatching<N> copy(curMatching);
 
     if(m_stlUsed.find(m_nCurIndex) == m_stlUsed.end()){ //if it is not used
-      const size_t minIndex = std::min(m_nCurIndex, Permute(copy, m_nWidth/2)); //all pairwise permutations used also
-     
+      size_t minIndex = std::min(m_nCurIndex, Permute(copy, N/2)); //all pairwise permutations used also
+
+      if(m_bReflect){
+        CMatching<N> reflection(curMatching); //mirror image
+        reflection.Reflect();
+
+        minIndex = std::min(minIndex, GetIndex(reflection)); //and the mirror image
+        minIndex = std::min(minIndex, Permute(reflection, N/2)); //and its pairwise permutations
+      } //if
+
       if(m_stlUsed.find(minIndex) == m_stlUsed.end()){ //if it is not used
         m_stlResults.push_back(curMatching); //insert into results
         m_stlUsed.insert(minIndex); //mark it used
@@ -69,29 +80,29 @@ CLevel2Search::CLevel2Search(){
 /// \param matching A perfect matching.
 /// \return Order in which it is generated.
 
-size_t CLevel2Search::GetIndex(CMatching& matching){
+template<size_t N> size_t CLevel2Search<N>::GetIndex(CMatching<N>& matching){
   size_t index = 0; //the index value to be returned
-  size_t b = GetNumMatchings(m_nWidth)/(oddfloor(m_nWidth)); //block size to be skipped
+  size_t b = GetNumMatchings(N)/(oddfloor(N)); //block size to be skipped
   
-  int nCopy[MAXINPUTS + 1] = {0}; //integer copy of matching.
+  int nCopy[N + 1] = {0}; //integer copy of matching.
 
   //grab a copy of matching into the array m
 
-  for(size_t i=0; i<=m_nWidth; i++)
+  for(size_t i=0; i<=N; i++)
     nCopy[i] = (int)matching[i];
 
   //make sure that each comparator is listed in ascending order
 
-  for(size_t i=0; i<m_nWidth; i+=2)
+  for(size_t i=0; i<N; i+=2)
     if(nCopy[i] > nCopy[i+1])
       std::swap(nCopy[i], nCopy[i+1]);
   
   //compute index
 
-  for(size_t n=evenceil(m_nWidth); n>2; n-=2){ //for each comparator
+  for(size_t n=evenceil(N); n>2; n-=2){ //for each comparator
     size_t max = 1; //the index of the largest channel on the max side of a comparator
     
-    for(size_t i=1; i<=m_nWidth; i+=2)
+    for(size_t i=1; i<=N; i+=2)
       if(nCopy[i] > nCopy[max])
         max = i;
 
@@ -102,7 +113,7 @@ size_t CLevel2Search::GetIndex(CMatching& matching){
 
     //remove m_nCopy[max - 1] from the matching
 
-    for(size_t j=0; j<m_nWidth; j++)
+    for(size_t j=0; j<N; j++)
       if(nCopy[j] > nCopy[max - 1])
         nCopy[j]--;
 
@@ -121,7 +132,9 @@ size_t CLevel2Search::GetIndex(CMatching& matching){
 /// \param n Size of permutation.
 /// \return Smallest matching index from all permuted matchings.
 
-size_t CLevel2Search::Permute(CMatching& matching, const size_t n){
+template<size_t N> size_t CLevel2Search<N>::Permute(CMatching<N>& matching,
+  const size_t n)
+{
   size_t nMinIndex = 99999; //minimum matching index found
 
   for(size_t i=0; i<n; i++){
@@ -140,7 +153,7 @@ size_t CLevel2Search::Permute(CMatching& matching, const size_t n){
 /// Reader function for the resulting vector of matchings.
 /// \return Reference to `m_stlResults`.
 
-const std::vector<CMatching>& CLevel2Search::GetMatchings() const{
+template<size_t N> const std::vector<CMatching<N>>& CLevel2Search<N>::GetMatchings() const{
   return m_stlResults;
 } //GetMatchings
 
@@ -154,7 +167,7 @@ const std::vector<CMatching>& CLevel2Search::GetMatchings() const{
 /// \param n Number of channels.
 /// \return Number of matchings on n channels.
 
-const size_t CLevel2Search::GetNumMatchings(const size_t n) const{
+template<size_t N> const size_t CLevel2Search<N>::GetNumMatchings(const size_t n) const{
   size_t result = 1;
 
   for(size_t i = oddfloor(n); i>1; i-=2)
@@ -164,15 +177,20 @@ const size_t CLevel2Search::GetNumMatchings(const size_t n) const{
 } //GetNumMatchings
 
 /// Save results to file for debugging purposes. The file name is hard-coded
-/// as `level2-x.txt` where `x` is the number of channels `m_nWidth`.
+/// as `level2-x.txt` where `x` is the number of channels `N`.
 
-void CLevel2Search::Save() const{
-  const std::string fname = "level2-" + std::to_string(m_nWidth) + ".txt";
+template<size_t N> void CLevel2Search<N>::Save() const{
+  const std::string fname = "level2-" + std::to_string(N) + ".txt";
   std::ofstream outfile(fname); //output file
 
   if(outfile.is_open()) //file opened correctly
-    for(const CMatching& m: m_stlResults) //for each matching
+    for(const CMatching<N>& m: m_stlResults) //for each matching
       outfile << std::string(m) << std::endl; //print matching as string
   
   outfile.close(); //end of file
-} //Save
\ No newline at end of file
+} //Save
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CLevel2Search<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
@@ -76,21 +76,39 @@
 /// \image html 2NFf.png width=25%
 /// This speeds up the search by not having to iterate through all 
 /// possibilities for the second level.
+///
+/// In addition, reversing the order of the channels and exchanging min and max
+/// maps a sorting network to a sorting network. This maps the first level to
+/// itself if the width is even, and to itself shifted by one channel if it is
+/// odd, which makes the reflected network first normal form once the unpaired
+/// channel is moved back to the bottom. If `CSettings::m_bReflect` is true,
+/// the second level is reflected in the same way by `CMatching::Reflect()`,
+/// and a second level candidate is included in the search only if it is the
+/// first in the set of candidates obtained from it by permuting pairs of
+/// channels, reflection, or both. This leaves 2 instead of 3 candidates for
+/// width 3, 6 instead of 9 for 5, 14 instead of 23 for 7, 35 instead of 58
+/// for 9, and 78 instead of 136 for 11. For even widths the mirror image of a
+/// second level is almost always a permutation of its pairs, so it leaves 43
+/// instead of 44 for width 12 and makes no difference to smaller even widths.
+/// Fewer second levels mean fewer networks found, since the ones that
+/// reflection maps to each other are found only once.
+///
+/// \tparam N Number of channels.
 
-class CLevel2Search: public CSettings{
+template<size_t N> class CLevel2Search: public CSettings{
   private:
     std::set<size_t> m_stlUsed; ///< Set of indices of used matchings.
-    std::vector<CMatching> m_stlResults; ///< Results.
+    std::vector<CMatching<N>> m_stlResults; ///< Results.
 
-    size_t Permute(CMatching&, const size_t); ///< Permute the matching.
+    size_t Permute(CMatching<N>&, const size_t); ///< Permute the matching.
 
-    size_t GetIndex(CMatching&); ///< Get the index of a matching.
+    size_t GetIndex(CMatching<N>&); ///< Get the index of a matching.
     const size_t GetNumMatchings(const size_t) const; ///< Number of matchings.
 
   public:
     CLevel2Search(); ///< Constructor.
     
-    const std::vector<CMatching>& GetMatchings() const; ///< Get matching vector.
+    const std::vector<CMatching<N>>& GetMatchings() const; ///< Get matching vector.
     void Save() const; ///< Save results to log file for debugging purposes.
 }; //CLevel2Search
 
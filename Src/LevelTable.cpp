@@ -0,0 +1,229 @@
+/// \file LevelTable.cpp
+/// \brief Code for the level transfer table sorting test `CLevelTable`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "LevelTable.h"
+#include "MatchingTable.h"
+#include "TernaryGrayCode.h"
+#include "Kernel.h"
+
+template<size_t N, size_t D> size_t CLevelTable<N, D>::m_nNumVectors = 0;
+template<size_t N, size_t D> uint16_t CLevelTable<N, D>::m_nInput[MAXVECTORS] = {0};
+template<size_t N, size_t D> uint8_t CLevelTable<N, D>::m_nTargetChannel[MAXVECTORS] = {0};
+template<size_t N, size_t D> bool CLevelTable<N, D>::m_bTransition[MAXVECTORS] = {false};
+
+/// Generate the test inputs in the same order as `CBitSlice::Initialize()`
+/// does, and for each test input record which channel of the sorted output
+/// changes from the previous test input, if it differs from it by one bit.
+/// If the level transfer table sorting test is to be used, build the shared
+/// transfer tables of the matchings too. This must be called after
+/// `CMatchingTable::Initialize()` and before any instance is used.
+
+template<size_t N, size_t D> void CLevelTable<N, D>::Initialize(){
+  CTernaryGrayCode<N> graycode; //test input generator
+  size_t t = 0; //index of current test input
+  const size_t nSweeps = odd(N)? 2: 1; //number of Gray code sweeps
+
+  for(size_t s=0; s<nSweeps; s++){ //for each sweep
+    size_t nInput = s? (size_t)1 << (N - 1): 0; //first test input
+    size_t nZeros = s? N - 1: N; //number of zeros in it
+    size_t i = 0; //index of bit to flip
+
+    graycode.Initialize(); //start at the all-zero word
+    m_bTransition[t] = false; //first test input of sweep follows from nothing
+
+    while(i < N){ //for each test input in this sweep
+      m_nInput[t] = (uint16_t)nInput; //record test input
+      i = graycode.Next(); //next bit to flip
+
+      if(i < N){ //flip it
+        const size_t nTarget = (nInput >> i) & 1? nZeros: nZeros - 1; //changed sorted output
+        nZeros += (nInput >> i) & 1? 1: -1;
+        nInput ^= (size_t)1 << i;
+        t++; //next test input
+
+        m_bTransition[t] = true;
+        m_nTargetChannel[t] = (uint8_t)nTarget;
+      } //if
+    } //while
+
+    t++; //first test input of next sweep does not follow from this one
+  } //for
+
+  m_nNumVectors = t;
+
+  if(m_eEngine == eEngine::Table)
+    CMatchingTable<N>::InitializeTransfer();
+} //Initialize
+
+/// Report that a level of the comparator network has changed, which means
+/// that the cached output of that level and all levels below it are invalid,
+/// and that its transfer table must be built.
+/// \param level Index of the level that changed.
+
+template<size_t N, size_t D> void CLevelTable<N, D>::Invalidate(const size_t level){
+  Invalidate(level, NumMatchings(N));
+} //Invalidate
+
+/// Report that a level of the comparator network has changed to a matching
+/// in `CMatchingTable`, which means that the cached output of that level and
+/// all levels below it are invalid, and that its transfer table is the one
+/// shared by that matching, if the shared tables have been built.
+/// \param level Index of the level that changed.
+/// \param index Index of the matching in `CMatchingTable`, or
+/// `NumMatchings(N)` if the level is not one of them.
+
+template<size_t N, size_t D>
+void CLevelTable<N, D>::Invalidate(const size_t level, const size_t index){
+  m_pTable[level] = index < NumMatchings(N)?
+    CMatchingTable<N>::GetTransfer(index): nullptr;
+
+  if(level < m_nValid)
+    m_nValid = level;
+} //Invalidate
+
+/// Push all test inputs through the levels of a comparator network from the
+/// second level down to a given level, starting from the cached output of the
+/// lowest level that has not changed since the last call. Each changed level
+/// uses the shared transfer table of its matching, or if it has none, has its
+/// own transfer table built first.
+/// \param comparator Comparator array.
+/// \param last Last level.
+
+template<size_t N, size_t D>
+void CLevelTable<N, D>::Evaluate(const uint8_t comparator[][N], const size_t last){
+  if(m_nValid == 0){ //load test inputs as output of first level
+    for(size_t t=0; t<m_nNumVectors; t++)
+      m_nWord[0][t] = m_nInput[t];
+
+    m_nValid = 1;
+  } //if
+
+  for(size_t i=m_nValid; i<=last; i++){ //for each level that has changed
+    const uint16_t* table = m_pTable[i]; //transfer table for this level
+
+    if(!table){ //no shared table, so build one
+      CMatchingTable<N>::BuildTransfer(comparator[i], m_nTable[i]);
+      table = m_nTable[i];
+    } //if
+
+    for(size_t t=0; t<m_nNumVectors; t++) //one lookup per test input
+      m_nWord[i][t] = table[m_nWord[i - 1][t]];
+  } //for
+
+  if(last >= m_nValid)
+    m_nValid = last + 1;
+
+  m_nLast = last;
+} //Evaluate
+
+/// Check whether all test inputs are sorted after the last level evaluated.
+/// \return true if no word has a one on a channel above a zero.
+
+template<size_t N, size_t D> bool CLevelTable<N, D>::Sorted() const{
+  const uint16_t nMask = (uint16_t)((1 << N) - 1); //one bit per channel
+  const uint16_t* word = m_nWord[m_nLast]; //outputs of the last level
+
+  for(size_t t=0; t<m_nNumVectors; t++)
+    if((word[t] << 1) & ~word[t] & nMask)
+      return false; //a one is followed by a zero
+
+  return true;
+} //Sorted
+
+/// Construct a level of comparators that sorts the outputs of the last level
+/// evaluated, if there is one, in the same way as `CBitSlice::Autocomplete()`.
+/// The channel whose value changed from the previous test input is the only
+/// bit in which consecutive words differ.
+/// \param comparator [in, out] Testable representation of the level to be
+/// constructed, initially with no comparators.
+/// \return true if a level of comparators that sorts was constructed.
+
+template<size_t N, size_t D>
+bool CLevelTable<N, D>::Autocomplete(uint8_t comparator[]) const{
+  const uint16_t* word = m_nWord[m_nLast]; //outputs of the last level
+
+  for(size_t t=1; t<m_nNumVectors; t++){ //for each test input
+    if(!m_bTransition[t])continue; //does not follow from the previous one
+
+    const size_t j = LowBit(word[t] ^ word[t - 1]); //channel that changed
+    const size_t k = m_nTargetChannel[t]; //channel it must go to
+
+    if(j != k){ //the change must move to another channel
+      uint8_t& cj = comparator[j]; //one end of comparator
+      uint8_t& ck = comparator[k]; //other end of comparator
+
+      if(cj == j && ck == k){ //both channels free
+        cj = (uint8_t)k;
+        ck = (uint8_t)j; //insert comparator
+      } //if
+
+      else if(cj != k || ck != j) //not already there
+        return false; //can't put a comparator in, so fail
+    } //if
+  } //for
+
+  return true;
+} //Autocomplete
+
+/// Apply the reachability heuristic of `CNearsort::StillNearsorts()` to the
+/// outputs of the last level evaluated, in the same way as
+/// `CBitSlice::Nearsorted()`.
+/// \param nFrom Maximum number of channels reachable from any channel.
+/// \param nTo Maximum number of channels that can reach any channel.
+/// \param nBoth Maximum number of channels reachable from or to any channel.
+/// \return true if the thresholds are met.
+
+template<size_t N, size_t D>
+bool CLevelTable<N, D>::Nearsorted(const size_t nFrom, const size_t nTo,
+  const size_t nBoth) const
+{
+  const uint16_t* word = m_nWord[m_nLast]; //outputs of the last level
+  uint16_t nReachFrom[N] = {0}; //channels reachable from each channel
+  uint16_t nReachTo[N] = {0}; //channels reachable to each channel
+
+  for(size_t t=1; t<m_nNumVectors; t++){ //for each test input
+    if(!m_bTransition[t])continue; //does not follow from the previous one
+
+    const size_t j = LowBit(word[t] ^ word[t - 1]); //channel that changed
+    const size_t k = m_nTargetChannel[t]; //channel it must reach
+
+    if(j != k){ //j reaches k
+      nReachFrom[j] |= (uint16_t)(1 << k);
+      nReachTo[k] |= (uint16_t)(1 << j);
+    } //if
+  } //for
+
+  for(size_t j=0; j<N; j++) //for each channel
+    if(PopCount(nReachFrom[j]) > nFrom || PopCount(nReachTo[j]) > nTo ||
+      PopCount(nReachFrom[j] | nReachTo[j]) > nBoth)
+        return false; //too many channels reachable from, to, or from or to, j
+
+  return true;
+} //Nearsorted
+
+//explicit instantiation for every width and depth
+
+#define INSTANTIATE(n, d) template class CLevelTable<n, d>;
+FOR_EACH_SHAPE(INSTANTIATE)
@@ -0,0 +1,81 @@
+/// \file LevelTable.h
+/// \brief Interface for the level transfer table sorting test `CLevelTable`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __LevelTable_h__
+#define __LevelTable_h__
+
+#include <cstdint>
+
+#include "Defines.h"
+#include "Settings.h"
+
+/// \brief Level transfer table sorting test.
+///
+/// Since a level of comparators maps \f$n\f$-bit zero-one words to
+/// \f$n\f$-bit zero-one words, it can be represented by a transfer table with
+/// \f$2^n\f$ entries, which for \f$n \leq 12\f$ fit into `uint16_t`.
+/// The value of a comparator network on a test input is then found by one
+/// table lookup per level, with bit `j` of the word holding the value on
+/// channel `j`, instead of a walk through the comparators.
+///
+/// The test inputs are generated by `CLevelTable::Initialize()` in the same
+/// order as `CBitSlice::Initialize()` does, so that consecutive test inputs
+/// differ in exactly one bit, and the words at the output of every level are
+/// cached in the same way as `CBitSlice` caches its channel masks. A level
+/// that changes to a matching from `CMatchingTable` uses the transfer table
+/// of that matching built once by `CMatchingTable::InitializeTransfer()`,
+/// and any other level has its table built when it changes. The levels of
+/// the prefix of a task are fixed, so they are applied to the test inputs
+/// only once per task, and every candidate starts from the cached words at
+/// the output of the prefix, as if from the output of one composite level.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+
+template<size_t N, size_t D> class CLevelTable: public CSettings{
+  private:
+    static size_t m_nNumVectors; ///< Number of test inputs.
+    static uint16_t m_nInput[MAXVECTORS]; ///< Test inputs.
+    static uint8_t m_nTargetChannel[MAXVECTORS]; ///< Sorted output channel that changes at each test input.
+    static bool m_bTransition[MAXVECTORS]; ///< Does the test input differ by one bit from the previous one?
+
+    alignas(64) uint16_t m_nTable[D][(size_t)1 << N]; ///< Transfer table built for each level.
+    const uint16_t* m_pTable[D] = {nullptr}; ///< Shared transfer table for each level, or `nullptr` to build one in `m_nTable`.
+    alignas(64) uint16_t m_nWord[D][MAXVECTORS]; ///< Word for each test input at the output of each level.
+    size_t m_nValid = 0; ///< Number of levels whose cached output is valid.
+    size_t m_nLast = 0; ///< Last level evaluated.
+
+  public:
+    static void Initialize(); ///< Generate the test inputs.
+
+    void Invalidate(const size_t); ///< A level has changed.
+    void Invalidate(const size_t, const size_t); ///< A level has changed to a matching in `CMatchingTable`.
+    void Evaluate(const uint8_t[][N], const size_t); ///< Push test inputs through levels.
+    bool Sorted() const; ///< Are all outputs sorted?
+    bool Autocomplete(uint8_t[]) const; ///< Construct a level that sorts all outputs.
+    bool Nearsorted(const size_t, const size_t, const size_t) const; ///< Reachability heuristic.
+}; //CLevelTable
+
+#endif //__LevelTable_h__
@@ -32,15 +32,31 @@
   #include <vld.h> //Visual Leak Detector from http://vld.codeplex.com/
 #endif
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <csignal>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include "Nearsort2.h"
+#include "BitSlice.h"
+#include "LevelTable.h"
+#include "MatchingTable.h"
+#include "PrefixSearch.h"
 
 #include "ThreadManager.h"
 #include "Task.h"
 #include "Timer.h"
+#include "Shard.h"
+#include "Coordinator.h"
+#include "Worker.h"
+#include "Telemetry.h"
 
 #include "TernaryGrayCode.h"
 
@@ -141,6 +157,245 @@ void ReadParams(bool& bNearsort2, const size_t d){
   } //if
 } //ReadParams
 
+/// \brief Read sorting test engine.
+/// 
+/// Read whether the bit-sliced sorting test is to be used, and if not,
+/// whether the level transfer tables are to be used.
+/// \param engine [out] Sorting test engine.
+
+void ReadParams(eEngine& engine){
+  std::cout << "Use bit-sliced sorting test? [yn]" << std::endl << "> ";
+  std::string strLine;
+  std::getline(std::cin, strLine);
+  const bool bBitSlice = strLine[0] == 'y' || strLine[0] == 'Y';
+  engine = bBitSlice? eEngine::BitSlice: eEngine::GrayCode;
+
+  if(!bBitSlice){
+    std::cout << "Use level transfer tables? [yn]" << std::endl << "> ";
+    std::getline(std::cin, strLine);
+
+    if(strLine[0] == 'y' || strLine[0] == 'Y')
+      engine = eEngine::Table;
+  } //if
+} //ReadParams
+
+/// \brief Read pruning and symmetry settings.
+/// 
+/// Read whether matchings that repeat a comparator from the level above are
+/// to be skipped, whether second level candidates are to be reduced by
+/// reflection as well as by permutations of pairs of channels, and whether
+/// third levels that a symmetry of the first two maps to smaller ones are to
+/// be skipped.
+/// \param bPrune [out] true to prune repeated comparators.
+/// \param bReflect [out] true to reduce second levels by reflection.
+/// \param bSymmetry [out] true to skip symmetric third levels.
+
+void ReadParams(bool& bPrune, bool& bReflect, bool& bSymmetry){
+  std::cout << "Prune matchings that repeat a comparator? [yn]" << std::endl << "> ";
+  std::string strLine;
+  std::getline(std::cin, strLine);
+  bPrune = strLine[0] == 'y' || strLine[0] == 'Y';
+
+  std::cout << "Reduce second levels by reflection? [yn]" << std::endl << "> ";
+  std::getline(std::cin, strLine);
+  bReflect = strLine[0] == 'y' || strLine[0] == 'Y';
+
+  std::cout << "Skip third levels that are symmetric to others? [yn]" << std::endl << "> ";
+  std::getline(std::cin, strLine);
+  bSymmetry = strLine[0] == 'y' || strLine[0] == 'Y';
+} //ReadParams
+
+/// \brief Maximum subsumption filter level.
+///
+/// The fixed levels must end above the ones that the search classes
+/// enumerate or construct themselves, so the subsumption filter level is at
+/// most 2 for depth 3, and at most 3 less than the depth with nearsort2 or 2
+/// less without.
+/// \param d Depth.
+/// \param bNearsort2 true if using the nearsort2 heuristic.
+/// \return Maximum subsumption filter level.
+
+size_t MaxSubsumeLevel(const size_t d, const bool bNearsort2){
+  return d <= 3? 2: bNearsort2? d - 3: d - 2;
+} //MaxSubsumeLevel
+
+/// \brief Range of split levels.
+///
+/// The matchings at the level below the split level must be enumerated by
+/// the search classes rather than constructed, so the split level is at most
+/// 4 less than the depth with nearsort2 or 3 less without, and no less than
+/// the subsumption filter level or 2.
+/// \param k Subsumption filter level.
+/// \param d Depth.
+/// \param bNearsort2 true if using the nearsort2 heuristic.
+/// \param smin [out] Minimum split level.
+/// \param smax [out] Maximum split level.
+/// \return false if there is no split level in range.
+
+bool SplitLevels(const size_t k, const size_t d, const bool bNearsort2,
+  size_t& smin, size_t& smax)
+{
+  smin = std::max(k, (size_t)2);
+  smax = d < 5? 0: bNearsort2? d - 4: d - 3;
+
+  return d >= 5 && smax >= smin;
+} //SplitLevels
+
+/// \brief Read subsumption filter level.
+/// 
+/// Read the level down to which prefixes are to be filtered by subsumption,
+/// which is at most `MaxSubsumeLevel()`.
+/// \param k [out] Subsumption filter level, or 0 for none.
+/// \param d Depth.
+/// \param bNearsort2 true if using the nearsort2 heuristic.
+
+void ReadParams(size_t& k, const size_t d, const bool bNearsort2){
+  const size_t kmax = MaxSubsumeLevel(d, bNearsort2); //maximum level
+  bool ok = false; //for loop control
+
+  while(!ok){
+    k = getn("Enter subsumption filter level, 0 for none, at most " +
+      std::to_string(kmax) + ".");
+    ok = k == 0 || (k >= 2 && k <= kmax);
+    if(!ok)std::cout << "Out of range" << std::endl;
+  } //while
+} //ReadParams
+
+/// \brief Read task split settings.
+/// 
+/// Read the split level, that is, the number of levels that each search task
+/// fixes, and the number of tasks into which the matchings at the
+/// level below each prefix of that many levels are to be divided. The split
+/// level must be in the range given by `SplitLevels()`.
+/// \param s [out] Split level, or 0 for none.
+/// \param r [out] Number of tasks per prefix.
+/// \param k Subsumption filter level.
+/// \param n Width.
+/// \param d Depth.
+/// \param bNearsort2 true if using the nearsort2 heuristic.
+
+void ReadParams(size_t& s, size_t& r, const size_t k, const size_t n,
+  const size_t d, const bool bNearsort2)
+{
+  size_t smin = 0; //minimum level
+  size_t smax = 0; //maximum level
+  bool ok = false; //for loop control
+
+  s = 0;
+  r = 1;
+
+  if(!SplitLevels(k, d, bNearsort2, smin, smax))
+    return; //nowhere to split
+
+  while(!ok){
+    s = getn("Enter task split level, 0 for one task per prefix, at least " +
+      std::to_string(smin) + " and at most " + std::to_string(smax) + ".");
+    ok = s == 0 || (s >= smin && s <= smax);
+    if(!ok)std::cout << "Out of range" << std::endl;
+  } //while
+
+  ok = s == 0;
+
+  while(!ok){
+    r = getn("Enter number of tasks per prefix, at most " +
+      std::to_string(NumMatchings(n)) + ".");
+    ok = r >= 1 && r <= NumMatchings(n);
+    if(!ok)std::cout << "Out of range" << std::endl;
+  } //while
+} //ReadParams
+
+/// \brief Read resume setting.
+/// 
+/// Read whether the search is to be resumed from a checkpoint.
+/// \param bResume [out] true to resume from the checkpoint.
+/// \param strFile Checkpoint file name.
+
+void ReadParams(bool& bResume, const std::string& strFile){
+  std::cout << "Resume from checkpoint " << strFile << "? [yn]" << std::endl << "> ";
+  std::string strLine;
+  std::getline(std::cin, strLine);
+  bResume = strLine[0] == 'y' || strLine[0] == 'Y';
+} //ReadParams
+
+/// \brief Make checkpoint header.
+///
+/// Make the header line of the checkpoint file, which records the settings
+/// read by the other overloads of `ReadParams()`, so that they need not be
+/// read again when resuming.
+/// \param n Width.
+/// \param d Depth.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param engine Sorting test engine.
+/// \param bPrune true to prune repeated comparators.
+/// \param bReflect true to reduce second levels by reflection.
+/// \param bSymmetry true to skip symmetric third levels.
+/// \param k Subsumption filter level.
+/// \param s Split level.
+/// \param r Number of tasks per prefix.
+/// \return Header line.
+
+std::string CheckpointHeader(const size_t n, const size_t d,
+  const bool bNearsort2, const eEngine engine, const bool bPrune,
+  const bool bReflect, const bool bSymmetry, const size_t k, const size_t s,
+  const size_t r)
+{
+  return "search " + std::to_string(n) + " " + std::to_string(d) + " " +
+    std::to_string(bNearsort2) + " " + std::to_string((int)engine) + " " +
+    std::to_string(bPrune) + " " + std::to_string(bReflect) + " " +
+    std::to_string(bSymmetry) + " " + std::to_string(k) + " " +
+    std::to_string(s) + " " + std::to_string(r);
+} //CheckpointHeader
+
+/// \brief Read settings from checkpoint.
+///
+/// Read the settings from the header line of a checkpoint file made by
+/// `CheckpointHeader()`, and check that every one of them is in the range
+/// that the other overloads of `ReadParams()` accept from the user, since
+/// together they determine the task list that the rest of the checkpoint
+/// describes.
+/// \param f [in, out] Checkpoint file stream.
+/// \param n [out] Width.
+/// \param d [out] Depth.
+/// \param bNearsort2 [out] true to use nearsort2 heuristic (if appropriate).
+/// \param engine [out] Sorting test engine.
+/// \param bPrune [out] true to prune repeated comparators.
+/// \param bReflect [out] true to reduce second levels by reflection.
+/// \param bSymmetry [out] true to skip symmetric third levels.
+/// \param k [out] Subsumption filter level.
+/// \param s [out] Split level.
+/// \param r [out] Number of tasks per prefix.
+/// \return true if the settings were read and are all in range.
+
+bool ReadParams(std::istream& f, size_t& n, size_t& d, bool& bNearsort2,
+  eEngine& engine, bool& bPrune, bool& bReflect, bool& bSymmetry, size_t& k,
+  size_t& s, size_t& r)
+{
+  std::string strTag; //line tag
+  int nEngine = 0; //sorting test engine
+  f >> strTag >> n >> d >> bNearsort2 >> nEngine >> bPrune >> bReflect >>
+    bSymmetry >> k >> s >> r;
+  engine = (eEngine)nEngine;
+
+  if(f.fail() || strTag != "search" || n < 3 || n > MAXINPUTS ||
+    d < 3 || d > MAXDEPTH || nEngine < 0 || nEngine > (int)eEngine::Table)
+    return false; //unreadable or out of range
+
+  if(bNearsort2 && d < 5)
+    return false; //too shallow for nearsort2
+
+  if(k != 0 && (k < 2 || k > MaxSubsumeLevel(d, bNearsort2)))
+    return false; //subsumption filter level out of range
+
+  size_t smin = 0; //minimum split level
+  size_t smax = 0; //maximum split level
+
+  if(s == 0)
+    return r == 1; //one task per prefix
+
+  return SplitLevels(k, d, bNearsort2, smin, smax) && s >= smin &&
+    s <= smax && r >= 1 && r <= NumMatchings(n);
+} //ReadParams
+
 /// \brief Save summary string.
 ///
 /// Append a summary string to the log file `log.txt` and print it to 
@@ -157,65 +412,1244 @@ void SaveSummary(const std::string s){
   logfile.close();
 } //SaveSummary
 
-/// \brief Multi-threaded search.
+/// \brief Summarize counterexample cache counters.
+///
+/// Make a summary string describing how many of the candidates rejected by
+/// the sorting test were refuted by a cached counterexample, and the average
+/// number of test input changes tried on each rejected candidate.
+/// \param c Counterexample cache counters.
+/// \return Summary string.
+
+std::string WitnessSummary(const CWitnessCache& c){
+  const size_t nRejects = c.GetRejects(); //number of rejected candidates
+  const double fHitRate = c.GetLookups()? 100.0*c.GetHits()/c.GetLookups(): 0;
+  const double fTests = nRejects? (double)c.GetRejectTests()/nRejects: 0;
+
+  std::ostringstream s;
+  s << std::fixed << std::setprecision(1);
+  s << "Counterexample cache refuted " << c.GetHits() << " of " <<
+    c.GetLookups() << " candidates (" << fHitRate << "%), " << fTests <<
+    " test inputs per rejected candidate";
+
+  return s.str();
+} //WitnessSummary
+
+/// \brief Summarize pruning counters.
+///
+/// Make a summary string listing the number of matchings skipped at each
+/// level because they repeat a comparator from the level above. Levels are
+/// numbered from 1, and the first two are never pruned.
+/// \param p Array of pruning counters, one per level.
+/// \param d Depth.
+/// \return Summary string.
+
+std::string PruneSummary(const size_t p[], const size_t d){
+  std::string s = "Matchings pruned for repeating a comparator:";
+
+  for(size_t i=2; i<d; i++)
+    s += " level " + std::to_string(i + 1) + " " + std::to_string(p[i]) +
+      (i < d - 1? ",": "");
+
+  return s;
+} //PruneSummary
+
+/// \brief Save run report.
+///
+/// Save a report of a completed search to a JSON file next to the log file:
+/// the settings, the results, the counterexample cache and pruning
+/// counters, and if `STATS` is defined, the search statistics counters from
+/// `CStats`. If the search was resumed from a checkpoint, then the counters
+/// cover only the part of the search since it was resumed.
+/// \param strFile File name.
+/// \param strSettings Settings line.
+/// \param d Depth.
+/// \param bResume Whether the search was resumed from a checkpoint.
+/// \param p Pointer to thread manager after the search.
+/// \param timer Timer started at the start of the search.
+/// \return true if the file was written.
+
+bool SaveReport(const std::string& strFile, const std::string& strSettings,
+  const size_t d, const bool bResume, const CThreadManager* p,
+  const CTimer& timer)
+{
+  std::ofstream f(strFile);
+
+  if(!f.is_open())
+    return false;
+
+  const CWitnessCache& c = p->GetWitnessStats(); //counterexample cache counters
+  const size_t* pPruned = p->GetPruneStats(); //pruning counters
+
+  f << std::fixed << std::setprecision(2);
+  f << "{" << std::endl;
+  f << "  \"settings\": \"" << strSettings << "\"," << std::endl;
+  f << "  \"resumed\": " << (bResume? "true": "false") << "," << std::endl;
+  f << "  \"threads\": " << p->GetNumThreads() << "," << std::endl;
+  f << "  \"tasks\": " << p->GetNumTasks() << "," << std::endl;
+  f << "  \"donations\": " << p->GetNumDonations() << "," << std::endl;
+  f << "  \"found\": " << p->GetCount() << "," << std::endl;
+  f << "  \"elapsed_seconds\": " << timer.GetElapsedSeconds() << "," << std::endl;
+  f << "  \"cpu_seconds\": " << timer.GetCPUSeconds() << "," << std::endl;
+  f << "  \"witness_cache\": {\"lookups\": " << c.GetLookups() <<
+    ", \"hits\": " << c.GetHits() << ", \"rejects\": " << c.GetRejects() <<
+    ", \"reject_tests\": " << c.GetRejectTests() << "}," << std::endl;
+  f << "  \"pruned\": [";
+
+  for(size_t i=0; i<d; i++)
+    f << (i? ", ": "") << pPruned[i];
+
+  f << "]";
+
+  #ifdef STATS
+    f << "," << std::endl << "  \"stats\": ";
+    p->GetStats().Save(f, d);
+  #endif //STATS
+
+  f << std::endl << "}" << std::endl;
+
+  return !f.fail();
+} //SaveReport
+
+/// \brief Make a searchable sorting network.
 ///
-/// Conduct multi-threaded sorting network search. First search for all level 2
-/// candidates, then pass each one as a task to the thread manager. Get the
-/// thread manager to spawn the search threads, wait until they terminate, then
-/// process the results.
+/// Make a searchable sorting network of the class that suits the depth.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param prefix Prefix of fixed levels.
+/// \param index Index of task.
+/// \param first Index of first matching at the level below the prefix.
+/// \param last One more than the index of the last matching at that level.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \return Pointer to the new searchable sorting network.
+
+template<size_t N, size_t D>
+CSearchableBase* NewSearch(const CPrefix<N>& prefix, const size_t index,
+  const size_t first, const size_t last, const bool bNearsort2)
+{
+  switch(D){ //choose optimization depending on depth
+    case 2: return new C2NF<N, D>(prefix, index, first, last);
+    case 3: return new CAutocomplete<N, D>(prefix, index, first, last);
+    case 4: return new CNearsort<N, D>(prefix, index, first, last);
+    default: //depth 5 or greater
+      if(bNearsort2)
+        return new CNearsort2<N, D>(prefix, index, first, last); 
+      else return new CNearsort<N, D>(prefix, index, first, last); 
+  } //switch
+} //NewSearch
+
+/// \brief Insert new tasks.
+///
+/// First search for all level 2 candidates and make prefixes from them, then
+/// divide the matchings at the level below each prefix into contiguous ranges
+/// of indices, number the resulting tasks consecutively, and pass each prefix
+/// and range whose task is in this process's shard to the thread manager.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
 /// \param p Pointer to thread manager.
-/// \param nDepth Sorting network depth.
 /// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
 
-void Search(CThreadManager* p, const size_t nDepth, const bool bNearsort2){
-  CLevel2Search* pLevel2Search = new CLevel2Search(); //for level 2 matchings
+template<size_t N, size_t D>
+void InsertTasks(CThreadManager* p, const bool bNearsort2, const size_t r){
+  CLevel2Search<N>* pLevel2Search = new CLevel2Search<N>(); //for level 2 matchings
   auto L2Matchings = pLevel2Search->GetMatchings(); //get level 2 matchings
-  size_t i = 0; //index of current matching
+  CPrefixSearch<N>* pPrefixSearch = new CPrefixSearch<N>(L2Matchings); //for prefixes
+  const size_t m = NumMatchings(N); //number of matchings at the level below a prefix
+  size_t i = 0; //index of current task
 
-  //insert search tasks to task queue
+  for(const CPrefix<N>& prefix: pPrefixSearch->GetPrefixes()) //for each prefix
+    for(size_t j=0; j<r; j++, i++){ //for each range of matchings below it
+      const size_t first = j*m/r; //index of first matching in range
+      const size_t last = (j + 1)*m/r; //one more than index of last matching
 
-  for(auto matching: L2Matchings){ //for each level2 matching
-    CSearchable* pSearch = nullptr; //for the searchable sorting network
-
-    switch(nDepth){ //choose optimization depending on depth
-      case 2: pSearch = new C2NF(matching, i++); break;
-      case 3: pSearch = new CAutocomplete(matching, i++); break;
-      case 4: pSearch = new CNearsort(matching, i++); break;
-      default: //depth 5 or greater
-        if(bNearsort2)
-          pSearch = new CNearsort2(matching, i++); 
-        else pSearch = new CNearsort(matching, i++); 
-        break;
-    } //switch
+      if(p->Owns(i)) //in this shard
+        p->Insert(new CTask(NewSearch<N, D>(prefix, i, first, last,
+          bNearsort2))); //insert search task
+    } //for
 
-    p->Insert(new CTask(pSearch)); //insert search task
+  p->SetNumTasks(i);
+
+  delete pPrefixSearch;
+  delete pLevel2Search;
+} //InsertTasks
+
+/// \brief Check a matching.
+///
+/// Check whether some of the numbers in a task layout are the testable
+/// representation of a matching, that is, whether each is a channel, each
+/// channel is matched with the one that is matched with it, and no channel
+/// is matched with itself except the last one left over when the width is odd.
+/// \param v Layout of a task from `ReadLayout()`.
+/// \param offset Position in v of the testable representation.
+/// \param n Width.
+/// \return true if they are a matching.
+
+bool IsMatching(const std::vector<size_t>& v, const size_t offset, const size_t n){
+  size_t nUnmatched = 0; //number of channels matched with themselves
+
+  for(size_t j=0; j<n; j++){ //for each channel
+    const size_t k = v[offset + j]; //channel matched with it
+
+    if(k >= n || v[offset + k] != j)
+      return false; //not a channel, or not matched back
+
+    if(k == j)
+      nUnmatched++;
+  } //for
+
+  return nUnmatched == (n & 1);
+} //IsMatching
+
+/// \brief Read task layout.
+///
+/// Read the part of a task description saved by `C2NF::Checkpoint()` that
+/// places the task in the task list, that is, its index, the number of
+/// levels that it fixes, the comparators of the fixed levels below the
+/// first, and its range of matchings at the topmost level. Check that it fixes
+/// at least one level and at most the depth, that each fixed level is a
+/// matching, and that its range is within the matchings, so that a corrupt
+/// checkpoint or a bad message from a coordinator is rejected rather than
+/// searched.
+/// \param s [in, out] Stream to read from, left after that part.
+/// \param n Width.
+/// \param d Depth.
+/// \param v [out] The numbers in that part of the description, in order.
+/// \return true if they were read and are valid.
+
+bool ReadLayout(std::istream& s, const size_t n, const size_t d,
+  std::vector<size_t>& v)
+{
+  size_t index = 0; //task index
+  size_t levels = 0; //number of fixed levels
+
+  if(!(s >> index >> levels) || levels < 1 || levels > d)
+    return false;
+
+  v.assign(1, index);
+  v.push_back(levels);
+
+  for(size_t i=0; i<(levels - 1)*n + 2; i++){ //prefix and range
+    size_t x = 0; //next number
+
+    if(!(s >> x))
+      return false;
+
+    v.push_back(x);
+  } //for
+
+  for(size_t i=1; i<levels; i++) //for each fixed level below the first
+    if(!IsMatching(v, 2 + (i - 1)*n, n))
+      return false;
+
+  const size_t first = v[v.size() - 2]; //index of first matching in range
+  const size_t last = v.back(); //one more than index of last matching in range
+
+  return first <= last && last <= NumMatchings(n);
+} //ReadLayout
+
+/// \brief Read a task.
+///
+/// Read a task saved by `C2NF::Checkpoint()`, without its tag. Check its
+/// layout with `ReadLayout()`, reconstruct the searchable sorting network from
+/// its index, prefix and range, and restore the state of its search.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param f [in, out] Stream to read from.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param index [out] Index of task.
+/// \return Pointer to the new searchable sorting network, or `nullptr` if
+/// the layout is not valid.
+
+template<size_t N, size_t D>
+CSearchableBase* ReadTask(std::istream& f, const bool bNearsort2, size_t& index){
+  std::vector<size_t> v; //layout of task
+
+  if(!ReadLayout(f, N, D, v))
+    return nullptr;
+
+  index = v[0];
+  CPrefix<N> prefix; //fixed levels
+
+  for(size_t i=1; i<v[1]; i++){ //for each level below the first
+    uint8_t comparator[N] = {0}; //testable representation
+
+    for(size_t j=0; j<N; j++)
+      comparator[j] = (uint8_t)v[2 + (i - 1)*N + j];
+
+    prefix.Append(comparator);
+  } //for
+
+  CSearchableBase* pSearch = NewSearch<N, D>(prefix, index, v[v.size() - 2],
+    v.back(), bNearsort2); //searchable sorting network
+  pSearch->Resume(f); //restore state of search
+
+  return pSearch;
+} //ReadTask
+
+/// \brief Describe new tasks.
+///
+/// Make the tasks of a new search as for `Search()`, and describe each of
+/// them as `C2NF::Checkpoint()` does, so that it can be reconstructed by
+/// `ReadTask()`. The root task index that `CThreadManager::Checkpoint()`
+/// puts before each description is left out, since a new task is its own
+/// root.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+/// \param tasks [out] Task descriptions.
+
+template<size_t N, size_t D>
+void DescribeTasks(const bool bNearsort2, const size_t r,
+  std::vector<std::string>& tasks)
+{
+  CThreadManager* p = new CThreadManager; //to hold the tasks while describing them
+  InsertTasks<N, D>(p, bNearsort2, r);
+
+  std::stringstream s; //task descriptions
+  p->Checkpoint(s);
+  delete p;
+
+  const std::string strTag = "task "; //task line tag
+  std::string strLine; //one line of the descriptions
+
+  while(std::getline(s, strLine))
+    if(strLine.compare(0, strTag.size(), strTag) == 0)
+      tasks.push_back(strLine.substr(strLine.find(' ', strTag.size()) + 1));
+} //DescribeTasks
+
+/// \brief Find a matching.
+///
+/// Find the index in `CMatchingTable` of the matching whose testable
+/// representation is given by some of the numbers in a task layout.
+/// \tparam N Sorting network width.
+/// \param v Layout of a task from `ReadLayout()`.
+/// \param offset Position in v of the testable representation.
+/// \return Index of the matching, or the number of matchings if there is none.
+
+template<size_t N>
+size_t FindMatching(const std::vector<size_t>& v, const size_t offset){
+  for(size_t i=0; i<NumMatchings(N); i++){ //for each matching
+    const uint8_t* comparator = CMatchingTable<N>::GetComparators(i); //testable representation
+    size_t j = 0; //channel
+
+    while(j < N && comparator[j] == v[offset + j])
+      j++;
+
+    if(j == N)
+      return i;
   } //for
 
+  return NumMatchings(N);
+} //FindMatching
+
+/// \brief Check task layout.
+///
+/// Check whether a task could have been split off a new task by
+/// `CSearchable::Split()`, or be what is left of it, that is, whether it
+/// fixes the same levels as the new task and possibly more, and if it fixes
+/// the same levels, whether its range at the topmost level is within that of
+/// the new task, or if it fixes more, whether the matching that it fixes at
+/// the topmost level of the new task is within that range.
+/// \tparam N Sorting network width.
+/// \param task Layout of a task from `ReadLayout()`.
+/// \param root Layout of a new task from `ReadLayout()`.
+/// \return true if the task descends from the new task.
+
+template<size_t N>
+bool Descends(const std::vector<size_t>& task, const std::vector<size_t>& root){
+  const size_t levels = root[1]; //number of levels fixed by the new task
+  const size_t first = root[root.size() - 2]; //first matching in range of new task
+  const size_t last = root.back(); //one more than last matching in range of new task
+
+  if(task[1] < levels)
+    return false; //fixes fewer levels
+
+  for(size_t i=2; i<2 + (levels - 1)*N; i++)
+    if(task[i] != root[i])
+      return false; //different prefix
+
+  if(task[1] > levels){ //fixes more levels, so its range is at a lower level
+    const size_t index = FindMatching<N>(task, 2 + (levels - 1)*N); //matching at topmost level of new task
+    return first <= index && index < last;
+  } //if
+
+  return first <= task[task.size() - 2] && task.back() <= last;
+} //Descends
+
+/// \brief Get part of root task.
+///
+/// Get the part of the search tree of a new task that is below the range of
+/// a task that descends from it by `Descends()`, as `CSearchable::Split()`
+/// divides it, taking the matchings at each level to have subtrees of the
+/// same size, as `CSearchable::GetProgress()` does.
+/// \tparam N Sorting network width.
+/// \param task Layout of a task from `ReadLayout()`.
+/// \param root Layout of the new task from `ReadLayout()`.
+/// \param fStart [out] Start of the part, as a fraction of the new task.
+/// \param fShare [out] Size of the part, as a fraction of the new task.
+
+template<size_t N>
+void GetShare(const std::vector<size_t>& task, const std::vector<size_t>& root,
+  double& fStart, double& fShare)
+{
+  const size_t m = NumMatchings(N); //number of matchings
+  size_t first = root[root.size() - 2]; //first matching in range at this level
+  size_t last = root.back(); //one more than last matching in range at this level
+  fStart = 0;
+  fShare = 1;
+
+  for(size_t i=root[1]; i<task[1]; i++){ //for each level fixed below the new task's
+    fShare /= last - first;
+    fStart += fShare*(FindMatching<N>(task, 2 + (i - 1)*N) - first);
+    first = 0; //all matchings below
+    last = m;
+  } //for
+
+  fStart += fShare*(task[task.size() - 2] - first)/(last - first);
+  fShare *= (double)(task.back() - task[task.size() - 2])/(last - first);
+} //GetShare
+
+/// \brief Resume tasks from checkpoint.
+///
+/// Read the task lines of a checkpoint file saved by
+/// `CThreadManager::Checkpoint()` and pass the tasks to the thread manager,
+/// after checking that they fit the task list that the settings in its
+/// header make. The number of tasks in the whole search must be the same,
+/// and each task must be in this shard and descend by `Descends()` from its
+/// root, which must be the new task with the same index unless the task was
+/// donated.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param p Pointer to thread manager.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+/// \param f [in, out] Checkpoint file stream, after the totals line.
+/// \return false if the tasks do not fit the task list.
+
+template<size_t N, size_t D>
+bool ResumeTasks(CThreadManager* p, const bool bNearsort2, const size_t r,
+  std::istream& f)
+{
+  std::vector<std::string> tasks; //descriptions of new tasks
+  DescribeTasks<N, D>(bNearsort2, r, tasks);
+
+  if(p->GetNumTasks() != tasks.size())
+    return false; //different number of tasks
+
+  std::vector<std::vector<size_t>> roots(tasks.size()); //layouts of new tasks, by index
+
+  for(const std::string& strTask: tasks){
+    std::istringstream s(strTask); //new task description
+    std::vector<size_t> v; //layout of new task
+    ReadLayout(s, N, D, v);
+    roots[v[0]] = v;
+  } //for
+
+  std::string strTag; //line tag
+
+  while(f >> strTag && strTag == "task"){ //for each task line
+    size_t root = roots.size(); //index of root task
+    std::string strTask; //task description
+    f >> root;
+    std::getline(f, strTask);
+
+    std::istringstream layout(strTask); //task description, for its layout
+    std::vector<size_t> v; //layout of task
+
+    if(!ReadLayout(layout, N, D, v) || !p->Owns(v[0]) || root >= roots.size())
+      return false; //unreadable, invalid, or in another shard
+
+    if((v[0] < roots.size() && v[0] != root) || !Descends<N>(v, roots[root]))
+      return false; //not descended from its root
+
+    std::istringstream s(strTask); //task description
+    size_t index = 0; //index of task
+    CSearchableBase* pSearch = ReadTask<N, D>(s, bNearsort2, index); //searchable sorting network
+    double fStart = 0; //start of its part of the root task
+    double fShare = 1; //size of that part
+    GetShare<N>(v, roots[root], fStart, fShare);
+    pSearch->SetRoot(root);
+    pSearch->SetShare(fStart, fShare);
+    p->Insert(new CTask(pSearch)); //insert search task
+  } //while
+
+  return true;
+} //ResumeTasks
+
+/// \brief Initialize tables.
+///
+/// Initialize the tables shared by the searchable sorting networks of a
+/// given width and depth.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+
+template<size_t N, size_t D> void Initialize(){
+  CMatchingTable<N>::Initialize(); //generate all matchings for the searchable sorting networks
+  CBitSlice<N, D>::Initialize(); //generate test inputs for bit-sliced sorting test
+  CLevelTable<N, D>::Initialize(); //and for level transfer table sorting test
+} //Initialize
+
+/// \brief Multi-threaded search.
+///
+/// Conduct multi-threaded sorting network search. Insert new tasks, or
+/// resume them from a checkpoint. Get the thread manager to spawn the search
+/// threads, wait until they terminate, then process the results.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param p Pointer to thread manager.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+/// \param pCheckpoint Pointer to checkpoint file stream to resume from, or
+/// `nullptr` to start afresh.
+/// \return false if the tasks in the checkpoint do not fit its settings.
+
+template<size_t N, size_t D>
+bool Search(CThreadManager* p, const bool bNearsort2, const size_t r,
+  std::istream* pCheckpoint)
+{
+  Initialize<N, D>();
+
+  //insert search tasks to task queue
+
+  if(pCheckpoint){
+    if(!ResumeTasks<N, D>(p, bNearsort2, r, *pCheckpoint))
+      return false;
+  } //if
+
+  else InsertTasks<N, D>(p, bNearsort2, r);
+
   //perform multi-threaded backtracking search
 
   p->Spawn(); //spawn threads
   p->Wait(); //wait for threads to finish
   p->Process(); //process results
 
-  delete pLevel2Search;
+  return true;
 } //Search
 
+/// \brief Search function.
+///
+/// Pointer to an instance of `Search()` for a given width and depth.
+
+typedef bool (*SearchFunction)(CThreadManager*, const bool, const size_t,
+  std::istream*);
+
+/// \brief Get search function.
+///
+/// Look up the instance of `Search()` for a given width and depth in a
+/// dispatch table with an entry for every width and depth accepted by
+/// `CheckParams()`.
+/// \param n Width.
+/// \param d Depth.
+/// \return Pointer to search function, or `nullptr` if there is none.
+
+SearchFunction GetSearchFunction(const size_t n, const size_t d){
+  SearchFunction table[MAXINPUTS + 1][MAXDEPTH + 1] = {{nullptr}}; //dispatch table
+
+  #define DISPATCH(n, d) table[n][d] = Search<n, d>;
+  FOR_EACH_SHAPE(DISPATCH)
+
+  return n <= MAXINPUTS && d <= MAXDEPTH? table[n][d]: nullptr;
+} //GetSearchFunction
+
+/// \brief Distributed search coordinator.
+///
+/// Make the tasks of a new search as for `Search()`, and have the
+/// coordinator issue them to workers until they have all been completed.
+/// The coordinator never tests a network for sorting, so it generates only
+/// the matchings that the tasks are made from, not the test inputs and
+/// transfer tables of the sorting tests, and has the tasks that it describes
+/// use the Gray code engine so that none of them allocates a level table.
+/// The workers still use the engine in the settings line.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param pCoordinator Pointer to coordinator.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+
+template<size_t N, size_t D>
+void Coordinate(CCoordinator* pCoordinator, const bool bNearsort2, const size_t r){
+  CMatchingTable<N>::Initialize(); //generate all matchings for the tasks
+  CSettings::SetEngine(eEngine::GrayCode); //no sorting test tables needed
+
+  std::vector<std::string> tasks; //task descriptions
+  DescribeTasks<N, D>(bNearsort2, r, tasks);
+
+  for(const std::string& strTask: tasks)
+    pCoordinator->AddTask(strTask);
+
+  pCoordinator->Run();
+} //Coordinate
+
+/// \brief Distributed search worker.
+///
+/// Get tasks from the coordinator one at a time, perform each of them, and
+/// report the results, until the coordinator says that the search is done.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param pWorker Pointer to worker.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+
+template<size_t N, size_t D>
+void Work(CWorker* pWorker, const bool bNearsort2){
+  Initialize<N, D>();
+
+  CTimer timer; //for CPU time
+  std::string strTask; //task description
+
+  while(pWorker->GetTask(strTask)){
+    std::istringstream s(strTask);
+    size_t index = 0; //task index
+    CSearchableBase* pSearch = ReadTask<N, D>(s, bNearsort2, index); //searchable sorting network
+
+    if(!pSearch){ //not a valid task
+      std::cout << "Bad task from coordinator" << std::endl;
+      break;
+    } //if
+
+    pSearch->KeepNetworks(); //for the coordinator to save
+    CTask task(pSearch);
+
+    timer.Start();
+    task.Perform();
+
+    if(!pWorker->Report(index, task.GetCount(), timer.GetCPUSeconds(),
+      pSearch->GetNetworks()))
+      break;
+  } //while
+} //Work
+
+/// \brief Estimate search tree size and time.
+///
+/// Make the tasks of a new search as for `Search()`, and instead of
+/// performing them, make up to `ESTIMATEPROBES` of Knuth's random probes of
+/// the search tree of each one with `CSearchable::Probe()`, stopping early
+/// when the task has had its share of `ESTIMATESECONDS`, so that the
+/// estimate takes seconds even when each probe is slow. Report the estimated
+/// number of nodes and candidates and the estimated CPU time of each task,
+/// and their totals, with the standard error of the total CPU time.
+/// \tparam N Sorting network width.
+/// \tparam D Sorting network depth.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+
+template<size_t N, size_t D>
+void Estimate(const bool bNearsort2, const size_t r){
+  Initialize<N, D>();
+
+  std::vector<std::string> tasks; //task descriptions
+  DescribeTasks<N, D>(bNearsort2, r, tasks);
+
+  std::mt19937_64 random; //pseudo-random number generator, default seed for repeatability
+  double fNodes = 0; //total estimated number of nodes
+  double fCandidates = 0; //total estimated number of candidates
+  double fSeconds = 0; //total estimated CPU time
+  double fVariance = 0; //variance of total estimated CPU time
+  size_t nProbes = 0; //total number of probes
+
+  const double fBudget = (double)ESTIMATESECONDS/tasks.size(); //seconds per task
+  CTimer timer; //for time spent on each task
+
+  std::cout << std::setprecision(3);
+
+  for(const std::string& strTask: tasks){ //for each task
+    std::istringstream s(strTask);
+    size_t index = 0; //task index
+    CSearchableBase* pSearch = ReadTask<N, D>(s, bNearsort2, index); //task to probe
+    CEstimate estimate; //estimate for this task
+    timer.Start();
+
+    for(size_t i=0; i<ESTIMATEPROBES && (i < 2 || timer.GetElapsedSeconds() < fBudget); i++)
+      pSearch->Probe(random, estimate);
+
+    delete pSearch;
+
+    std::cout << "Task " << index << ": " << estimate.GetNodes() << " nodes, " <<
+      estimate.GetCandidates() << " candidates, " <<
+      CTimer::Format(estimate.GetCPUSeconds()) << " CPU time" << std::endl;
+
+    fNodes += estimate.GetNodes();
+    fCandidates += estimate.GetCandidates();
+    fSeconds += estimate.GetCPUSeconds();
+    fVariance += estimate.GetVariance();
+    nProbes += estimate.GetNumProbes();
+  } //for
+
+  std::ostringstream s;
+  s << std::setprecision(3);
+  s << "Estimated " << fNodes << " nodes and " << fCandidates <<
+    " candidates in " << tasks.size() << " tasks taking " <<
+    CTimer::Format(fSeconds) << " CPU time (standard error " <<
+    CTimer::Format(std::sqrt(fVariance)) << ") from " << nProbes <<
+    " probes";
+
+  SaveSummary(s.str());
+} //Estimate
+
+/// \brief Estimator function.
+///
+/// Pointer to an instance of `Estimate()` for a given width and depth.
+
+typedef void (*EstimateFunction)(const bool, const size_t);
+
+/// \brief Get estimator function.
+///
+/// Look up the instance of `Estimate()` for a given width and depth.
+/// \param n Width.
+/// \param d Depth.
+/// \return Pointer to estimator function, or `nullptr` if there is none.
+
+EstimateFunction GetEstimateFunction(const size_t n, const size_t d){
+  EstimateFunction table[MAXINPUTS + 1][MAXDEPTH + 1] = {{nullptr}}; //dispatch table
+
+  #define DISPATCH_ESTIMATE(n, d) table[n][d] = Estimate<n, d>;
+  FOR_EACH_SHAPE(DISPATCH_ESTIMATE)
+
+  return n <= MAXINPUTS && d <= MAXDEPTH? table[n][d]: nullptr;
+} //GetEstimateFunction
+
+/// \brief Coordinator function.
+///
+/// Pointer to an instance of `Coordinate()` for a given width and depth.
+
+typedef void (*CoordinateFunction)(CCoordinator*, const bool, const size_t);
+
+/// \brief Get coordinator function.
+///
+/// Look up the instance of `Coordinate()` for a given width and depth.
+/// \param n Width.
+/// \param d Depth.
+/// \return Pointer to coordinator function, or `nullptr` if there is none.
+
+CoordinateFunction GetCoordinateFunction(const size_t n, const size_t d){
+  CoordinateFunction table[MAXINPUTS + 1][MAXDEPTH + 1] = {{nullptr}}; //dispatch table
+
+  #define DISPATCH_COORDINATE(n, d) table[n][d] = Coordinate<n, d>;
+  FOR_EACH_SHAPE(DISPATCH_COORDINATE)
+
+  return n <= MAXINPUTS && d <= MAXDEPTH? table[n][d]: nullptr;
+} //GetCoordinateFunction
+
+/// \brief Worker function.
+///
+/// Pointer to an instance of `Work()` for a given width and depth.
+
+typedef void (*WorkFunction)(CWorker*, const bool);
+
+/// \brief Get worker function.
+///
+/// Look up the instance of `Work()` for a given width and depth.
+/// \param n Width.
+/// \param d Depth.
+/// \return Pointer to worker function, or `nullptr` if there is none.
+
+WorkFunction GetWorkFunction(const size_t n, const size_t d){
+  WorkFunction table[MAXINPUTS + 1][MAXDEPTH + 1] = {{nullptr}}; //dispatch table
+
+  #define DISPATCH_WORK(n, d) table[n][d] = Work<n, d>;
+  FOR_EACH_SHAPE(DISPATCH_WORK)
+
+  return n <= MAXINPUTS && d <= MAXDEPTH? table[n][d]: nullptr;
+} //GetWorkFunction
+
+/// \brief Read shard from command line.
+///
+/// Read the shard of the search that this process is to perform from a
+/// command line argument of the form `i/k`, meaning shard \f$i\f$ of
+/// \f$k\f$, numbered from zero.
+/// \param strArg Command line argument.
+/// \param i [out] Shard number.
+/// \param k [out] Number of shards.
+/// \return true if the argument is well formed and in range.
+
+bool ReadShard(const std::string& strArg, size_t& i, size_t& k){
+  const size_t nSlash = strArg.find('/'); //position of slash
+
+  if(nSlash == std::string::npos)
+    return false;
+
+  try{
+    i = (size_t)std::stoul(strArg.substr(0, nSlash));
+    k = (size_t)std::stoul(strArg.substr(nSlash + 1));
+  } //try
+
+  catch(const std::exception&){
+    return false;
+  } //catch
+
+  return k >= 1 && i < k;
+} //ReadShard
+
+/// \brief Read port from command line.
+///
+/// Read a port number from a command line argument.
+/// \param strArg Command line argument.
+/// \param nPort [out] Port number.
+/// \return true if the argument is a port number from 1 to 65535.
+
+bool ReadPort(const std::string& strArg, size_t& nPort){
+  try{
+    nPort = (size_t)std::stoul(strArg);
+  } //try
+
+  catch(const std::exception&){
+    return false;
+  } //catch
+
+  return nPort >= 1 && nPort <= 65535;
+} //ReadPort
+
+/// \brief Read an option from command line.
+///
+/// Look for a command line argument that names an option followed by its
+/// value, and if they are there, remove them, so that options can be given
+/// anywhere on the command line along with the other arguments.
+/// \param args [in, out] Command line arguments.
+/// \param strOption Option, for example `--progress`.
+/// \param strValue [out] Value, left unchanged if the option is not there.
+/// \return false if the option is not followed by a value.
+
+bool ReadOption(std::vector<std::string>& args, const std::string& strOption,
+  std::string& strValue)
+{
+  for(size_t i=0; i<args.size(); i++)
+    if(args[i] == strOption){
+      if(i + 1 >= args.size())
+        return false;
+
+      strValue = args[i + 1];
+      args.erase(args.begin() + i, args.begin() + i + 2);
+      return true;
+    } //if
+
+  return true;
+} //ReadOption
+
+/// \brief Read number of seconds from command line.
+///
+/// Read a number of seconds from a command line argument.
+/// \param strArg Command line argument.
+/// \param nSeconds [out] Number of seconds.
+/// \return true if the argument is a number.
+
+bool ReadSeconds(const std::string& strArg, size_t& nSeconds){
+  try{
+    nSeconds = (size_t)std::stoul(strArg);
+  } //try
+
+  catch(const std::exception&){
+    return false;
+  } //catch
+
+  return true;
+} //ReadSeconds
+
+/// \brief Read number of threads from command line.
+///
+/// Read a number of threads from a command line argument.
+/// \param strArg Command line argument.
+/// \param nThreads [out] Number of threads.
+/// \return true if the argument is a number from 1 to `MAXTHREADS`.
+
+bool ReadThreads(const std::string& strArg, size_t& nThreads){
+  try{
+    nThreads = (size_t)std::stoul(strArg);
+  } //try
+
+  catch(const std::exception&){
+    return false;
+  } //catch
+
+  return nThreads >= 1 && nThreads <= MAXTHREADS;
+} //ReadThreads
+
+/// \brief Compare characters ignoring case.
+///
+/// \param a A character.
+/// \param b Another character.
+/// \return true if they are the same letter in either case, or the same character.
+
+bool EqualNoCase(const char a, const char b){
+  return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+} //EqualNoCase
+
+/// \brief Read kernel from command line.
+///
+/// Read the name of a bit-sliced sorting test kernel from a command line
+/// argument, as reported by `GetKernelName()` but in any case.
+/// \param strArg Command line argument.
+/// \param kernel [out] Kernel instruction set.
+/// \return true if the argument names a kernel that this CPU supports.
+
+bool ReadKernel(const std::string& strArg, eKernel& kernel){
+  const eKernel widest = DetectKernel(); //widest kernel supported
+
+  for(int i=(int)eKernel::Scalar; i<=(int)widest; i++){
+    const std::string strName = GetKernelName((eKernel)i); //name of kernel i
+
+    if(strName.size() == strArg.size() && std::equal(strName.begin(),
+      strName.end(), strArg.begin(), EqualNoCase))
+    {
+      kernel = (eKernel)i;
+      return true;
+    } //if
+  } //for
+
+  return false;
+} //ReadKernel
+
+/// \brief Merge shard results.
+///
+/// Load the shard results saved by processes that were each given a shard of
+/// the same search, check that they have the same settings and number of
+/// shards, that each shard is present exactly once, and that each task of
+/// the whole search was covered exactly once. If so, print and log the total
+/// number of sorting networks found, the longest elapsed time, and the total
+/// CPU time.
+/// \param files Names of the shard result files.
+/// \return 0 if the shards cover the search exactly once, 1 otherwise.
+
+int Merge(const std::vector<std::string>& files){
+  if(files.empty()){
+    std::cout << "No shard results to merge" << std::endl;
+    return 1;
+  } //if
+
+  std::vector<CShard> shards(files.size()); //shard results
+
+  for(size_t i=0; i<files.size(); i++)
+    if(!shards[i].Load(files[i])){
+      std::cout << "Cannot read " << files[i] << std::endl;
+      return 1;
+    } //if
+
+  const size_t k = shards[0].GetNumShards(); //number of shards
+  const size_t n = shards[0].GetNumTasks(); //number of tasks
+  std::vector<size_t> nShardSeen(k, 0); //number of times each shard is seen
+  std::vector<size_t> nTaskSeen(n, 0); //number of times each task is covered
+  size_t nCount = 0; //number of sorting networks found
+  double fElapsed = 0; //longest elapsed time
+  double fCPU = 0; //total CPU time
+  bool ok = true; //whether the shards cover the search exactly once
+
+  for(size_t i=0; i<shards.size(); i++){ //for each shard
+    const CShard& shard = shards[i];
+
+    if(shard.GetSettings() != shards[0].GetSettings() ||
+      shard.GetNumShards() != k || shard.GetNumTasks() != n)
+    {
+      std::cout << files[i] << " is from a different search than " <<
+        files[0] << std::endl;
+      return 1;
+    } //if
+
+    nShardSeen[shard.GetShard()]++;
+
+    for(const size_t j: shard.GetCovered())
+      if(j < n)
+        nTaskSeen[j]++;
+
+      else{
+        std::cout << files[i] << " covers task " << j << " of only " << n << std::endl;
+        ok = false;
+      } //else
+
+    nCount += shard.GetCount();
+    fElapsed = std::max(fElapsed, shard.GetElapsedSeconds());
+    fCPU += shard.GetCPUSeconds();
+  } //for
+
+  for(size_t i=0; i<k; i++)
+    if(nShardSeen[i] != 1){
+      std::cout << "Shard " << i << " of " << k << " appears " <<
+        nShardSeen[i] << " times" << std::endl;
+      ok = false;
+    } //if
+
+  size_t nMissing = 0; //number of tasks not covered
+  size_t nRepeated = 0; //number of tasks covered more than once
+
+  for(size_t i=0; i<n; i++)
+    if(nTaskSeen[i] == 0)
+      nMissing++;
+    else if(nTaskSeen[i] > 1)
+      nRepeated++;
+
+  if(nMissing > 0 || nRepeated > 0){
+    std::cout << nMissing << " tasks not covered and " << nRepeated <<
+      " tasks covered more than once" << std::endl;
+    ok = false;
+  } //if
+
+  if(!ok){
+    std::cout << "Shards do not cover the search exactly once" << std::endl;
+    return 1;
+  } //if
+
+  SaveSummary("Merged " + std::to_string(k) + " shards covering " +
+    std::to_string(n) + " tasks: " + std::to_string(nCount) + " found in " +
+    CTimer::Format(fElapsed) + " using " + CTimer::Format(fCPU) + " CPU time");
+
+  return 0;
+} //Merge
+
+/// \brief Run a worker.
+///
+/// Connect to a coordinator, get the settings from it, and perform tasks for
+/// it until it says that the search is done.
+/// \param strAddress Host name or address and port of the coordinator,
+/// separated by a colon.
+/// \return 0 if the worker ran, 1 if it could not.
+
+int RunWorker(const std::string& strAddress){
+  const size_t nColon = strAddress.rfind(':'); //position of colon
+
+  if(nColon == std::string::npos){
+    std::cout << "Coordinator address must be host:port" << std::endl;
+    return 1;
+  } //if
+
+  if(!CSocket::Startup()){
+    std::cout << "Cannot start sockets" << std::endl;
+    return 1;
+  } //if
+
+  CWorker* pWorker = new CWorker; //connection to coordinator
+  std::string strSettings; //settings line from coordinator
+  size_t nWidth = 0; //sorting network width (number of inputs)
+  size_t nDepth = 0; //sorting network depth (number of layers)
+  bool bNearsort2 = false; //use nearsort2 flag
+  eEngine engine = eEngine::GrayCode; //sorting test engine
+  bool bPrune = false; //prune repeated comparators flag
+  bool bReflect = false; //reduce second levels by reflection flag
+  bool bSymmetry = false; //skip symmetric third levels flag
+  size_t nSubsumeLevel = 0; //subsumption filter level
+  size_t nSplitLevel = 0; //task split level
+  size_t nRanges = 1; //number of tasks per prefix
+  WorkFunction pWork = nullptr; //worker function for this width and depth
+
+  if(!pWorker->Connect(strAddress.substr(0, nColon), strAddress.substr(nColon + 1)))
+    std::cout << "Cannot connect to " << strAddress << std::endl;
+
+  else if(!pWorker->GetSettings(strSettings))
+    std::cout << "No settings from " << strAddress << std::endl;
+
+  else{
+    std::istringstream s(strSettings);
+
+    if(ReadParams(s, nWidth, nDepth, bNearsort2, engine, bPrune, bReflect,
+      bSymmetry, nSubsumeLevel, nSplitLevel, nRanges))
+      pWork = GetWorkFunction(nWidth, nDepth);
+
+    if(!pWork)
+      std::cout << "Bad settings from " << strAddress << std::endl;
+  } //else
+
+  if(pWork){ //ready to work
+    CSettings::SetWidth(nWidth); //distribute width to all classes
+    CSettings::SetDepth(nDepth); //distribute depth to all classes
+    CSettings::SetEngine(engine); //distribute engine to all classes
+    CSettings::SetPrune(bPrune); //distribute pruning flag to all classes
+    CSettings::SetReflect(bReflect); //distribute reflection flag to all classes
+    CSettings::SetSymmetry(bSymmetry); //distribute symmetry flag to all classes
+    CSettings::SetSubsumeLevel(nSubsumeLevel); //distribute subsumption filter level to all classes
+    CSettings::SetSplitLevel(nSplitLevel); //distribute split level to all classes
+
+    std::cout << "Working on " << nWidth << "-input sorting networks of depth " <<
+      nDepth << " for " << strAddress << std::endl;
+
+    pWork(pWorker, bNearsort2); //this is where the work happens
+
+    std::cout << pWorker->GetCount() << " found in " << pWorker->GetNumTasks() <<
+      " tasks" << std::endl;
+  } //if
+
+  pWorker->Disconnect();
+  delete pWorker;
+  CSocket::Cleanup();
+
+  return pWork? 0: 1;
+} //RunWorker
+
+/// \brief Run a coordinator.
+///
+/// Listen for workers on a port, make the tasks, issue them to workers until
+/// they have all been completed, and report the results.
+/// \param nPort Port number.
+/// \param n Width.
+/// \param d Depth.
+/// \param bNearsort2 true to use nearsort2 heuristic (if appropriate).
+/// \param r Number of tasks per prefix.
+/// \param strSettings Settings line.
+/// \return 0 if the coordinator ran, 1 if it could not.
+
+int RunCoordinator(const unsigned short nPort, const size_t n, const size_t d,
+  const bool bNearsort2, const size_t r, const std::string& strSettings)
+{
+  if(!CSocket::Startup()){
+    std::cout << "Cannot start sockets" << std::endl;
+    return 1;
+  } //if
+
+  CCoordinator* pCoordinator = new CCoordinator(strSettings, n, d); //coordinator
+  const bool ok = pCoordinator->Listen(nPort); //whether listening
+
+  if(ok){
+    CTimer timer; //timer for elapsed time
+    GetCoordinateFunction(n, d)(pCoordinator, bNearsort2, r); //this is where the search happens
+
+    std::cout << "Finish " << timer.GetTimeAndDate() << std::endl;
+
+    SaveSummary(std::to_string(pCoordinator->GetCount()) + " found in " +
+      timer.GetElapsedTime() + " using " +
+      CTimer::Format(pCoordinator->GetCPUSeconds()) + " CPU time over " +
+      std::to_string(pCoordinator->GetNumWorkers()) + " workers");
+
+    if(pCoordinator->GetNumReissued())
+      SaveSummary(std::to_string(pCoordinator->GetNumReissued()) +
+        " tasks issued again after their workers were dropped");
+  } //if
+
+  else std::cout << "Cannot listen on port " << nPort << std::endl;
+
+  delete pCoordinator;
+  CSocket::Cleanup();
+
+  return ok? 0: 1;
+} //RunCoordinator
+
 /// \brief Main.
 /// 
-/// Get the sorting network width and depth from the user.
-/// Conduct the search and process the results. 
+/// With `--merge` followed by file names, merge shard results. With
+/// `--worker host:port`, work for the coordinator at that address. Otherwise get
+/// the sorting network width and depth from the user, or if there is a
+/// checkpoint file and the user wants to resume from it, from the checkpoint.
+/// Conduct the search and process the results. While searching, save a
+/// checkpoint periodically and on `SIGINT` or `SIGTERM`. Afterwards, save a
+/// trace of the tasks and list the slowest ones and the idle time of each
+/// thread. With `--shard i/k`,
+/// perform only shard \f$i\f$ of \f$k\f$ of the search and save its result
+/// for merging. With `--coordinate port`, instead of searching, issue the
+/// tasks to workers that connect to that port. With `--estimate`, instead
+/// of searching, estimate the size of the search tree and the CPU time that
+/// the search would take. With `--progress` followed by a number of seconds,
+/// report progress that often instead of every `PROGRESSINTERVAL` seconds,
+/// or never if it is 0. With `--metrics port`, serve metrics on that port of
+/// the loopback interface while searching. With `--kernel name`, use that
+/// bit-sliced sorting test kernel instead of the widest one the CPU supports.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
 /// \return 0 (What could possibly go wrong?)
 
-int main(){
+int main(int argc, char* argv[]){
+  std::vector<std::string> args(argv + 1, argv + argc); //command line arguments
+  std::string strProgress = std::to_string(PROGRESSINTERVAL); //number of seconds between progress reports
+  std::string strMetrics; //port to serve metrics on, empty for none
+  std::string strThreads; //number of threads, empty for one per hardware thread
+  std::string strKernel; //bit-sliced sorting test kernel, empty for the widest
+  size_t nProgress = 0; //number of seconds between progress reports
+  size_t nMetricsPort = 0; //port to serve metrics on, 0 for none
+  size_t nThreads = 0; //number of threads, 0 for one per hardware thread
+  eKernel kernel = DetectKernel(); //bit-sliced sorting test kernel
+
+  const bool bOptions = ReadOption(args, "--progress", strProgress) &&
+    ReadOption(args, "--metrics", strMetrics) &&
+    ReadOption(args, "--threads", strThreads) &&
+    ReadOption(args, "--kernel", strKernel) &&
+    ReadSeconds(strProgress, nProgress) &&
+    (strMetrics.empty() || ReadPort(strMetrics, nMetricsPort)) &&
+    (strThreads.empty() || ReadThreads(strThreads, nThreads)) &&
+    (strKernel.empty() || ReadKernel(strKernel, kernel)); //whether options are well formed
+
+  CSettings::SetKernel(kernel); //distribute kernel to all classes
+
+  if(!args.empty() && args[0] == "--merge")
+    return Merge(std::vector<std::string>(args.begin() + 1, args.end()));
+
+  if(args.size() == 2 && args[0] == "--worker")
+    return RunWorker(args[1]);
+
+  size_t nShard = 0; //shard number
+  size_t nNumShards = 1; //number of shards
+  const bool bShard = args.size() == 2 && args[0] == "--shard" &&
+    ReadShard(args[1], nShard, nNumShards); //whether to perform only one shard
+
+  size_t nPort = 0; //port to listen for workers on
+  const bool bCoordinate = args.size() == 2 && args[0] == "--coordinate" &&
+    ReadPort(args[1], nPort); //whether to coordinate workers
+
+  const bool bEstimate = args.size() == 1 && args[0] == "--estimate"; //whether to estimate instead of search
+
+  if(!bOptions || (!args.empty() && !bShard && !bCoordinate && !bEstimate)){
+    std::cout << "Usage: search [--progress seconds] [--metrics port] " <<
+      "[--threads n] [--kernel name] [--shard i/k | " <<
+      "--merge file... | --coordinate port | --worker host:port | --estimate]" <<
+      std::endl;
+    return 1;
+  } //if
+
+  const std::string strCheckpoint = bCoordinate || bEstimate? "":
+    bShard?
+    "checkpoint-" + std::to_string(nShard) + "-of-" +
+      std::to_string(nNumShards) + ".txt":
+    "checkpoint.txt"; //checkpoint file name
+  std::ifstream checkpoint; //checkpoint file, if any
+  bool bResume = false; //resume from checkpoint flag
+
+  if(!strCheckpoint.empty())
+    checkpoint.open(strCheckpoint);
+
+  if(checkpoint.is_open())
+    ReadParams(bResume, strCheckpoint); //read from stdin
+
   size_t nWidth = 0; //sorting network width (number of inputs)
   size_t nDepth = 0; //sorting network depth (number of layers)
-  ReadParams(nWidth, nDepth); //read from stdin
+  bool bFastGrayCode = false; //use fast Gray code flag
+  bool bNearsort2 = false; //use nearsort2 flag
+  eEngine engine = eEngine::GrayCode; //sorting test engine
+  bool bPrune = false; //prune repeated comparators flag
+  bool bReflect = false; //reduce second levels by reflection flag
+  bool bSymmetry = false; //skip symmetric third levels flag
+  size_t nSubsumeLevel = 0; //subsumption filter level
+  size_t nSplitLevel = 0; //task split level
+  size_t nRanges = 1; //number of tasks per prefix
+
+  if(bResume){ //read from checkpoint file
+    if(!ReadParams(checkpoint, nWidth, nDepth, bNearsort2, engine, bPrune,
+      bReflect, bSymmetry, nSubsumeLevel, nSplitLevel, nRanges))
+    {
+      std::cout << "Cannot read " << strCheckpoint << std::endl;
+      return 1;
+    } //if
+  } //if
+
+  else{ //read from stdin
+    ReadParams(nWidth, nDepth);
+    ReadParams(bNearsort2, nDepth);
+    ReadParams(engine);
+    ReadParams(bPrune, bReflect, bSymmetry);
+    ReadParams(nSubsumeLevel, nDepth, bNearsort2 && nDepth >= 5);
+    ReadParams(nSplitLevel, nRanges, nSubsumeLevel, nWidth, nDepth,
+      bNearsort2 && nDepth >= 5);
+  } //else
+
   CSettings::SetWidth(nWidth); //distribute width to all classes
   CSettings::SetDepth(nDepth); //distribute depth to all classes
+  CSettings::SetEngine(engine); //distribute engine to all classes
+  CSettings::SetPrune(bPrune); //distribute pruning flag to all classes
+  CSettings::SetReflect(bReflect); //distribute reflection flag to all classes
+  CSettings::SetSymmetry(bSymmetry); //distribute symmetry flag to all classes
+  CSettings::SetSubsumeLevel(nSubsumeLevel); //distribute subsumption filter level to all classes
+  CSettings::SetSplitLevel(nSplitLevel); //distribute split level to all classes
 
-  bool bFastGrayCode = false; //use fast Gray code flag
-  bool bNearsort2 = false; //use nearsort2 flag
-  ReadParams(bNearsort2, nDepth); //read from stdin
+  const SearchFunction pSearch = GetSearchFunction(nWidth, nDepth); //search for this width and depth
+
+  if(!pSearch){ //only possible with a bad checkpoint file
+    std::cout << "Cannot search for " << nWidth << "-input sorting networks of depth " <<
+      nDepth << std::endl;
+    return 1;
+  } //if
 
   CTimer* pTimer = new CTimer; //timer for elapsed and CPU time
   
@@ -223,34 +1657,169 @@ int main(){
 
   std::cout << "Start " << pTimer->GetTimeAndDate() << std::endl;
 
-  std::string strSummary = "Searching for " +
+  std::string strSummary = std::string(bEstimate? "Estimating": "Searching") + " for " +
     std::to_string(nWidth) + "-input sorting networks of depth " +
     std::to_string(nDepth);
 
+  if(engine == eEngine::BitSlice)
+    strSummary += " using bit-sliced sorting test with " +
+      std::string(GetKernelName(kernel)) + " kernel";
+
+  else if(engine == eEngine::Table)
+    strSummary += " using level transfer tables";
+
+  if(bPrune)
+    strSummary += " pruning repeated comparators";
+
+  if(bReflect)
+    strSummary += " reducing second levels by reflection";
+
+  if(bSymmetry)
+    strSummary += " skipping symmetric third levels";
+
+  if(nSubsumeLevel)
+    strSummary += " filtering prefixes by subsumption to level " +
+      std::to_string(nSubsumeLevel);
+
+  if(nSplitLevel)
+    strSummary += " splitting tasks at level " + std::to_string(nSplitLevel + 1) +
+      " into " + std::to_string(nRanges) + " per prefix";
+
+  if(bShard)
+    strSummary += " shard " + std::to_string(nShard) + " of " +
+      std::to_string(nNumShards);
+
+  if(bResume)
+    strSummary += " resuming from checkpoint";
+
+  if(bCoordinate)
+    strSummary += " coordinating workers on port " + std::to_string(nPort);
+
   SaveSummary(strSummary);
 
+  const std::string strSettings = CheckpointHeader(nWidth, nDepth, bNearsort2,
+    engine, bPrune, bReflect, bSymmetry, nSubsumeLevel, nSplitLevel,
+    nRanges); //settings line
+
+  if(bEstimate){ //estimate instead of search
+    GetEstimateFunction(nWidth, nDepth)(bNearsort2, nRanges);
+    SaveSummary("Estimate took " + pTimer->GetElapsedTime());
+    delete pTimer;
+    return 0;
+  } //if
+
+  if(bCoordinate){ //distributed search
+    delete pTimer;
+    return RunCoordinator((unsigned short)nPort, nWidth, nDepth, bNearsort2,
+      nRanges, strSettings);
+  } //if
+
   //multithreaded search
   
-  CThreadManager* pThreadManager = new CThreadManager; //thread manager
+  CThreadManager* pThreadManager = new CThreadManager(nThreads); //thread manager
 
-  pTimer->Start(); //start timing CPU and elapsed time
-  Search(pThreadManager, nDepth, bNearsort2); //this is where the search happens
+  pThreadManager->SetShard(nShard, nNumShards);
+  pThreadManager->SetCheckpoint(strCheckpoint, strSettings);
+  pThreadManager->SetProgress(nProgress, bShard?
+    "status-" + std::to_string(nShard) + "-of-" + std::to_string(nNumShards) +
+      ".json":
+    "status.json");
 
-  //print results to console and log file
+  CTelemetry* pTelemetry = nMetricsPort > 0? new CTelemetry: nullptr; //metrics endpoint, if any
+  const bool bSockets = pTelemetry && CSocket::Startup(); //whether sockets were started
+  bool ok = false; //whether the search was done
 
-  std::cout << "Finish " << pTimer->GetTimeAndDate() << std::endl;
+  if(pTelemetry && !(bSockets && pTelemetry->Listen((unsigned short)nMetricsPort)))
+    std::cout << "Cannot listen on port " << nMetricsPort << std::endl;
 
-  strSummary = std::to_string(pThreadManager->GetCount()) + " found in " +
-    pTimer->GetElapsedTime() + " using " +
-    pTimer->GetCPUTime() + " CPU time over " +
-    std::to_string(pThreadManager->GetNumThreads()) + " threads";
+  else if(bResume && !pThreadManager->Resume(checkpoint)) //totals from checkpoint
+    std::cout << "Cannot read " << strCheckpoint << std::endl;
 
-  SaveSummary(strSummary);
+  else{ //ready to search
+    if(pTelemetry){ //serve metrics
+      pThreadManager->SetTelemetry(pTelemetry);
+      std::cout << "Serving metrics on http://127.0.0.1:" << nMetricsPort <<
+        "/metrics" << std::endl;
+    } //if
+
+    std::signal(SIGINT, CThreadManager::Interrupt); //checkpoint and exit on Ctrl+C
+    std::signal(SIGTERM, CThreadManager::Interrupt); //and when terminated
+
+    pTimer->Start(); //start timing CPU and elapsed time
+    ok = pSearch(pThreadManager, bNearsort2, nRanges,
+      bResume? &checkpoint: nullptr); //this is where the search happens
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+
+    if(!ok) //tasks do not fit the settings
+      std::cout << "Tasks in " << strCheckpoint <<
+        " do not match its settings" << std::endl;
+  } //else
+
+  checkpoint.close();
+
+  if(ok){ //search done
+    //print results to console and log file
+
+    std::cout << "Finish " << pTimer->GetTimeAndDate() << std::endl;
+
+    strSummary = std::to_string(pThreadManager->GetCount()) + " found in " +
+      pTimer->GetElapsedTime() + " using " +
+      pTimer->GetCPUTime() + " CPU time over " +
+      std::to_string(pThreadManager->GetNumThreads()) + " threads";
+
+    SaveSummary(strSummary);
+
+    if(pThreadManager->GetNumDonations())
+      SaveSummary(std::to_string(pThreadManager->GetNumDonations()) +
+        " tasks donated to idle threads");
+
+    if(engine == eEngine::GrayCode)
+      SaveSummary(WitnessSummary(pThreadManager->GetWitnessStats()));
+
+    if(bPrune)
+      SaveSummary(PruneSummary(pThreadManager->GetPruneStats(), nDepth));
+
+    const std::string strReport = bShard?
+      "report-" + std::to_string(nShard) + "-of-" + std::to_string(nNumShards) +
+        ".json":
+      "report.json"; //run report file name
+
+    if(!SaveReport(strReport, strSettings, nDepth, bResume, pThreadManager, *pTimer))
+      std::cout << "Cannot write " << strReport << std::endl;
+
+    const std::string strTrace = bShard?
+      "trace-" + std::to_string(nShard) + "-of-" + std::to_string(nNumShards) +
+        ".json":
+      "trace.json"; //task trace file name
+
+    if(!pThreadManager->GetTrace().Save(strTrace))
+      std::cout << "Cannot write " << strTrace << std::endl;
+
+    pThreadManager->GetTrace().Summarize(std::cout, TRACESLOWEST);
+
+    if(bShard){ //save shard result for merging
+      const std::string strFile = CShard::GetFileName(nShard, nNumShards); //shard result file name
+      const CShard shard(nShard, nNumShards, strSettings,
+        pThreadManager->GetNumTasks(), pThreadManager->GetCovered(),
+        pThreadManager->GetCount(), pTimer->GetElapsedSeconds(),
+        pTimer->GetCPUSeconds());
+
+      if(shard.Save(strFile))
+        std::cout << "Shard result saved to " << strFile << std::endl;
+      else std::cout << "Cannot write " << strFile << std::endl;
+    } //if
+  } //if
 
   //clean up and exit
   
   delete pThreadManager;
   delete pTimer;
+  delete pTelemetry;
 
-  return 0;
+  if(bSockets)
+    CSocket::Cleanup();
+
+  return ok? 0: 1;
 } //main
@@ -29,15 +29,15 @@
 
 /// Initialize the matching to the identity matching.
 
-CMatching::CMatching(){
+template<size_t N> CMatching<N>::CMatching(){
   Initialize();
 } //constructor 
 
 /// The copy constructor.
 /// \param m Matching to copy.
 
-CMatching::CMatching(const CMatching& m){ //copy constructor
-  for(size_t i=0; i<m_nWidth+1; i++){
+template<size_t N> CMatching<N>::CMatching(const CMatching& m){ //copy constructor
+  for(size_t i=0; i<N+1; i++){
     m_nMatching[i] = m.m_nMatching[i];
     m_nMap[i] = m.m_nMap[i];
 
@@ -47,35 +47,35 @@ CMatching::CMatching(const CMatching& m){ //copy constructor
 
 /// Initialize to the identity matching.
 
-void CMatching::Initialize(){
-  for(size_t i=0; i<evenceil(m_nWidth); i++){
-    m_nMatching[i] = i;
-    m_nMap[i] = i;
+template<size_t N> void CMatching<N>::Initialize(){
+  for(size_t i=0; i<evenceil(N); i++){
+    m_nMatching[i] = (uint8_t)i;
+    m_nMap[i] = (uint8_t)i;
 
-    m_nStack[i] = (int)i - 1;
+    m_nStack[i] = (int8_t)((int)i - 1);
   } //for
 } //Initialize
 
 /// Get the next matching. Uses the stack to avoid recursing.
 /// \return true if there was a next matching 
 
-bool CMatching::Next(){
+template<size_t N> bool CMatching<N>::Next(){
   size_t s = 4;
   size_t i = m_nStack[s - 1];
 
-  while(i < 1 && s < oddfloor(m_nWidth)){
-    size_t temp = m_nMatching[s - 2];
+  while(i < 1 && s < oddfloor(N)){
+    const uint8_t temp = m_nMatching[s - 2];
 
     for(size_t j=s-1; j>=2; j--){
       m_nMatching[j - 1] = m_nMatching[j - 2];
-      m_nMap[m_nMatching[j - 1]] = j - 1;
+      m_nMap[m_nMatching[j - 1]] = (uint8_t)(j - 1);
     } //for
 
     m_nMatching[0] = temp;
     m_nMap[temp] = 0;
 
     for(size_t j=0; j<s; j++)
-      m_nStack[j] = (int)j - 1;
+      m_nStack[j] = (int8_t)((int)j - 1);
 
     s += 2;
     i = m_nStack[s - 1];
@@ -83,9 +83,9 @@ bool CMatching::Next(){
 
   if(i > 0){
     std::swap(m_nMatching[i - 1], m_nMatching[s - 2]);
-    m_nMap[m_nMatching[i - 1]] = i - 1;
-    m_nMap[m_nMatching[s - 2]] = s - 2;
-    m_nStack[s - 1] = (int)i - 1;
+    m_nMap[m_nMatching[i - 1]] = (uint8_t)(i - 1);
+    m_nMap[m_nMatching[s - 2]] = (uint8_t)(s - 2);
+    m_nStack[s - 1] = (int8_t)((int)i - 1);
   } //if
 
   return m_nStack[i] >= 0;
@@ -96,7 +96,7 @@ bool CMatching::Next(){
 /// \param i The first index.
 /// \param j The second index.
 
-void CMatching::SwapPair(int m[], size_t i, size_t j){
+template<size_t N> void CMatching<N>::SwapPair(int m[], size_t i, size_t j){
   const size_t i0 = 2*i;
   const size_t i1 = i0 + 1;
   const size_t j0 = 2*j;
@@ -105,7 +105,7 @@ void CMatching::SwapPair(int m[], size_t i, size_t j){
   std::swap(m[i0], m[j0]);
   std::swap(m[i1], m[j1]);
 
-  for(size_t k=0; k<m_nWidth; k++)
+  for(size_t k=0; k<N; k++)
     if(m[k] == i0)           m[k] = (int)j0;
     else if(m[k] == (int)j0) m[k] = (int)i0;
     else if(m[k] == (int)i1) m[k] = (int)j1;
@@ -114,10 +114,10 @@ void CMatching::SwapPair(int m[], size_t i, size_t j){
 
 /// Normalize the matching.
 
-void CMatching::Normalize(){ 
-  const size_t n = evenceil(m_nWidth);
+template<size_t N> void CMatching<N>::Normalize(){ 
+  const size_t n = evenceil(N);
   
-  int nCopy[MAXINPUTS + 1] = {0}; ///< Integer copy of matching.
+  int nCopy[N + 1] = {0}; ///< Integer copy of matching.
   
   for(size_t j=0; j<n; j++)
     nCopy[j] = (int)m_nMatching[m_nMap[j]^1];
@@ -135,8 +135,8 @@ void CMatching::Normalize(){
 
   for(size_t k=0; k<n; k++)
     if(nCopy[k] >= 0){
-      m_nMatching[top++] = k;
-      m_nMatching[top++] = nCopy[k];
+      m_nMatching[top++] = (uint8_t)k;
+      m_nMatching[top++] = (uint8_t)nCopy[k];
       nCopy[nCopy[k]] = -1;
     } //if
 } //Normalize
@@ -145,44 +145,61 @@ void CMatching::Normalize(){
 /// \param i Index of first pair.
 /// \param j Index of second pair.
 
-void CMatching::Swap(const size_t i, const size_t j){
+template<size_t N> void CMatching<N>::Swap(const size_t i, const size_t j){
   const size_t i0 = m_nMap[2*i];
   const size_t j0 = m_nMap[2*j]; 
 
-  m_nMatching[i0] = 2*j;
-  m_nMatching[j0] = 2*i;
+  m_nMatching[i0] = (uint8_t)(2*j);
+  m_nMatching[j0] = (uint8_t)(2*i);
 
-  m_nMap[m_nMatching[i0]] = i0;
-  m_nMap[m_nMatching[j0]] = j0;
+  m_nMap[m_nMatching[i0]] = (uint8_t)i0;
+  m_nMap[m_nMatching[j0]] = (uint8_t)j0;
 
   const size_t i1 = m_nMap[2*i + 1];
   const size_t j1 = m_nMap[2*j + 1];
 
-  m_nMatching[i1] = 2*j + 1;
-  m_nMatching[j1] = 2*i + 1;
+  m_nMatching[i1] = (uint8_t)(2*j + 1);
+  m_nMatching[j1] = (uint8_t)(2*i + 1);
 
-  m_nMap[m_nMatching[i1]] = i1;
-  m_nMap[m_nMatching[j1]] = j1;
+  m_nMap[m_nMatching[i1]] = (uint8_t)i1;
+  m_nMap[m_nMatching[j1]] = (uint8_t)j1;
 } //swap
 
+/// Reflect the matching, that is, reverse the order of the channels that are
+/// paired up in the first level of a first normal form comparator network,
+/// leaving any unpaired last channel and the dummy channel where they are.
+/// Reversing the channels and exchanging min and max maps a sorting network
+/// to a sorting network, and this maps its first level to itself.
+
+template<size_t N> void CMatching<N>::Reflect(){
+  const size_t m = evenfloor(N); //number of channels paired in the first level
+
+  for(size_t i=0; i<evenceil(N); i++){
+    if(m_nMatching[i] < m)
+      m_nMatching[i] = (uint8_t)(m - 1 - m_nMatching[i]);
+
+    m_nMap[m_nMatching[i]] = (uint8_t)i;
+  } //for
+} //Reflect
+
 /// Type cast to a string consisting of space-separated values
 /// from `m_nMatching`.
 /// \return String describing this matching.
 
-CMatching::operator std::string() const{
+template<size_t N> CMatching<N>::operator std::string() const{
   std::string str; //result string
 
-  for(size_t i=0; i<m_nWidth-1; i++) //for all but last entry
+  for(size_t i=0; i<N-1; i++) //for all but last entry
     str += std::to_string(m_nMatching[i]) + " "; //append space separated
 
-  return str + std::to_string(m_nMatching[m_nWidth - 1]); //append last entry
+  return str + std::to_string(m_nMatching[N - 1]); //append last entry
 } //std::string
 
 /// Index operator, used to access members of `m_nMatching` as an L-value.
 /// \param i Index.
 /// \return Reference to the indexed element of the matching.
 
-size_t& CMatching::operator[](const size_t i){ 
+template<size_t N> uint8_t& CMatching<N>::operator[](const size_t i){ 
   return m_nMatching[i];
 } //operator[]
 
@@ -190,6 +207,11 @@ size_t& CMatching::operator[](const size_t i){
 /// \param i Index.
 /// \return The indexed element of the matching.
 
-const size_t CMatching::operator[](const size_t i) const{ 
+template<size_t N> const size_t CMatching<N>::operator[](const size_t i) const{ 
   return m_nMatching[i];
 } //operator[]
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CMatching<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
@@ -27,6 +27,7 @@
 #define __Matching_h__
 
 #include <string>
+#include <cstdint>
 
 #include "Defines.h"
 #include "Settings.h"
@@ -34,13 +35,16 @@
 /// \brief Perfect matching.
 ///
 /// `CMatching` represents a perfect matching... well, as
-/// perfect as it can be if its size is odd.
+/// perfect as it can be if its size is odd. Channel numbers are stored in
+/// single bytes so that a matching fits in a fraction of a cache line.
+///
+/// \tparam N Number of channels.
 
-class CMatching: public CSettings{
+template<size_t N> class CMatching: public CSettings{
   private:   
-    size_t m_nMatching[MAXINPUTS + 1] = {0}; ///< Matching.
-    size_t m_nMap[MAXINPUTS + 1] = {0}; ///< Matching index map.
-    int m_nStack[MAXINPUTS + 1] = {0}; ///< Stack to remove recursion from permutation.
+    uint8_t m_nMatching[N + 1] = {0}; ///< Matching.
+    uint8_t m_nMap[N + 1] = {0}; ///< Matching index map.
+    int8_t m_nStack[N + 1] = {0}; ///< Stack to remove recursion from permutation.
     
     void SwapPair(int[], size_t, size_t); ///< Swap pair.
 
@@ -52,10 +56,11 @@ class CMatching: public CSettings{
     bool Next(); ///< Advance to next matching.
 
     void Swap(const size_t, const size_t); ///< Swap.
+    void Reflect(); ///< Reflect.
 
     void Normalize(); ///< Normalize.
     
-    size_t& operator[](const size_t); ///< Overloaded index operator.
+    uint8_t& operator[](const size_t); ///< Overloaded index operator.
     const size_t operator[](const size_t) const; ///< Overloaded index operator.
     operator std::string() const; ///< Cast to a string.
 }; //CMatching
@@ -0,0 +1,148 @@
+/// \file MatchingTable.cpp
+/// \brief Code for the table of all matchings `CMatchingTable`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "MatchingTable.h"
+
+template<size_t N>
+uint8_t CMatchingTable<N>::m_nMatching[NumMatchings(N)][MATCHINGSTRIDE] = {{0}};
+template<size_t N>
+uint8_t CMatchingTable<N>::m_nComparator[NumMatchings(N)][MATCHINGSTRIDE] = {{0}};
+template<size_t N>
+std::vector<uint16_t> CMatchingTable<N>::m_stlTransfer;
+
+/// Generate all matchings in the order in which `CMatching::Next()` does,
+/// and store both representations of each. This must be called before any
+/// searchable sorting network is used, and before any threads are spawned.
+
+template<size_t N> void CMatchingTable<N>::Initialize(){
+  CMatching<N> matching; //current matching
+  size_t i = 0; //index of current matching
+
+  do{ //for each matching
+    for(size_t j=0; j<evenceil(N); j++) //generatable representation
+      m_nMatching[i][j] = matching[j];
+
+    GetComparators(matching, m_nComparator[i++]); //testable representation
+  }while(matching.Next() && i < NumMatchings(N));
+} //Initialize
+
+/// Convert a matching to the testable representation, in which the entry for
+/// each channel is the channel at the other end of its comparator, or itself
+/// if there is none.
+/// \param matching A matching.
+/// \param comparator [out] Testable representation of the matching.
+
+template<size_t N>
+void CMatchingTable<N>::GetComparators(CMatching<N>& matching, uint8_t comparator[]){
+  for(size_t j=0; j<N; j+=2){ //for each pair of channels
+    const uint8_t x = matching[j]; //channel at left end of comparator
+    const uint8_t y = matching[j + 1]; //channel at the other end
+
+    if(y == N) //if the rightmost channel is the last one in a comparator network with an odd number of inputs
+      comparator[x] = x; //it's empty
+
+    else{ //make the testable representation
+      comparator[x] = y; //x goes to y
+      comparator[y] = x; //y goes to x
+    } //else
+  } //for
+} //GetComparators
+
+/// Build the level transfer table of every matching, unless they would take
+/// more than `MAXTRANSFERBYTES` or have been built already. This must be
+/// called after `CMatchingTable::Initialize()`, and before any threads are
+/// spawned.
+
+template<size_t N> void CMatchingTable<N>::InitializeTransfer(){
+  const size_t nSize = (size_t)1 << N; //number of entries per table
+
+  if(!m_stlTransfer.empty() ||
+    NumMatchings(N)*nSize*sizeof(uint16_t) > MAXTRANSFERBYTES)
+    return; //built already, or too large
+
+  m_stlTransfer.resize(NumMatchings(N)*nSize);
+
+  for(size_t i=0; i<NumMatchings(N); i++) //for each matching
+    BuildTransfer(m_nComparator[i], &m_stlTransfer[i*nSize]);
+} //InitializeTransfer
+
+/// Build the transfer table of a level of comparators, that is, the output
+/// of the level for every possible input word, with bit `j` of the word
+/// holding the value on channel `j`.
+/// \param comparator Testable representation of the level.
+/// \param table [out] Transfer table with \f$2^n\f$ entries.
+
+template<size_t N>
+void CMatchingTable<N>::BuildTransfer(const uint8_t comparator[], uint16_t table[]){
+  uint16_t nPair[N/2]; //bit masks of the two channels of each comparator
+  uint16_t nMin[N/2]; //bit mask of the channel that gets the minimum
+  size_t nCount = 0; //number of comparators
+
+  for(size_t j=0; j<N; j++) //for each channel
+    if(comparator[j] > j){ //top end of a comparator
+      nMin[nCount] = (uint16_t)(1 << j);
+      nPair[nCount++] = (uint16_t)((1 << j) | (1 << comparator[j]));
+    } //if
+
+  for(size_t x=0; x<((size_t)1 << N); x++){ //for each input word
+    uint16_t y = (uint16_t)x; //output word
+
+    for(size_t c=0; c<nCount; c++) //swap if one on top and zero on bottom
+      if((y & nPair[c]) == nMin[c])
+        y ^= nPair[c];
+
+    table[x] = y;
+  } //for
+} //BuildTransfer
+
+/// Reader function for the generatable representation of a matching.
+/// \param i Index of a matching in the order in which they are generated.
+/// \return Pointer to the matching as pairs of channels.
+
+template<size_t N> const uint8_t* CMatchingTable<N>::GetMatching(const size_t i){
+  return m_nMatching[i];
+} //GetMatching
+
+/// Reader function for the testable representation of a matching.
+/// \param i Index of a matching in the order in which they are generated.
+/// \return Pointer to the matching as an array of comparator ends.
+
+template<size_t N> const uint8_t* CMatchingTable<N>::GetComparators(const size_t i){
+  return m_nComparator[i];
+} //GetComparators
+
+/// Reader function for the level transfer table of a matching.
+/// \param i Index of a matching in the order in which they are generated.
+/// \return Pointer to its transfer table with \f$2^n\f$ entries, or
+/// `nullptr` if the tables have not been built.
+
+template<size_t N> const uint16_t* CMatchingTable<N>::GetTransfer(const size_t i){
+  return m_stlTransfer.empty()? nullptr: &m_stlTransfer[i << N];
+} //GetTransfer
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CMatchingTable<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
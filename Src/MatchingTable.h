@@ -0,0 +1,92 @@
+/// \file MatchingTable.h
+/// \brief Interface for the table of all matchings `CMatchingTable`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __MatchingTable_h__
+#define __MatchingTable_h__
+
+#include <cstdint>
+#include <vector>
+
+#include "Defines.h"
+#include "Settings.h"
+#include "Matching.h"
+
+#define MATCHINGSTRIDE 16 ///< Bytes per matching in `CMatchingTable`, a divisor of the cache line size.
+
+static_assert(MAXINPUTS < MATCHINGSTRIDE, "A matching must fit into MATCHINGSTRIDE bytes");
+
+/// \brief Number of matchings.
+///
+/// Number of matchings on \f$n\f$ channels, counting the dummy channel
+/// when \f$n\f$ is odd, that is,
+/// \f[
+/// \prod_{i=1}^{\lfloor (n-1)/2\rfloor} (2i + 1).
+/// \f]
+/// \param n Number of channels.
+/// \return Number of matchings on n channels.
+
+constexpr size_t NumMatchings(const size_t n){
+  return n > 2? oddfloor(n)*NumMatchings(n - 2): 1;
+} //NumMatchings
+
+/// \brief Table of all matchings.
+///
+/// Every level below the second of every candidate in every thread runs
+/// through the same matchings in the same order, namely the order in which
+/// `CMatching::Next()` generates them. `CMatchingTable::Initialize()`
+/// therefore generates them once, and stores both the generatable
+/// representation from `CMatching` and the testable representation used by
+/// `CComparatorNetwork` in a read-only table shared by all threads.
+/// Each matching occupies `MATCHINGSTRIDE` bytes, so that none of them straddles
+/// a cache line. Advancing a level of `CSearchable` to its next matching then
+/// amounts to incrementing an index and copying the testable representation.
+///
+/// For the level transfer table sorting test (see `CLevelTable`),
+/// `CMatchingTable::InitializeTransfer()` also builds the transfer table of
+/// every matching once, so that a level that changes to another matching
+/// needs no table built, unless they would take more than `MAXTRANSFERBYTES`,
+/// as for 12 inputs, in which case `CMatchingTable::GetTransfer()` returns
+/// `nullptr` and each task builds its own.
+///
+/// \tparam N Number of channels.
+
+template<size_t N> class CMatchingTable: public CSettings{
+  private:
+    alignas(64) static uint8_t m_nMatching[NumMatchings(N)][MATCHINGSTRIDE]; ///< Generatable representations.
+    alignas(64) static uint8_t m_nComparator[NumMatchings(N)][MATCHINGSTRIDE]; ///< Testable representations.
+    static std::vector<uint16_t> m_stlTransfer; ///< Level transfer tables, \f$2^n\f$ entries each, if built.
+
+  public:
+    static void Initialize(); ///< Generate all matchings.
+    static void GetComparators(CMatching<N>&, uint8_t[]); ///< Convert to testable representation.
+    static void InitializeTransfer(); ///< Build all level transfer tables.
+    static void BuildTransfer(const uint8_t[], uint16_t[]); ///< Build a level transfer table.
+
+    static const uint8_t* GetMatching(const size_t); ///< Get generatable representation.
+    static const uint8_t* GetComparators(const size_t); ///< Get testable representation.
+    static const uint16_t* GetTransfer(const size_t); ///< Get level transfer table, if built.
+}; //CMatchingTable
+
+#endif //__MatchingTable_h__
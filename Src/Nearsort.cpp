@@ -25,28 +25,36 @@
 // IN THE SOFTWARE.
 
 #include "Nearsort.h"
+#include "Nearsort2.h"
+#include "Probes.h"
 
 /// Constructor.
-/// \param L2Matching Level 2 matching.
-/// \param index Lexicographic number of level 2 matching.
-
-CNearsort::CNearsort(CMatching& L2Matching, const size_t index):
-  CAutocomplete(L2Matching, index){
+/// \param prefix Prefix of fixed levels.
+/// \param index Index of task.
+/// \param first Index of first matching at the level below the prefix.
+/// \param last One more than the index of the last matching at that level.
+
+template<size_t N, size_t D, class T>
+CNearsort<N, D, T>::CNearsort(const CPrefix<N>& prefix, const size_t index,
+  const size_t first, const size_t last):
+  Base(prefix, index, first, last){
 } //constructor
 
 /// Check whether sorting network nearsorts all inputs.
 /// \return true iff it sorts
 
-bool CNearsort::EvenNearsorts(){ 
+template<size_t N, size_t D, class T> bool CNearsort<N, D, T>::EvenNearsorts(){ 
   bool bNearSorts = true;
-  size_t i = m_pGrayCode->Next();
+  size_t i = m_cGrayCode.Next();
 
   do{
     bNearSorts = StillNearsorts(i);
-    i = m_pGrayCode->Next();
-  }while(bNearSorts && i < m_nWidth); 
+    m_nTested++;
+    m_cStats.CountVector();
+    i = m_cGrayCode.Next();
+  }while(bNearSorts && i < N); 
 
-  m_pGrayCode->Initialize();
+  m_cGrayCode.Initialize();
  
   return bNearSorts;
 } //EvenNearsorts
@@ -55,36 +63,50 @@ bool CNearsort::EvenNearsorts(){
 /// Works for both odd and even n.
 /// \return true iff it nearsorts
 
-bool CNearsort::Nearsorts(){
-  m_pGrayCode->Initialize();  
-  InitValues(1, m_nDepth - 3);
-  m_nZeros = m_nWidth; //all zeros
+template<size_t N, size_t D, class T> bool CNearsort<N, D, T>::Nearsorts(){
+  if(m_eEngine == eEngine::BitSlice){
+    m_cBitSlice.Evaluate(m_nComparator, D - 3);
+    return m_cBitSlice.Nearsorted(3, 3, 5);
+  } //if
+
+  if(m_eEngine == eEngine::Table){
+    m_pLevelTable->Evaluate(m_nComparator, D - 3);
+    return m_pLevelTable->Nearsorted(3, 3, 5);
+  } //if
+
+  if(Refuted(m_cNearsortWitness, D - 3, 3, 3, 5))
+    return false; //a recent counterexample still works
+
+  m_cGrayCode.Initialize();  
+  InitValues(1, D - 3);
+  m_nZeros = N; //all zeros
 
-  for(int i=0; i<m_nWidth; i++){
-    for(int j=0; j<m_nWidth; j++)
-	    m_bReachableFrom[i][j] = m_bReachableTo[i][j] = m_bReachable[i][j] = false;
-    
+  for(int i=0; i<N; i++){
+    m_nReachFrom[i] = m_nReachTo[i] = m_nReach[i] = 0;
     m_nReachCountFrom[i] = m_nReachCountTo[i] = m_nReachCount[i] = 0;
   } //for
 
-  if(!EvenNearsorts())
-    return false;
+  bool bNearSorts = EvenNearsorts();
 
   //if odd number of inputs, handle the last one
 
-  if(odd(m_nWidth)){     
-    m_pGrayCode->Initialize();  
-    InitValues(1, m_nDepth - 3);
-    m_nZeros = m_nWidth - 1; //all zeros
+  if(bNearSorts && odd(N)){     
+    m_cGrayCode.Initialize();  
+    InitValues(1, D - 3);
+    m_nZeros = N - 1; //all zeros
 
-    for(int j=1; j<m_nDepth; j++)
-      m_nValue[j][m_nWidth - 1] = 1;
+    for(int j=1; j<D; j++)
+      m_nValue[j] |= 1 << (N - 1);
 
-    if(!EvenNearsorts())
-      return false;
+    m_nInput = (size_t)1 << (N - 1); //input ends with a one
+
+    bNearSorts = EvenNearsorts();
   } //if
 
-  return true;
+  if(!bNearSorts)
+    m_cNearsortWitness.Reject(m_nTested);
+
+  return bNearSorts;
 } //Nearsorts
 
 /// Check whether sorting network nearsorts when the current input has channel
@@ -92,34 +114,51 @@ bool CNearsort::Nearsorts(){
 /// \param delta Index of channel to flip.
 /// \return true if it still nearsorts when channel is flipped.
 
-bool CNearsort::StillNearsorts(const size_t delta){
-  size_t k = m_nValue[1][delta]? m_nZeros: m_nZeros - 1; //destination channel 
-  size_t j = FlipInput(delta, 1, m_nDepth - 3); //source channel into level d-2
+template<size_t N, size_t D, class T>
+bool CNearsort<N, D, T>::StillNearsorts(const size_t delta){
+  size_t k = ((m_nValue[1] >> delta) & 1)? m_nZeros: m_nZeros - 1; //destination channel 
+  size_t j = FlipInput(delta, 1, D - 3); //source channel into level d-2
   
   if(j == k)return true; //self
 
+  if(!(m_nReachFrom[j] & (1 << k))) //new pair, remember why
+    m_nPairWitness[j][k] = GetTransition(delta);
+
   //reachability heuristic: size of "from" <= 3
 
-  if(!m_bReachableFrom[j][k]){
-    if(m_nReachCountFrom[j] >= 3)return false; //not there and no room
+  if(!(m_nReachFrom[j] & (1 << k))){
+    if(m_nReachCountFrom[j] >= 3){ //not there and no room
+      InsertWitness(m_cNearsortWitness, j, k, j, MAXINPUTS);
+      return false;
+    } //if
+
 	  m_nReachCountFrom[j]++;
-    m_bReachableFrom[j][k] = true;
+    m_nReachFrom[j] |= 1 << k;
   } //if
   
   //reachability heuristic: size of "to" <= 3
 
-  if(!m_bReachableTo[j][k]){
-    if(m_nReachCountTo[k] >= 3)return false; //not there and no room
+  if(!(m_nReachTo[k] & (1 << j))){
+    if(m_nReachCountTo[k] >= 3){ //not there and no room
+      InsertWitness(m_cNearsortWitness, j, k, MAXINPUTS, k);
+      return false;
+    } //if
+
 	  m_nReachCountTo[k]++;
-    m_bReachableTo[j][k] = true;
+    m_nReachTo[k] |= 1 << j;
   } //if
   
   //reachability heuristic: size of "from" union "to" <= 5
 
-  if(!m_bReachable[j][k]){
-    if(m_nReachCount[j] >= 5 || m_nReachCount[k] >= 5) return false; //not there and no room
+  if(!(m_nReach[j] & (1 << k))){
+    if(m_nReachCount[j] >= 5 || m_nReachCount[k] >= 5){ //not there and no room
+      const size_t c = m_nReachCount[j] >= 5? j: k; //channel with no room
+      InsertWitness(m_cNearsortWitness, j, k, c, c);
+      return false;
+    } //if
+
 	  m_nReachCount[j]++; m_nReachCount[k]++;
-    m_bReachable[j][k] = m_bReachable[k][j] = true;
+    m_nReach[j] |= 1 << k; m_nReach[k] |= 1 << j;
   } //if
 
 	return true;
@@ -131,22 +170,68 @@ bool CNearsort::StillNearsorts(const size_t delta){
 /// If it fails to nearsort, then it won't sort. Continue with
 /// those that nearsort because some of them might actually sort.
 
-void CNearsort::Process(){
-  if(Nearsorts()){
-    InitMatchingRepresentations(m_nDepth - 2);
+template<size_t N, size_t D, class T> void CNearsort<N, D, T>::Process(){
+  const bool bNearsorts = Nearsorts(); //whether it nearsorts
+  m_cStats.CountNearsort(bNearsorts);
+
+  if(bNearsorts){
+    InitMatchingRepresentations(D - 2);
     bool unfinished = true;
 
     while(unfinished){
-      CSearchable::Process();
-      unfinished = m_cMatching[m_nDepth - 2].Next();   
-
-      if(unfinished)SynchMatchingRepresentations(m_nDepth - 2);
+      CSearchable<N, D, Derived>::Process();
+      unfinished = NextMatching(D - 2);
     } //while
   } //if
+
+  else PROBE_NEARSORT_REJECT();
 } //Process
 
 /// Set top of stack `m_nToS` to the third-last level of the sorting network.
 
-void CNearsort::SetToS(){
-  m_nToS = (int)m_nDepth - 3;
+template<size_t N, size_t D, class T> void CNearsort<N, D, T>::SetToS(){
+  m_nToS = (int)D - 3;
 } //SetToS
+
+/// Save a witness to a failure of the reachability heuristic in a
+/// counterexample cache. The witness consists of the test input change that
+/// connected channels j and k, together with the ones that connected the
+/// other pairs of channels that count against the threshold that was broken,
+/// that is, every pair from a given channel and every pair to a given channel.
+/// \param cache Counterexample cache.
+/// \param j Channel that the failed test input change came from.
+/// \param k Channel that the failed test input change went to.
+/// \param from Include all pairs from this channel, or `MAXINPUTS` for none.
+/// \param to Include all pairs to this channel, or `MAXINPUTS` for none.
+
+template<size_t N, size_t D, class T>
+void CNearsort<N, D, T>::InsertWitness(CWitnessCache& cache, const size_t j,
+  const size_t k, const size_t from, const size_t to)
+{
+  uint32_t witness[2*N + 1]; //counterexample
+  size_t n = 0; //its length
+  witness[n++] = m_nPairWitness[j][k]; //this change
+
+  for(size_t a=0; a<N; a++)
+    for(size_t b=0; b<N; b++)
+      if((m_nReachFrom[a] & (1 << b)) && (a == from || b == to))
+        witness[n++] = m_nPairWitness[a][b];
+
+  cache.Insert(witness, n);
+} //InsertWitness
+
+/// Add the counters from the counterexample caches to those in another cache.
+/// \param c [in, out] Cache whose counters are to be added to.
+
+template<size_t N, size_t D, class T>
+void CNearsort<N, D, T>::GetWitnessStats(CWitnessCache& c) const{
+  Base::GetWitnessStats(c);
+  c.Accumulate(m_cNearsortWitness);
+} //GetWitnessStats
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class CNearsort<n, d>; \
+  template class CNearsort<n, d, CNearsort2<n, d>>;
+FOR_EACH_SHAPE(INSTANTIATE)
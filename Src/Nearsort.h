@@ -34,17 +34,54 @@
 ///
 /// `CNearsort` is a version of  `CAutocomplete` that uses the nearsort
 /// heuristic, which is based on reachability, to prune the second-last level.
+/// When the nearsort heuristic fails, the test input changes that connected
+/// the offending pairs of channels are saved as a witness in a counterexample
+/// cache `CWitnessCache` to be tried first on the next candidate.
+/// The reachability relations are stored as one bit mask per channel, so that
+/// they fit in a single cache line.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
+
+template<size_t N, size_t D, class T = void>
+class CNearsort: public CAutocomplete<N, D, MostDerived<T, CNearsort<N, D, T>>>{
+  template<size_t, size_t, class> friend class CSearchable;
 
-class CNearsort: public CAutocomplete{
   protected:
-    bool m_bReachableFrom[MAXINPUTS][MAXINPUTS] = {false}; ///< Reachable from.
-    int m_nReachCountFrom[MAXINPUTS] = {0}; ///< Count of channels reachable from.
+    typedef MostDerived<T, CNearsort> Derived; ///< Most derived class.
+    typedef CAutocomplete<N, D, Derived> Base; ///< Base class.
+
+    using Base::m_eEngine;
+    using Base::m_nComparator;
+    using Base::m_cGrayCode;
+    using Base::m_nValue;
+    using Base::m_nZeros;
+    using Base::m_nInput;
+    using Base::m_cBitSlice;
+    using Base::m_pLevelTable;
+    using Base::m_nPairWitness;
+    using Base::m_nTested;
+    using Base::m_cStats;
+    using Base::NextMatching;
+    using Base::m_nToS;
+    using Base::InitValues;
+    using Base::FlipInput;
+    using Base::GetTransition;
+    using Base::Refuted;
+    using Base::InitMatchingRepresentations;
 
-    bool m_bReachableTo[MAXINPUTS][MAXINPUTS] = {false}; ///< Reachable to.
-    int m_nReachCountTo[MAXINPUTS] = {0}; ///< Count of channels reachable to.
+    alignas(64) uint16_t m_nReachFrom[N] = {0}; ///< Channels reachable from each channel, one bit per channel.
+    uint16_t m_nReachTo[N] = {0}; ///< Channels that reach each channel, one bit per channel.
+    uint16_t m_nReach[N] = {0}; ///< Channels reachable from or to each channel, one bit per channel.
 
-    bool m_bReachable[MAXINPUTS][MAXINPUTS] = {false}; ///< Reachable from or to.
-    int m_nReachCount[MAXINPUTS] = {0}; ///< Count of channels reachable from or to.
+    uint8_t m_nReachCountFrom[N] = {0}; ///< Count of channels reachable from.
+    uint8_t m_nReachCountTo[N] = {0}; ///< Count of channels reachable to.
+    uint8_t m_nReachCount[N] = {0}; ///< Count of channels reachable from or to.
+
+    CWitnessCache m_cNearsortWitness; ///< Counterexample cache for nearsort.
+
+    void InsertWitness(CWitnessCache&, const size_t, const size_t, const size_t, const size_t); ///< Save a counterexample.
 
     bool StillNearsorts(const size_t); ///< Does it still nearsort with this input change?
     bool EvenNearsorts(); ///< Does it nearly sort, even number of inputs?
@@ -54,7 +91,9 @@ class CNearsort: public CAutocomplete{
     void SetToS(); ///< Set top of stack.
 
   public:
-    CNearsort(CMatching&, const size_t); ///< Constructor.
+    CNearsort(const CPrefix<N>&, const size_t, const size_t, const size_t); ///< Constructor.
+
+    void GetWitnessStats(CWitnessCache&) const; ///< Add up counterexample cache counters.
 }; //CNearsort
 
 #endif //__Nearsort_h__
\ No newline at end of file
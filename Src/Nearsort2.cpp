@@ -25,65 +25,86 @@
 // IN THE SOFTWARE.
 
 #include "Nearsort2.h"
+#include "Probes.h"
 
 /// Constructor.
-/// \param L2Matching Level 2 matching.
-/// \param index Lexicographic number of level 2 matching.
-
-CNearsort2::CNearsort2(CMatching& L2Matching, const size_t index):
-  CNearsort(L2Matching, index){
+/// \param prefix Prefix of fixed levels.
+/// \param index Index of task.
+/// \param first Index of first matching at the level below the prefix.
+/// \param last One more than the index of the last matching at that level.
+
+template<size_t N, size_t D, class T>
+CNearsort2<N, D, T>::CNearsort2(const CPrefix<N>& prefix, const size_t index,
+  const size_t first, const size_t last):
+  Base(prefix, index, first, last){
 } //constructor
 
 /// Check whether sorting network nearsorts2 all inputs. Works for even width,
 /// and for odd width it doesn't change the last input.
 /// \return true iff it sorts
 
-bool CNearsort2::EvenNearsorts2(){ 
+template<size_t N, size_t D, class T> bool CNearsort2<N, D, T>::EvenNearsorts2(){ 
   size_t i = 0;
   bool bNearSorts = true;
 
-  while(bNearSorts && i<m_nWidth){
-    i = m_pGrayCode->Next();
-    bNearSorts = bNearSorts && (i>=m_nWidth || StillNearsorts2(i));
+  while(bNearSorts && i<N){
+    i = m_cGrayCode.Next();
+    bNearSorts = bNearSorts && (i>=N || StillNearsorts2(i));
+    m_nTested++;
+    m_cStats.CountVector();
   } //while
   
-  m_pGrayCode->Initialize(); 
+  m_cGrayCode.Initialize(); 
 
   return bNearSorts;
 } //EvenNearsorts2
 
 /// Check whether sorting network nearsorts2 all inputs.
-/// Works for both odd and even `m_nWidth`.
+/// Works for both odd and even `N`.
 /// \return true iff it nearsorts2
 
-bool CNearsort2::Nearsorts2(){
-  m_pGrayCode->Initialize();  
-  InitValues(1, m_nDepth - 4);
-  m_nZeros = m_nWidth; //all zeros
+template<size_t N, size_t D, class T> bool CNearsort2<N, D, T>::Nearsorts2(){
+  if(m_eEngine == eEngine::BitSlice){
+    m_cBitSlice.Evaluate(m_nComparator, D - 4);
+    return m_cBitSlice.Nearsorted(7, 7, 9);
+  } //if
+
+  if(m_eEngine == eEngine::Table){
+    m_pLevelTable->Evaluate(m_nComparator, D - 4);
+    return m_pLevelTable->Nearsorted(7, 7, 9);
+  } //if
+
+  if(Refuted(m_cNearsort2Witness, D - 4, 7, 7, 9))
+    return false; //a recent counterexample still works
+
+  m_cGrayCode.Initialize();  
+  InitValues(1, D - 4);
+  m_nZeros = N; //all zeros
 
-  for(int i=0; i<m_nWidth; i++){
-    for(int j=0; j<m_nWidth; j++)
-	    m_bReachableFrom[i][j] = m_bReachableTo[i][j] = m_bReachable[i][j] = false;
-    
+  for(int i=0; i<N; i++){
+    m_nReachFrom[i] = m_nReachTo[i] = m_nReach[i] = 0;
     m_nReachCountFrom[i] = m_nReachCountTo[i] = m_nReachCount[i] = 0;
   } //for
 
-  if(!EvenNearsorts2())
-    return false;
+  bool bNearSorts = EvenNearsorts2();
 
-  if(m_nWidth & 1){ //odd number of inputs, handle the last one independently   
-    m_pGrayCode->Initialize();  
-    InitValues(1, m_nDepth - 4);
-    m_nZeros = m_nWidth - 1;
+  if(bNearSorts && (N & 1)){ //odd number of inputs, handle the last one independently   
+    m_cGrayCode.Initialize();  
+    InitValues(1, D - 4);
+    m_nZeros = N - 1;
 
-    for(int j=1; j<m_nDepth; j++)
-      m_nValue[j][m_nWidth - 1] = 1;
+    for(int j=1; j<D; j++)
+      m_nValue[j] |= 1 << (N - 1);
 
-    if(!EvenNearsorts2())
-      return false;
+    m_nInput = (size_t)1 << (N - 1); //input ends with a one
+
+    bNearSorts = EvenNearsorts2();
   } //if
 
-  return true;
+  if(!bNearSorts)
+    m_cNearsort2Witness.Reject(m_nTested);
+
+  return bNearSorts;
 } //Nearsorts2
 
 /// Check whether sorting network nearsorts2 when the current input has 
@@ -91,34 +112,51 @@ bool CNearsort2::Nearsorts2(){
 /// \param delta Index of channel to flip.
 /// \return true if it still nearsorts2 when channel is flipped.
 
-bool CNearsort2::StillNearsorts2(const size_t delta){
-  size_t k = m_nValue[1][delta]? m_nZeros: m_nZeros - 1; //destination channel  
-  const size_t j = FlipInput(delta, 1, m_nDepth - 4);
+template<size_t N, size_t D, class T>
+bool CNearsort2<N, D, T>::StillNearsorts2(const size_t delta){
+  size_t k = ((m_nValue[1] >> delta) & 1)? m_nZeros: m_nZeros - 1; //destination channel  
+  const size_t j = FlipInput(delta, 1, D - 4);
   
   if(j == k)return true; //self
 
+  if(!(m_nReachFrom[j] & (1 << k))) //new pair, remember why
+    m_nPairWitness[j][k] = GetTransition(delta);
+
   //reachability heuristic: size of "from" <= 7
 
-  if(!m_bReachableFrom[j][k]){
-    if(m_nReachCountFrom[j] >= 7) return false; //not there and no room
+  if(!(m_nReachFrom[j] & (1 << k))){
+    if(m_nReachCountFrom[j] >= 7){ //not there and no room
+      InsertWitness(m_cNearsort2Witness, j, k, j, MAXINPUTS);
+      return false;
+    } //if
+
 	  m_nReachCountFrom[j]++;
-    m_bReachableFrom[j][k] = true;
+    m_nReachFrom[j] |= 1 << k;
   } //if
   
   //reachability heuristic: size of "to" <= 7
 
-  if(!m_bReachableTo[j][k]){
-    if(m_nReachCountTo[k] >= 7) return false; //not there and no room
+  if(!(m_nReachTo[k] & (1 << j))){
+    if(m_nReachCountTo[k] >= 7){ //not there and no room
+      InsertWitness(m_cNearsort2Witness, j, k, MAXINPUTS, k);
+      return false;
+    } //if
+
 	  m_nReachCountTo[k]++;
-    m_bReachableTo[j][k] = true;
+    m_nReachTo[k] |= 1 << j;
   } //if
   
   //reachability heuristic: size of "from" union "to" <= 9
 
-  if(!m_bReachable[j][k]){
-    if(m_nReachCount[j] >= 9 || m_nReachCount[k] >= 9) return false; //not there and no room
+  if(!(m_nReach[j] & (1 << k))){
+    if(m_nReachCount[j] >= 9 || m_nReachCount[k] >= 9){ //not there and no room
+      const size_t c = m_nReachCount[j] >= 9? j: k; //channel with no room
+      InsertWitness(m_cNearsort2Witness, j, k, c, c);
+      return false;
+    } //if
+
 	  m_nReachCount[j]++; m_nReachCount[k]++;
-    m_bReachable[j][k] = m_bReachable[k][j] = true;
+    m_nReach[j] |= 1 << k; m_nReach[k] |= 1 << j;
   } //if
 
 	return true;
@@ -130,22 +168,40 @@ bool CNearsort2::StillNearsorts2(const size_t delta){
 /// If it fails to nearsort2, then it won't sort. Continue with
 /// those that nearsort2 because some of them might actually sort.
 
-void CNearsort2::Process(){
-  if(Nearsorts2()){
-    InitMatchingRepresentations(m_nDepth - 3);
+template<size_t N, size_t D, class T> void CNearsort2<N, D, T>::Process(){
+  const bool bNearsorts2 = Nearsorts2(); //whether it nearsorts2
+  m_cStats.CountNearsort2(bNearsorts2);
+
+  if(bNearsorts2){
+    InitMatchingRepresentations(D - 3);
     bool unfinished = true;
 
     while(unfinished){
-      CNearsort::Process();
-      unfinished = m_cMatching[m_nDepth - 3].Next(); 
-      if(unfinished)
-        SynchMatchingRepresentations(m_nDepth - 3);
+      Base::Process();
+      unfinished = NextMatching(D - 3);
     } //while
   } //if
+
+  else PROBE_NEARSORT2_REJECT();
 } //Process
 
   /// Set top of stack `m_nToS` to the fourth-last level of the sorting network.
 
-void CNearsort2::SetToS(){
-  m_nToS = (int)m_nDepth - 4;
+template<size_t N, size_t D, class T> void CNearsort2<N, D, T>::SetToS(){
+  m_nToS = (int)D - 4;
 } //SetToS
+
+/// Add the counters from the counterexample caches to those in another cache.
+/// \param c [in, out] Cache whose counters are to be added to.
+
+template<size_t N, size_t D, class T>
+void CNearsort2<N, D, T>::GetWitnessStats(CWitnessCache& c) const{
+  Base::GetWitnessStats(c);
+  c.Accumulate(m_cNearsort2Witness);
+} //GetWitnessStats
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class CNearsort2<n, d>;
+FOR_EACH_SHAPE(INSTANTIATE)
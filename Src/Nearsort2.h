@@ -33,9 +33,47 @@
 ///
 /// CNearsort2 is a version of CNearsort that uses the nearsort2 heuristic, 
 /// which is based on reachability, to prune two levels from the end.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
+
+template<size_t N, size_t D, class T = void>
+class CNearsort2: public CNearsort<N, D, MostDerived<T, CNearsort2<N, D, T>>>{
+  template<size_t, size_t, class> friend class CSearchable;
+
+  protected:
+    typedef MostDerived<T, CNearsort2> Derived; ///< Most derived class.
+    typedef CNearsort<N, D, Derived> Base; ///< Base class.
+
+    using Base::m_eEngine;
+    using Base::m_nComparator;
+    using Base::m_cGrayCode;
+    using Base::m_nValue;
+    using Base::m_nZeros;
+    using Base::m_nInput;
+    using Base::m_cBitSlice;
+    using Base::m_pLevelTable;
+    using Base::m_nPairWitness;
+    using Base::m_nTested;
+    using Base::m_cStats;
+    using Base::NextMatching;
+    using Base::m_nToS;
+    using Base::m_nReachFrom;
+    using Base::m_nReachTo;
+    using Base::m_nReach;
+    using Base::m_nReachCountFrom;
+    using Base::m_nReachCountTo;
+    using Base::m_nReachCount;
+    using Base::InitValues;
+    using Base::FlipInput;
+    using Base::GetTransition;
+    using Base::Refuted;
+    using Base::InsertWitness;
+    using Base::InitMatchingRepresentations;
+
+    CWitnessCache m_cNearsort2Witness; ///< Counterexample cache for nearsort2.
 
-class CNearsort2: public CNearsort{
-  protected: 
     bool StillNearsorts2(const size_t delta); ///< Does it still nearsort with this input change?
     bool EvenNearsorts2(); ///< Does it nearly sort, even number of inputs?
     bool Nearsorts2(); ///< Does it nearly sort?
@@ -44,7 +82,9 @@ class CNearsort2: public CNearsort{
     void SetToS(); ///< Set top of stack.
 
 public:
-  CNearsort2(CMatching&, const size_t); ///< Constructor.
+  CNearsort2(const CPrefix<N>&, const size_t, const size_t, const size_t); ///< Constructor.
+
+  void GetWitnessStats(CWitnessCache&) const; ///< Add up counterexample cache counters.
 }; //CNearsort2
 
 #endif //__Nearsort2_h__
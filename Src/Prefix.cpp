@@ -0,0 +1,336 @@
+/// \file Prefix.cpp
+/// \brief Code for the comparator network prefix `CPrefix`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+
+#include "Prefix.h"
+#include "Kernel.h"
+
+/// Make the first level the identity matching, which places comparators
+/// between channels 0 and 1, 2 and 3, 4 and 5, etc., and compute its output
+/// set, which consists of the words with 00, 01, or 11 on each of these pairs.
+
+template<size_t N> CPrefix<N>::CPrefix(){
+  for(size_t j=0; j<N; j++)
+    m_nComparator[0][j] = (uint8_t)j;
+
+  for(size_t j=0; j<evenfloor(N); j++)
+    m_nComparator[0][j] = (uint8_t)(j ^ 1);
+
+  m_nLevels = 1;
+
+  for(size_t x=0; x<((size_t)1 << N); x++){ //for each input word
+    bool bSorted = true; //whether every pair is sorted
+
+    for(size_t j=0; j<evenfloor(N) && bSorted; j+=2)
+      bSorted = ((x >> j) & 3) != 1; //not a one on top of a zero
+
+    if(bSorted)
+      m_stlOutput.push_back((uint16_t)x);
+  } //for
+
+  Analyze();
+} //constructor
+
+/// Compute the bit set and the number of output words of each weight, in
+/// total and with a one on each channel, from the sorted list of output words.
+
+template<size_t N> void CPrefix<N>::Analyze(){
+  m_stlMember.assign(((size_t)1 << N)/64 + 1, 0);
+
+  for(size_t w=0; w<=N; w++){
+    m_nWeight[w] = 0;
+
+    for(size_t j=0; j<N; j++)
+      m_nOnes[w][j] = 0;
+  } //for
+
+  for(const uint16_t x: m_stlOutput){ //for each output word
+    const size_t w = PopCount(x); //its weight
+    m_stlMember[x/64] |= (uint64_t)1 << (x%64);
+    m_nWeight[w]++;
+
+    for(size_t j=0; j<N; j++)
+      m_nOnes[w][j] += (x >> j) & 1;
+  } //for
+} //Analyze
+
+/// Append a level of comparators and push the output set through it.
+/// \param comparator Testable representation of the level.
+
+template<size_t N> void CPrefix<N>::Append(const uint8_t comparator[]){
+  for(size_t j=0; j<N; j++)
+    m_nComparator[m_nLevels][j] = comparator[j];
+
+  m_nLevels++;
+
+  std::vector<uint64_t> member(((size_t)1 << N)/64 + 1, 0); //new output set
+
+  for(const uint16_t x: m_stlOutput){ //for each output word
+    uint16_t y = x; //its image
+
+    for(size_t j=0; j<N; j++){ //for each comparator
+      const size_t k = comparator[j]; //other end
+
+      if(k > j && ((y >> j) & 1) && !((y >> k) & 1)) //one on top of a zero
+        y ^= (uint16_t)((1 << j) | (1 << k)); //swap
+    } //for
+
+    member[y/64] |= (uint64_t)1 << (y%64);
+  } //for
+
+  m_stlOutput.clear();
+
+  for(size_t i=0; i<member.size(); i++) //sorted list of new output words
+    for(uint64_t b=member[i]; b; b&=b-1)
+      m_stlOutput.push_back((uint16_t)(64*i + LowBit(b)));
+
+  Analyze();
+
+  m_stlSymmetry.clear();
+
+  if(m_nLevels == 2 && m_bSymmetry)
+    FindSymmetries(); //of the first two levels
+} //Append
+
+/// Find the permutations of pairs of first level channels, each with and
+/// without reflection, that map the second level to itself, and store the
+/// permutations that they induce on the third level in `m_stlSymmetry`.
+/// A second level comparator that is turned upside down is untwisted by
+/// exchanging its channels in the levels below it, so the third level is
+/// permuted by the symmetry followed by these exchanges. The identity is
+/// not stored.
+
+template<size_t N> void CPrefix<N>::FindSymmetries(){
+  const uint8_t* L2 = m_nComparator[1]; //second level
+  const size_t p = N/2; //number of pairs in the first level
+  const size_t m = 2*p; //number of channels paired in the first level
+
+  uint8_t q[N/2]; //permutation of pairs
+
+  for(size_t k=0; k<p; k++)
+    q[k] = (uint8_t)k;
+
+  do{ //for each permutation of pairs
+    for(size_t r=0; r<2; r++){ //without and with reflection
+      uint8_t pi[N]; //permutation of channels
+
+      for(size_t j=0; j<N; j++){
+        const size_t i = j < m? 2*q[j/2] + (j & 1): j; //permute pairs
+        pi[j] = (uint8_t)(r && i < m? m - 1 - i: i); //then reflect
+      } //for
+
+      bool bFixed = true; //whether the second level is mapped to itself
+
+      for(size_t j=0; j<N && bFixed; j++)
+        bFixed = L2[pi[j]] == pi[L2[j]];
+
+      if(bFixed){ //a symmetry
+        uint8_t sigma[N]; //induced permutation of the third level
+        bool bIdentity = true; //whether sigma is the identity
+
+        for(size_t j=0; j<N; j++)
+          sigma[j] = pi[j];
+
+        for(size_t a=0; a<N; a++){ //untwist upside down comparators
+          const size_t b = L2[a]; //other end of comparator
+
+          if(b > a && (r? pi[a] < pi[b]: pi[a] > pi[b])){ //min ends up below max
+            for(size_t j=0; j<N; j++){
+              if(sigma[j] == pi[a])sigma[j] = pi[b];
+              else if(sigma[j] == pi[b])sigma[j] = pi[a];
+            } //for
+          } //if
+        } //for
+
+        for(size_t j=0; j<N; j++)
+          bIdentity = bIdentity && sigma[j] == j;
+
+        if(!bIdentity)
+          m_stlSymmetry.insert(m_stlSymmetry.end(), sigma, sigma + N);
+      } //if
+    } //for
+  }while(std::next_permutation(q, q + p));
+} //FindSymmetries
+
+/// Check whether a third level is the smallest in its orbit, that is, whether
+/// none of a list of permutations of the third level maps it to a
+/// lexicographically smaller one.
+/// \param symmetry Permutations of the third level, `N` entries each.
+/// \param comparator Testable representation of the third level.
+/// \return true if no permutation maps it to a smaller one.
+
+template<size_t N> bool CPrefix<N>::Smallest(const std::vector<uint8_t>& symmetry,
+  const uint8_t comparator[])
+{
+  for(size_t s=0; s<symmetry.size(); s+=N){ //for each symmetry
+    const uint8_t* sigma = &symmetry[s]; //the permutation
+    uint8_t image[N]; //image of the third level under it
+
+    for(size_t j=0; j<N; j++)
+      image[sigma[j]] = sigma[comparator[j]];
+
+    if(memcmp(image, comparator, N) < 0)
+      return false; //not the smallest in its orbit
+  } //for
+
+  return true;
+} //Smallest
+
+/// Check whether a level can be appended to this prefix, that is, whether it
+/// is neither pruned for repeating a comparator from the last level (if
+/// pruning) nor, for a third level, equivalent to a smaller one under the
+/// symmetries of the first two.
+/// \param comparator Testable representation of the level.
+/// \return true if the level can be appended.
+
+template<size_t N> bool CPrefix<N>::Admits(const uint8_t comparator[]) const{
+  if(m_bPrune)
+    for(size_t j=0; j<N; j++) //for each channel
+      if(comparator[j] != j && comparator[j] == m_nComparator[m_nLevels - 1][j])
+        return false; //same comparator on this channel
+
+  return m_nLevels != 2 || Smallest(m_stlSymmetry, comparator);
+} //Admits
+
+/// Check whether this prefix subsumes another one, that is, whether some
+/// permutation of the channels maps this output set into the other one.
+/// This is a sound but incomplete test: it gives up and returns false after
+/// `MAXSUBSUMENODES` partial permutations.
+/// \param p Another prefix.
+/// \return true if a permutation was found.
+
+template<size_t N> bool CPrefix<N>::Subsumes(const CPrefix& p) const{
+  if(m_stlOutput.size() > p.m_stlOutput.size())
+    return false; //too many output words
+
+  for(size_t w=0; w<=N; w++)
+    if(m_nWeight[w] > p.m_nWeight[w])
+      return false; //too many output words of this weight
+
+  uint16_t nCandidate[N] = {0}; //channels that each channel can be mapped to
+
+  for(size_t j=0; j<N; j++){ //for each channel here
+    for(size_t k=0; k<N; k++){ //for each channel there
+      bool bOk = true; //whether j can be mapped to k
+
+      for(size_t w=0; w<=N && bOk; w++)
+        bOk = m_nOnes[w][j] <= p.m_nOnes[w][k] &&
+          m_nWeight[w] - m_nOnes[w][j] <= p.m_nWeight[w] - p.m_nOnes[w][k];
+
+      if(bOk)
+        nCandidate[j] |= (uint16_t)(1 << k);
+    } //for
+
+    if(nCandidate[j] == 0)
+      return false; //nowhere to map channel j
+  } //for
+
+  uint8_t pi[N] = {0}; //channel permutation
+  size_t nNodes = 0; //number of partial permutations tried
+
+  return Extend(p, nCandidate, pi, 0, nNodes);
+} //Subsumes
+
+/// Extend a partial permutation of the channels, which maps the channels
+/// below the first unmapped one, by mapping the first unmapped channel to
+/// each of its unused candidates in turn.
+/// \param p Prefix whose output set this one's is to be mapped into.
+/// \param candidate Bit mask of the channels that each channel may be mapped to.
+/// \param pi [in, out] Partial permutation.
+/// \param used Bit mask of the channels that the partial permutation maps to.
+/// \param nodes [in, out] Number of partial permutations tried so far.
+/// \return true if the partial permutation extends to one that works.
+
+template<size_t N> bool CPrefix<N>::Extend(const CPrefix& p,
+  const uint16_t candidate[], uint8_t pi[], const uint16_t used,
+  size_t& nodes) const
+{
+  if(++nodes > MAXSUBSUMENODES)
+    return false; //give up
+
+  const size_t j = PopCount(used); //first unmapped channel
+
+  if(j == N){ //complete permutation, check it
+    for(const uint16_t x: m_stlOutput){ //for each output word
+      uint16_t y = 0; //its image
+
+      for(size_t i=0; i<N; i++)
+        if((x >> i) & 1)
+          y |= (uint16_t)(1 << pi[i]);
+
+      if(!((p.m_stlMember[y/64] >> (y%64)) & 1))
+        return false; //not in the other output set
+    } //for
+
+    return true;
+  } //if
+
+  for(uint16_t b=candidate[j] & ~used; b; b&=b-1){ //for each unused candidate
+    const size_t k = LowBit(b); //map j to k
+    pi[j] = (uint8_t)k;
+
+    if(Extend(p, candidate, pi, used | (uint16_t)(1 << k), nodes))
+      return true;
+  } //for
+
+  return false;
+} //Extend
+
+/// Reader function for the number of levels.
+/// \return The number of levels.
+
+template<size_t N> const size_t CPrefix<N>::GetNumLevels() const{
+  return m_nLevels;
+} //GetNumLevels
+
+/// Reader function for the testable representation of a level.
+/// \param i Index of a level.
+/// \return Pointer to the testable representation of that level.
+
+template<size_t N> const uint8_t* CPrefix<N>::GetLevel(const size_t i) const{
+  return m_nComparator[i];
+} //GetLevel
+
+/// Reader function for the size of the output set.
+/// \return The number of distinct output words.
+
+template<size_t N> const size_t CPrefix<N>::GetNumOutputs() const{
+  return m_stlOutput.size();
+} //GetNumOutputs
+
+/// Reader function for the symmetries of the first two levels.
+/// \return The permutations that they induce on the third level, `N` entries
+/// each, or none if this prefix does not have exactly two levels.
+
+template<size_t N> const std::vector<uint8_t>& CPrefix<N>::GetSymmetries() const{
+  return m_stlSymmetry;
+} //GetSymmetries
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CPrefix<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
@@ -0,0 +1,92 @@
+/// \file Prefix.h
+/// \brief Interface for the comparator network prefix `CPrefix`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __Prefix_h__
+#define __Prefix_h__
+
+#include <cstdint>
+#include <vector>
+
+#include "Defines.h"
+#include "Settings.h"
+
+/// \brief Comparator network prefix.
+///
+/// The first few levels of a first normal form comparator network, together
+/// with its _output set_, that is, the set of zero-one words that it outputs
+/// when given every zero-one word as input. The output set is kept both as a
+/// sorted list of words and as a bit set for fast membership tests.
+///
+/// Prefix \f$A\f$ _subsumes_ prefix \f$B\f$ if there is a permutation
+/// \f$\pi\f$ of the channels such that \f$\pi\f$ maps the output set of
+/// \f$A\f$ into the output set of \f$B\f$. If \f$B\f$ followed by some suffix
+/// sorts, then \f$A\f$ followed by the suffix with its channels permuted by
+/// \f$\pi^{-1}\f$, and then untwisted, sorts too. Only one of them therefore
+/// needs to be searched (see Bundala and Z&aacute;vodn&yacute;, _Optimal
+/// Sorting Networks_, 2014). `CPrefix::Subsumes()` looks for \f$\pi\f$ by
+/// backtracking over the channels, pruned by comparing the number of ones
+/// and zeros on each channel in the words of each weight.
+///
+/// If `CSettings::m_bSymmetry` is true, then a prefix of two levels also
+/// keeps the symmetries of its first two levels, so that candidates for the
+/// third level that are equivalent under them can be skipped, whether the
+/// third level is appended here or enumerated by `C2NF`.
+///
+/// \tparam N Number of channels.
+
+template<size_t N> class CPrefix: public CSettings{
+  private:
+    uint8_t m_nComparator[MAXDEPTH][N] = {{0}}; ///< Testable representation of each level.
+    size_t m_nLevels = 0; ///< Number of levels.
+
+    std::vector<uint16_t> m_stlOutput; ///< Output set as a sorted list of words.
+    std::vector<uint64_t> m_stlMember; ///< Output set as a bit set.
+
+    uint16_t m_nWeight[N + 1] = {0}; ///< Number of output words of each weight.
+    uint16_t m_nOnes[N + 1][N] = {{0}}; ///< Number of output words of each weight with a one on each channel.
+
+    std::vector<uint8_t> m_stlSymmetry; ///< Permutations of the third level, `N` entries each.
+
+    void Analyze(); ///< Compute the bit set and counts from the output list.
+    void FindSymmetries(); ///< Find the symmetries of the first two levels.
+    bool Extend(const CPrefix&, const uint16_t[], uint8_t[], const uint16_t,
+      size_t&) const; ///< Extend a partial channel permutation.
+
+  public:
+    CPrefix(); ///< Constructor.
+
+    void Append(const uint8_t[]); ///< Append a level.
+    bool Subsumes(const CPrefix&) const; ///< Does this subsume another prefix?
+    bool Admits(const uint8_t[]) const; ///< Can a level be appended?
+
+    static bool Smallest(const std::vector<uint8_t>&, const uint8_t[]); ///< Is a third level the smallest in its orbit?
+
+    const size_t GetNumLevels() const; ///< Get number of levels.
+    const uint8_t* GetLevel(const size_t) const; ///< Get a level.
+    const size_t GetNumOutputs() const; ///< Get size of output set.
+    const std::vector<uint8_t>& GetSymmetries() const; ///< Get third level permutations.
+}; //CPrefix
+
+#endif //__Prefix_h__
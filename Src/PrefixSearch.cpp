@@ -0,0 +1,131 @@
+/// \file PrefixSearch.cpp
+/// \brief Code for the prefix generator `CPrefixSearch`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <iostream>
+
+#include "PrefixSearch.h"
+#include "MatchingTable.h"
+
+/// Make a prefix from the first level and each second level candidate, then
+/// filter and extend them as described in the class documentation. Print
+/// the number of prefixes kept to the console.
+/// \param L2Matchings Second level candidates.
+
+template<size_t N>
+CPrefixSearch<N>::CPrefixSearch(const std::vector<CMatching<N>>& L2Matchings){
+  for(CMatching<N> matching: L2Matchings){ //for each second level candidate
+    if(odd(N))matching[N] = N; 
+
+    uint8_t comparator[N]; //testable representation
+    CMatchingTable<N>::GetComparators(matching, comparator);
+
+    CPrefix<N> prefix; //first level
+    prefix.Append(comparator); //and second
+
+    if(m_nSubsumeLevel)
+      Insert(m_stlResults, prefix);
+    else m_stlResults.push_back(prefix);
+
+    m_nGenerated++;
+  } //for
+
+  if(m_nSubsumeLevel == 2)
+    PrintKept(2);
+
+  const size_t nDepth = std::max(m_nSubsumeLevel, m_nSplitLevel); //depth of prefixes
+
+  for(size_t level=3; level<=nDepth; level++){ //for each deeper level
+    std::vector<CPrefix<N>> stlPrevious; //prefixes one level shorter
+    stlPrevious.swap(m_stlResults);
+    m_nGenerated = 0;
+
+    for(const CPrefix<N>& p: stlPrevious) //for each of them
+      for(size_t i=0; i<NumMatchings(N); i++){ //for each matching
+        const uint8_t* comparator = CMatchingTable<N>::GetComparators(i);
+
+        if(p.Admits(comparator)){
+          CPrefix<N> prefix(p); //extend it
+          prefix.Append(comparator);
+
+          if(level <= m_nSubsumeLevel)
+            Insert(m_stlResults, prefix);
+          else m_stlResults.push_back(prefix);
+
+          m_nGenerated++;
+        } //if
+      } //for
+
+    if(level == m_nSubsumeLevel)
+      PrintKept(level);
+  } //for
+
+  if(nDepth > std::max(m_nSubsumeLevel, (size_t)2))
+    std::cout << m_stlResults.size() << " prefixes of depth " << nDepth << std::endl;
+} //constructor
+
+/// Print the number of prefixes kept by the subsumption filter at the last
+/// level that it was applied to, and the number of prefixes generated there.
+/// \param level The last level filtered.
+
+template<size_t N> void CPrefixSearch<N>::PrintKept(const size_t level) const{
+  std::cout << m_stlResults.size() << " prefixes of depth " << level;
+  std::cout << " kept out of " << m_nGenerated << std::endl;
+} //PrintKept
+
+/// Insert a prefix into a vector of prefixes unless one of them subsumes it,
+/// in which case it is dropped. If it is inserted, the prefixes in the vector
+/// that it subsumes are removed.
+/// \param v Vector of prefixes, none of which subsumes another.
+/// \param p Prefix.
+
+template<size_t N>
+void CPrefixSearch<N>::Insert(std::vector<CPrefix<N>>& v, const CPrefix<N>& p){
+  for(const CPrefix<N>& q: v)
+    if(q.Subsumes(p))
+      return; //p is not needed
+
+  size_t n = 0; //number of prefixes kept
+
+  for(size_t i=0; i<v.size(); i++) //remove the ones that p subsumes
+    if(!p.Subsumes(v[i]))
+      std::swap(v[n++], v[i]);
+
+  v.resize(n);
+  v.push_back(p);
+} //Insert
+
+/// Reader function for the resulting vector of prefixes.
+/// \return Reference to `m_stlResults`.
+
+template<size_t N>
+const std::vector<CPrefix<N>>& CPrefixSearch<N>::GetPrefixes() const{
+  return m_stlResults;
+} //GetPrefixes
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CPrefixSearch<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
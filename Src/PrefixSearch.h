@@ -0,0 +1,66 @@
+/// \file PrefixSearch.h
+/// \brief Interface for the prefix generator `CPrefixSearch`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __PrefixSearch_h__
+#define __PrefixSearch_h__
+
+#include <vector>
+
+#include "Matching.h"
+#include "Prefix.h"
+#include "Defines.h"
+#include "Settings.h"
+
+/// \brief Prefix search.
+///
+/// Generate the prefixes that the search tasks start from, namely the first
+/// level followed by each second level candidate from `CLevel2Search`, and if
+/// `CSettings::m_nSubsumeLevel` is nonzero, filter them by subsumption (see
+/// `CPrefix`). The prefixes that survive are extended by every matching
+/// and filtered again, level by level, down to level `m_nSubsumeLevel`.
+/// A prefix is dropped only if a permutation that proves it subsumed is found,
+/// so the filter never loses a sorting network, although it may keep some
+/// prefixes that could have been dropped. If `CSettings::m_nSplitLevel` is
+/// deeper, the prefixes are then extended without filtering down to that
+/// level, so that there are more of them for the tasks to start from.
+/// Matchings that `CPrefix::Admits()` rejects are never appended.
+///
+/// \tparam N Number of channels.
+
+template<size_t N> class CPrefixSearch: public CSettings{
+  private:
+    std::vector<CPrefix<N>> m_stlResults; ///< Results.
+    size_t m_nGenerated = 0; ///< Number of prefixes generated at the last level.
+
+    void Insert(std::vector<CPrefix<N>>&, const CPrefix<N>&); ///< Insert a prefix unless subsumed.
+    void PrintKept(const size_t) const; ///< Print the number of prefixes kept.
+
+  public:
+    CPrefixSearch(const std::vector<CMatching<N>>&); ///< Constructor.
+    
+    const std::vector<CPrefix<N>>& GetPrefixes() const; ///< Get prefix vector.
+}; //CPrefixSearch
+
+#endif //__PrefixSearch_h__
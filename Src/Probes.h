@@ -0,0 +1,71 @@
+/// \file Probes.h
+/// \brief Static tracepoints for `perf` and `bpftrace`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __Probes_h__
+#define __Probes_h__
+
+#if !defined(NOPROBES) && defined(__has_include)
+  #if __has_include(<sys/sdt.h>)
+    #include <sys/sdt.h>
+
+    /// \brief Static tracepoints are compiled in.
+    ///
+    /// Defined if the static tracepoints, also known as USDT probes, are
+    /// compiled in, which they are if `<sys/sdt.h>` from SystemTap can be
+    /// included (on Debian and Ubuntu it is in package `systemtap-sdt-dev`)
+    /// and `NOPROBES` is not defined. Otherwise, for example on Windows, the
+    /// `PROBE_` macros compile to nothing and the executable has no
+    /// tracepoints, so define `REQUIREPROBES` to make that an error instead.
+    /// Each tracepoint is in provider `search` and compiles to a single `nop`
+    /// instruction and a note in the executable saying where it is and where
+    /// its arguments are, so it costs almost nothing when no tracer is
+    /// attached, for example with
+    /// `bpftrace -e 'usdt:./search:search:found { @[tid] = count(); }'`.
+
+    #define PROBES
+  #endif //__has_include
+#endif //NOPROBES
+
+#if defined(REQUIREPROBES) && !defined(PROBES)
+  #error "REQUIREPROBES is defined but <sys/sdt.h> is not available or NOPROBES is defined"
+#endif //REQUIREPROBES
+
+#ifdef PROBES
+  #define PROBE_TASK_START(i, t) DTRACE_PROBE2(search, task_start, i, t) ///< Task `i` started on thread `t`.
+  #define PROBE_TASK_END(i, t, n) DTRACE_PROBE3(search, task_end, i, t, n) ///< Task `i` finished on thread `t` having found `n` sorting networks.
+  #define PROBE_LEVEL(l, m) DTRACE_PROBE2(search, level, l, m) ///< `CSearchable::NextComparatorNetwork()` advanced level `l` to matching `m`.
+  #define PROBE_NEARSORT_REJECT() DTRACE_PROBE(search, nearsort_reject) ///< A candidate failed the nearsort test.
+  #define PROBE_NEARSORT2_REJECT() DTRACE_PROBE(search, nearsort2_reject) ///< A candidate failed the nearsort2 test.
+  #define PROBE_FOUND(n) DTRACE_PROBE1(search, found, n) ///< A sorting network was found, the `n`th in its task.
+#else
+  #define PROBE_TASK_START(i, t) ///< Compiled out.
+  #define PROBE_TASK_END(i, t, n) ///< Compiled out.
+  #define PROBE_LEVEL(l, m) ///< Compiled out.
+  #define PROBE_NEARSORT_REJECT() ///< Compiled out.
+  #define PROBE_NEARSORT2_REJECT() ///< Compiled out.
+  #define PROBE_FOUND(n) ///< Compiled out.
+#endif //PROBES
+
+#endif //__Probes_h__
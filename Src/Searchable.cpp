@@ -23,14 +23,50 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
-#include "Searchable.h"
-
-/// Compute the number of matchings and store it in `m_nNumMatchings`.
+#include <algorithm>
+#include <chrono>
+#include <vector>
 
-CSearchable::CSearchable(): C1NF(){
-  m_nNumMatchings = 1;
-  for(size_t i = oddfloor(m_nWidth); i>1; i-=2)
-    m_nNumMatchings *= i;
+#include "Searchable.h"
+#include "Nearsort2.h"
+#include "ThreadManager.h"
+#include "Probes.h"
+
+/// Set the part of the root task's search tree below the range of matchings
+/// at the topmost level, and take the current position in it as the start of
+/// this run. This must be called after `CSearchable::Resume()`, if at all.
+/// \param fStart Start of the part, as a fraction of the root task.
+/// \param fShare Size of the part, as a fraction of the root task.
+
+void CSearchableBase::SetShare(const double fStart, const double fShare){
+  m_fStart = fStart;
+  m_fShare = fShare;
+  m_fOrigin = fStart + fShare*GetProgress();
+} //SetShare
+
+/// Get the part of the root task's search tree that this task covers in this
+/// run, that is, from where it started or resumed to the end of its range.
+/// \return Share of the root task, as a fraction of it.
+
+const double CSearchableBase::GetShare() const{
+  return m_fStart + m_fShare - m_fOrigin;
+} //GetShare
+
+/// Get the part of the root task's search tree that this task has done in
+/// this run, according to `CSearchable::GetProgress()`. This must only be
+/// called while the search is halted.
+/// \return Share of the root task done, as a fraction of it.
+
+const double CSearchableBase::GetShareDone() const{
+  return m_fStart + m_fShare*GetProgress() - m_fOrigin;
+} //GetShareDone
+
+/// Store the number of matchings in `m_nNumMatchings`, and make the range of
+/// matchings at the topmost level all of them.
+
+template<size_t N, size_t D, class T> CSearchable<N, D, T>::CSearchable(): Base(){
+  m_nNumMatchings = NumMatchings(N);
+  m_nLast = m_nNumMatchings;
 } //constructor
 
 /// Save a generated sorting network into a file with a suitable name.
@@ -39,124 +75,455 @@ CSearchable::CSearchable(): C1NF(){
 /// depth 5 that is the 20th sorting network found would be saved to file 
 /// `w8d5n20.txt`.
 
-void CSearchable::Save(){
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::Save(){
   std::string filename = 
-    "w" + std::to_string(m_nWidth) + 
-    "d" + std::to_string(m_nDepth) +
+    "w" + std::to_string(N) + 
+    "d" + std::to_string(D) +
     "n" + std::to_string(m_nCount) + ".txt"; 
 
-  CComparatorNetwork::Save(filename); //save to file with that name
+  CComparatorNetwork<N, D>::Save(filename); //save to file with that name
 } //Save
 
 /// Set top of stack `m_nToS` to the last level of the sorting network.
 
-void CSearchable::SetToS(){
-  m_nToS = (int)m_nDepth - 1;
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::SetToS(){
+  m_nToS = (int)D - 1;
 } //SetToS
 
 /// Process a comparator network, which means testing whether it sorts, and if
-/// it does, saving it to a file and incrementing a counter.
+/// it does, saving it to a file unless `m_bSave` is false and incrementing a
+/// counter.
+
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::Process(){
+  Derived* p = static_cast<Derived*>(this); //most derived class
+  m_cStats.CountSort();
+
+  if(p->Sorts()){ //if it sorts
+    if(m_bSave)
+      p->Save(); //save it
 
-void CSearchable::Process(){
-  if(Sorts()){ //if it sorts
-    Save(); //save it
     m_nCount++; //add 1 to the total
+    PROBE_FOUND(m_nCount);
   } //if
 } //Process
 
 /// Perform a backtracking search, assuming everything has been initialized in
-/// a suitable fashion.
+/// a suitable fashion. Between candidates, donate work if an idle thread has
+/// asked for it, and halt if the threads have been paused.
 
-void CSearchable::Search(){
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::Search(){
   bool unfinished = true; //assume we're not finished
 
   while(unfinished){ //until we're finished
-    Process(); //process the current comparator network, that is, see if it sorts
+    static_cast<Derived*>(this)->Process(); //process the current comparator network, that is, see if it sorts
+    m_nCandidates++;
+
+    if(m_pThreadManager){
+      if(m_bDonor && m_pThreadManager->Requested())
+        Donate(); //feed an idle thread
+
+      if(m_pThreadManager->Paused())
+        m_pThreadManager->Halt(); //wait while our state is saved
+    } //if
+
     unfinished = NextComparatorNetwork(); //get the next comparator network, we're finished if this function says so  
   } //while
 } //Search
 
+/// Claim a request for work from the thread manager and satisfy it by
+/// donating a new searchable sorting network made by `Split()`. If there is
+/// nothing left to donate, return the request and never try again, since
+/// the unexplored part of the search tree only gets smaller.
+
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::Donate(){
+  if(m_pThreadManager->Claim()){ //claimed a request
+    CSearchableBase* p = Split(); //work to donate
+
+    if(p)
+      m_pThreadManager->Donate(p);
+
+    else{ //nothing to donate
+      m_pThreadManager->Request(); //give the request back
+      m_bDonor = false;
+    } //else
+  } //if
+} //Donate
+
+/// Split off the back half of the unexplored matchings at the topmost level,
+/// that is, the ones after the current one in its range, into a new
+/// searchable sorting network of the most derived type that fixes the levels
+/// above it and descends from the same new task. If the current matching is
+/// the last one at the topmost level, make the next level the topmost level
+/// with all of its matchings after the current one unexplored, and try
+/// again. The topmost level is never made the last level that is enumerated.
+/// The part of the root task's search tree below the range, which
+/// `CSearchable::GetProgress()` measures progress through, shrinks to the
+/// subtree of the current matching when the topmost level moves down, and is
+/// divided between the two halves in proportion to their numbers of matchings.
+/// \return Pointer to the new searchable sorting network, or `nullptr` if
+/// there is nothing to donate.
+
+template<size_t N, size_t D, class T>
+CSearchableBase* CSearchable<N, D, T>::Split(){
+  static_cast<Derived*>(this)->SetToS(); //set top of stack
+  const size_t nBottom = (size_t)m_nToS; //last level enumerated
+
+  while(m_nTop < nBottom && (size_t)m_nStack[m_nTop] + 1 >= m_nLast){ //nothing left at the topmost level
+    m_fShare /= m_nLast - m_nFirst; //the subtree of the current matching
+    m_fStart += m_fShare*(m_nStack[m_nTop] - m_nFirst);
+    m_nTop++; //next level becomes the topmost
+    m_nFirst = 0; //with all of its matchings in range
+    m_nLast = m_nNumMatchings;
+  } //while
+
+  if(m_nTop >= nBottom)
+    return nullptr; //only the last level enumerated is left
+
+  const size_t n = m_nLast - m_nStack[m_nTop] - 1; //number of unexplored matchings
+  const size_t first = m_nLast - (n + 1)/2; //first one to donate
+
+  CPrefix<N> prefix; //the levels above the topmost
+
+  for(size_t i=1; i<m_nTop; i++)
+    prefix.Append(m_nComparator[i]);
+
+  CSearchableBase* p = new Derived(prefix, m_pThreadManager->GetTaskIndex(),
+    first, m_nLast);
+  p->SetRoot(m_nRoot); //descended from the same new task
+
+  const double fShare = m_fShare*(m_nLast - first)/(m_nLast - m_nFirst); //part of the root task donated
+  m_fShare -= fShare;
+  p->SetShare(m_fStart + m_fShare, fShare);
+
+  m_nLast = first; //keep the front half
+
+  return p;
+} //Split
+
 /// Initialize and then start a backtracking search for all sorting networks
 /// of given width and depth.
 
-void CSearchable::Backtrack(){
+template<size_t N, size_t D, class T> void CSearchable<N, D, T>::Backtrack(){
   m_nCount = 0; //we've found none so far
-  FirstComparatorNetwork(1); //assuming first normal form here
-  Search(); //perform the search
+
+  if(FirstComparatorNetwork(1)) //assuming first normal form here
+    Search(); //perform the search
 } //Backtrack
 
 /// Set to first comparator network from some given level down to the bottom.
+/// The topmost level is restricted to the range of matchings from `m_nFirst`
+/// to `m_nLast`, which may be empty, or contain only matchings that are to be
+/// skipped. The identity matching at the other levels is never skipped.
 /// \param toplevel Top level of comparator network we are constructing here.
+/// \return false if there is no first comparator network.
 
-void CSearchable::FirstComparatorNetwork(size_t toplevel){
+template<size_t N, size_t D, class T>
+bool CSearchable<N, D, T>::FirstComparatorNetwork(size_t toplevel){
   m_nTop = (int)toplevel; //save value of toplevel for later use
+  m_bStarted = true;
+
+  for(size_t i=toplevel; i<D; i++) //for each level in range
+    if(!InitMatchingRepresentations(i)) //initialize both matching representations
+      return false;
 
-  for(size_t i=toplevel; i<m_nDepth; i++) //for each level in range
-    InitMatchingRepresentations(i); //initialize both matching representations
+  return true;
 } //FirstComparatorNetwork
 
-/// Synchronize m_nComparator to m_cMatching at a given level. The latter is 
-/// assumed to be correct.
+/// Synchronize m_nComparator to the matching in `CMatchingTable` whose index
+/// is on the stack at a given level. The latter is assumed to be correct.
 /// \param level The level at which to synchronize matchings.
 
-void CSearchable::SynchMatchingRepresentations(size_t level){
-  for(size_t j=0; j<m_nWidth; j+=2){ //for each pair of channels
-    size_t x = m_cMatching[level][j]; //channel at left end of comparator
-    size_t y = m_cMatching[level][j + 1]; //channel at the other end
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::SynchMatchingRepresentations(size_t level){
+  m_cBitSlice.Invalidate(level); //cached bit-sliced outputs are out of date
 
-    if(y == m_nWidth) //if the rightmost channel is the last one in a comparator network with an odd number of inputs
-      m_nComparator[level][x] = x; //it's empty
+  if(m_pLevelTable) //cached level table outputs too, and the new transfer table
+    m_pLevelTable->Invalidate(level, m_nStack[level]);
 
-    else{ //make the testable representation
-      m_nComparator[level][x] = y; //x goes to y
-      m_nComparator[level][y] = x; //y goes to x
-    } //else
-  } //for
+  const uint8_t* comparator = CMatchingTable<N>::GetComparators(m_nStack[level]);
+
+  for(size_t j=0; j<N; j++) //copy the testable representation
+    m_nComparator[level][j] = comparator[j];
 } //SynchMatchingRepresentations
 
-/// Initialize m_nComparator and m_cMatching to the first matching at a given level.
+/// Initialize m_nComparator and the stack to the first matching at a given
+/// level, which is the identity matching, or at the topmost level the first
+/// one in its range, or if it is to be skipped, the first matching that is not.
 /// \param level The level at which to initialize matchings.
+/// \return false if every matching at that level is to be skipped.
 
-void CSearchable::InitMatchingRepresentations(size_t level){
-  m_cMatching[level].Initialize();  //initialize the generatable form
-  m_nStack[level] = 0; //and its stack
-
-  for(size_t j=0; j<m_nWidth; j++) //initialize the testable form
-    m_nComparator[level][j] = j^1;
+template<size_t N, size_t D, class T>
+bool CSearchable<N, D, T>::InitMatchingRepresentations(size_t level){
+  const size_t first = level == m_nTop? m_nFirst: 0; //index of first matching
+  m_nStack[level] = (int)first - 1; //just before it
 
-  if(odd(m_nWidth)) //one extra one if n is odd
-    m_nComparator[level][m_nWidth - 1] = m_nWidth - 1;
+  return NextMatching(level); //advance to the first one that isn't skipped
 } //InitMatchingRepresentations
 
+/// Advance a level to the next matching in `CMatchingTable`, if there is one,
+/// skipping the ones that `Skip()` says should be skipped. At the topmost
+/// level only the matchings before `m_nLast` are used.
+/// \param level The level to advance.
+/// \return true if there was a next matching.
+
+template<size_t N, size_t D, class T>
+bool CSearchable<N, D, T>::NextMatching(size_t level){
+  const size_t last = level == m_nTop? m_nLast: m_nNumMatchings; //end of range
+
+  while(++m_nStack[level] < (int)last) //for each remaining matching
+    if(!static_cast<Derived*>(this)->Skip(level)){ //found one
+      m_cStats.CountVisit(level);
+      SynchMatchingRepresentations(level);
+      return true;
+    } //if
+
+  return false; //no more matchings at this level
+} //NextMatching
+
+/// Check whether the matching on the stack at a given level should be
+/// skipped, that is, if pruning, whether it repeats a comparator from the
+/// level above. Skipped matchings are counted in `m_nPruned`.
+/// \param level A level whose predecessors are synchronized.
+/// \return true if the matching should be skipped.
+
+template<size_t N, size_t D, class T>
+bool CSearchable<N, D, T>::Skip(size_t level){
+  if(m_bPrune && level > 0 && Repeats(level)){
+    m_nPruned[level]++;
+    return true;
+  } //if
+
+  return false;
+} //Skip
+
+/// Check whether the matching on the stack at a given level shares a
+/// comparator with the level above, which must be synchronized.
+/// \param level A level other than the first.
+/// \return true if the matching repeats a comparator.
+
+template<size_t N, size_t D, class T>
+bool CSearchable<N, D, T>::Repeats(size_t level) const{
+  const uint8_t* comparator = CMatchingTable<N>::GetComparators(m_nStack[level]);
+
+  for(size_t j=0; j<N; j++) //for each channel
+    if(comparator[j] != j && comparator[j] == m_nComparator[level - 1][j])
+      return true; //same comparator on this channel
+
+  return false;
+} //Repeats
+
 /// Change to next comparator network. This implementation uses a stack in the
-/// standard way to remove the need for recursion.
+/// standard way to remove the need for recursion. The levels below the one
+/// that advanced are initialized after it has, since which of their matchings
+/// are pruned depends on it.
 /// \return false if there are no more comparator networks.
 
-bool CSearchable::NextComparatorNetwork(){
-  SetToS(); //set top of stack
+template<size_t N, size_t D, class T> bool CSearchable<N, D, T>::NextComparatorNetwork(){
+  static_cast<Derived*>(this)->SetToS(); //set top of stack
+  const int nBottom = m_nToS; //lowest level on the stack
 
-  m_nStack[m_nToS]++;
+  while((m_nToS >= m_nTop) && !NextMatching(m_nToS)) //pop exhausted levels
+    m_nToS--;
 
-  if(m_cMatching[m_nToS].Next())
-    SynchMatchingRepresentations(m_nToS);
+  if(m_nToS < m_nTop)
+    return false; //there are no more if we blow the top of the stack
 
-  while((m_nToS >= m_nTop) && (m_nStack[m_nToS] == m_nNumMatchings)){
-    InitMatchingRepresentations(m_nToS);
+  PROBE_LEVEL(m_nToS, m_nStack[m_nToS]);
 
-    if(--m_nToS >= m_nTop){
-      m_nStack[m_nToS]++;
+  for(int i=m_nToS+1; i<=nBottom; i++) //restart the levels below
+    InitMatchingRepresentations(i);
 
-      if(m_nStack[m_nToS] < m_nNumMatchings && m_cMatching[m_nToS].Next())
-        SynchMatchingRepresentations(m_nToS);
-    } //if
-  } //while
-
-  return m_nToS >= m_nTop; //there are no more if we blow the top of the stack
+  return true;
 } //NextComparatorNetwork
 
 /// Reader function for the number of sorting networks found.
 /// \return The number of sorting networks found.
 
-const size_t CSearchable::GetCount() const{
+template<size_t N, size_t D, class T> const size_t CSearchable<N, D, T>::GetCount() const{
   return m_nCount;
 } //GetCount
+
+/// Add the counters from the counterexample caches to those in another cache.
+/// \param c [in, out] Cache whose counters are to be added to.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::GetWitnessStats(CWitnessCache& c) const{
+  c.Accumulate(m_cWitness);
+} //GetWitnessStats
+
+/// Add the number of matchings skipped at each level to an array of counters.
+/// \param p [in, out] Array of `MAXDEPTH` counters to be added to.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::GetPruneStats(size_t p[]) const{
+  for(size_t i=0; i<D; i++)
+    p[i] += m_nPruned[i];
+} //GetPruneStats
+
+/// Add the search statistics counters to another instance.
+/// \param c [in, out] Counters to be added to.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::GetStats(CStats& c) const{
+  c.Accumulate(m_cStats);
+} //GetStats
+
+/// Reader function for the number of candidates processed since this
+/// searchable sorting network was constructed.
+/// \return The number of candidates processed.
+
+template<size_t N, size_t D, class T>
+const size_t CSearchable<N, D, T>::GetCandidates() const{
+  return m_nCandidates;
+} //GetCandidates
+
+/// Estimate the fraction of the search that has been done from the position
+/// of the stack, reading the index of the matching at each level from the
+/// topmost level down to the last level enumerated as a digit of a mixed
+/// radix fraction, as if the matchings at each level had subtrees of the
+/// same size. This must only be called while the search is halted.
+/// \return Fraction of the search done, from 0 to 1.
+
+template<size_t N, size_t D, class T>
+const double CSearchable<N, D, T>::GetProgress() const{
+  if(!m_bStarted)
+    return 0; //not started yet
+
+  double fDone = 0; //fraction done
+  double fWeight = 1; //fraction of the search below one matching at this level
+
+  for(size_t i=m_nTop; (int)i<=m_nToS; i++){ //for each level enumerated
+    const size_t first = i == m_nTop? m_nFirst: 0; //index of first matching
+    const size_t last = i == m_nTop? m_nLast: m_nNumMatchings; //end of range
+
+    if(last <= first)
+      break; //empty range
+
+    fWeight /= last - first;
+    fDone += fWeight*std::max(m_nStack[i] - (int)first, 0);
+  } //for
+
+  return std::min(fDone, 1.0);
+} //GetProgress
+
+/// Save the resumable state, that is, the number of sorting networks found,
+/// whether the search has started and if so the stack from the topmost level
+/// down, and the number of matchings pruned at each level, as numbers
+/// separated by spaces with a leading space. This must only be called while
+/// the search is halted or before it starts.
+/// \param s [out] Stream to save to.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::Checkpoint(std::ostream& s) const{
+  s << " " << m_nCount << " " << m_bStarted;
+
+  if(m_bStarted)
+    for(size_t i=m_nTop; i<D; i++)
+      s << " " << m_nStack[i];
+
+  for(size_t i=0; i<D; i++)
+    s << " " << m_nPruned[i];
+} //Checkpoint
+
+/// Restore the resumable state saved by `CSearchable::Checkpoint()` into a
+/// searchable sorting network that has been constructed with the same
+/// topmost level and range. If the search had started, synchronize the levels
+/// down to the last level enumerated and initialize the ones below them,
+/// which the search does not change, so that
+/// `CSearchable::NextComparatorNetwork()` moves on to the candidate after the
+/// one that was processed last.
+/// \param s [in, out] Stream to restore from.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::Resume(std::istream& s){
+  s >> m_nCount >> m_bStarted;
+
+  if(m_bStarted){
+    static_cast<Derived*>(this)->SetToS(); //set top of stack
+
+    for(size_t i=m_nTop; i<D; i++){ //for each level from the topmost down
+      s >> m_nStack[i];
+
+      if((int)i <= m_nToS) //enumerated
+        SynchMatchingRepresentations(i);
+      else InitMatchingRepresentations(i);
+    } //for
+  } //if
+
+  for(size_t i=0; i<D; i++)
+    s >> m_nPruned[i];
+} //Resume
+
+/// Make one of Knuth's random probes of the search tree. Starting at the
+/// topmost level, choose one of the matchings that are not skipped uniformly
+/// at random at each level down to the last level enumerated, multiplying
+/// together the numbers of choices. The root, where the topmost level has
+/// yet to be chosen, counts as a node. Then initialize the levels below as the
+/// search does, and time the processing of the resulting candidate with
+/// saving turned off. Add the estimated numbers of nodes and candidates and
+/// the estimated time to an estimate. A probe that reaches a level where
+/// every matching is skipped estimates that there are no candidates below it.
+/// The time taken to enumerate the matchings is ignored, since it is small
+/// compared to the time taken by the sorting test.
+/// \param r [in, out] Pseudo-random number generator.
+/// \param e [in, out] Estimate to add the result of the probe to.
+
+template<size_t N, size_t D, class T>
+void CSearchable<N, D, T>::Probe(std::mt19937_64& r, CEstimate& e){
+  Derived* p = static_cast<Derived*>(this); //most derived class
+  p->SetToS(); //set top of stack
+
+  double fWeight = 1; //number of nodes that the current one stands for
+  double fNodes = 1; //estimated number of nodes, counting the root
+  std::vector<int> children; //matchings that are not skipped
+
+  for(size_t i=m_nTop; (int)i<=m_nToS; i++){ //for each level enumerated
+    const size_t first = i == m_nTop? m_nFirst: 0; //index of first matching
+    const size_t last = i == m_nTop? m_nLast: m_nNumMatchings; //end of range
+    children.clear();
+
+    for(size_t j=first; j<last; j++){ //for each matching in range
+      m_nStack[i] = (int)j;
+
+      if(!p->Skip(i))
+        children.push_back((int)j);
+    } //for
+
+    if(children.empty()){ //dead end
+      e.Add(fNodes, 0, 0);
+      return;
+    } //if
+
+    fWeight *= children.size();
+    fNodes += fWeight;
+
+    std::uniform_int_distribution<size_t> choose(0, children.size() - 1);
+    m_nStack[i] = children[choose(r)];
+    SynchMatchingRepresentations(i);
+  } //for
+
+  for(size_t i=std::max(m_nTop, (size_t)(m_nToS + 1)); i<D; i++) //levels below
+    if(!InitMatchingRepresentations(i)){ //every matching is skipped
+      e.Add(fNodes, 0, 0);
+      return;
+    } //if
+
+  m_bSave = false;
+
+  const std::chrono::steady_clock::time_point tStart =
+    std::chrono::steady_clock::now(); //start of sorting test
+  p->Process(); //test candidate
+  const std::chrono::duration<double> tElapsed =
+    std::chrono::steady_clock::now() - tStart; //time taken
+
+  e.Add(fNodes, fWeight, fWeight*tElapsed.count());
+} //Probe
+
+//explicit instantiation for every width and depth, and every class derived from it
+
+#define INSTANTIATE(n, d) \
+  template class CSearchable<n, d, C2NF<n, d>>; \
+  template class CSearchable<n, d, CAutocomplete<n, d>>; \
+  template class CSearchable<n, d, CNearsort<n, d>>; \
+  template class CSearchable<n, d, CNearsort2<n, d>>;
+FOR_EACH_SHAPE(INSTANTIATE)
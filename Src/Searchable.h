@@ -26,36 +26,153 @@
 #ifndef __Searchable_h__
 #define __Searchable_h__
 
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "1NF.h"
 
 #include "Defines.h"
-#include "Matching.h"
+#include "Estimate.h"
+#include "MatchingTable.h"
+
+class CThreadManager;
+
+/// \brief Searchable sorting network interface.
+///
+/// The width and depth are template parameters of `CSearchable` and
+/// everything derived from it, so the tasks in the thread manager see only
+/// this interface, which does not depend on them.
+
+class CSearchableBase{
+  protected:
+    CThreadManager* m_pThreadManager = nullptr; ///< Thread manager to donate work to, if any.
+    size_t m_nRoot = 0; ///< Index of the new task that this one was split off, or its own index if it is one.
+    double m_fStart = 0; ///< Start of the part of the root task's search tree below the range at the topmost level, as a fraction of it.
+    double m_fShare = 1; ///< Size of that part, as a fraction of the root task's search tree.
+    double m_fOrigin = 0; ///< Position in the root task's search tree when this task was made or resumed, as a fraction of it.
+    bool m_bKeep = false; ///< Whether to keep the sorting networks found in memory instead of saving them to files.
+    std::vector<std::string> m_stlNetworks; ///< Sorting networks found, if kept in memory.
+
+  public:
+    virtual ~CSearchableBase(){} ///< Virtual destructor.
+
+    void SetThreadManager(CThreadManager* p){m_pThreadManager = p;} ///< Set thread manager.
+    void SetRoot(const size_t n){m_nRoot = n;} ///< Set root task index.
+    const size_t GetRoot() const{return m_nRoot;} ///< Get root task index.
+    void SetShare(const double, const double); ///< Set part of root task.
+    const double GetShare() const; ///< Get share of root task in this run.
+    const double GetShareDone() const; ///< Get share of root task done in this run.
+    void KeepNetworks(){m_bKeep = true;} ///< Keep sorting networks found in memory.
+    const std::vector<std::string>& GetNetworks() const{return m_stlNetworks;} ///< Get sorting networks kept in memory.
+
+    virtual void Backtrack() = 0; ///< Backtracking search.
+    virtual const size_t GetCount() const = 0; ///< Get count.
+    virtual void GetWitnessStats(CWitnessCache&) const = 0; ///< Add up counterexample cache counters.
+    virtual void GetPruneStats(size_t[]) const = 0; ///< Add up pruning counters.
+    virtual void GetStats(CStats&) const = 0; ///< Add up search statistics counters.
+    virtual const size_t GetIndex() const = 0; ///< Get task index.
+    virtual const size_t GetCandidates() const = 0; ///< Get number of candidates processed.
+    virtual const double GetProgress() const = 0; ///< Get fraction of search done.
+
+    virtual void Checkpoint(std::ostream&) const = 0; ///< Save resumable state.
+    virtual void Resume(std::istream&) = 0; ///< Restore resumable state.
+
+    virtual void Probe(std::mt19937_64&, CEstimate&) = 0; ///< Random probe of the search tree.
+}; //CSearchableBase
 
 /// \brief Searchable sorting network.
 ///
 /// The searchable sorting network class will perform a backtracking search
 /// for a sorting network of a given depth and number of inputs.
-
-class CSearchable: public C1NF{
+/// The functions that its descendants override are called through
+/// `MostDerived`, so that `CSearchable::Search()` is compiled separately for
+/// each of them with the sorting test inlined. The matching at each level is
+/// an index into the shared table of all matchings in `CMatchingTable`.
+///
+/// A comparator that appears in two consecutive levels can never swap anything
+/// the second time. If `CSettings::m_bPrune` is true, then the matchings
+/// that repeat a comparator from the level above are skipped, and the
+/// number skipped at each level is counted in `CSearchable::m_nPruned`.
+///
+/// When an idle thread asks the thread manager for work, a busy searchable
+/// sorting network splits off the back half of the unexplored matchings at
+/// its topmost level and donates them as a new task with the levels above it
+/// fixed. When only the current matching is left at the topmost level, it
+/// becomes fixed and the level below it becomes the topmost level. Only whole
+/// subtrees are donated, never the matchings at the last level enumerated.
+///
+/// Between candidates the search halts if the thread manager has paused the
+/// threads, so that its state can be saved by `CSearchable::Checkpoint()`.
+/// That state is the number of sorting networks found, the number of
+/// matchings pruned, and, if the search has started, the index of the
+/// matching at each level from the topmost down to the last level enumerated
+/// in the candidate that was processed last. A searchable sorting network
+/// that is given this state by `CSearchable::Resume()` carries on from the
+/// candidate after it.
+///
+/// The number of candidates processed and the position of the stack, as a
+/// fraction of the search tree, can be read with
+/// `CSearchable::GetCandidates()` and `CSearchable::GetProgress()` while the
+/// search is halted, to report the progress of a long search. So that the
+/// tasks split off a new task add up to it, each also keeps the part of the
+/// new task's search tree below its range, which `CSearchable::Split()`
+/// divides between the two halves.
+///
+/// Instead of searching, `CSearchable::Probe()` follows a random path down
+/// the search tree to a candidate and times the sorting test on it, without
+/// saving any sorting networks, to estimate the size of the search tree and
+/// the time that it will take to search (see `CEstimate`).
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam T Most derived class, or `void` if it is this one.
+
+template<size_t N, size_t D, class T = void>
+class CSearchable:
+  public C1NF<N, D, MostDerived<T, CSearchable<N, D, T>>>,
+  public CSearchableBase
+{
   protected:  
-    size_t m_nCount = 0; ///< Number of comparator networks found that sort.
+    typedef MostDerived<T, CSearchable> Derived; ///< Most derived class.
+    typedef C1NF<N, D, Derived> Base; ///< Base class.
 
-    CMatching m_cMatching[MAXDEPTH]; ///< Matchings that make up comparator network in a form that makes searching faster. 
+    using Base::m_nComparator;
+    using Base::m_cBitSlice;
+    using Base::m_pLevelTable;
+    using Base::m_cWitness;
+    using Base::m_cStats;
+    using Base::m_bPrune;
 
-    int m_nStack[MAXDEPTH] = {0}; ///< Stack to remove recursion from search.
+    size_t m_nCount = 0; ///< Number of comparator networks found that sort.
+    size_t m_nCandidates = 0; ///< Number of candidates processed.
+
+    int m_nStack[D] = {0}; ///< Stack to remove recursion from search, holding the index of the matching at each level in `CMatchingTable`.
     int m_nToS = 0; ///< Top of stack.
 
     size_t m_nNumMatchings = 0; ///< Number of matchings of this size.
     size_t m_nTop = 0; ///< Topmost level.
-
-    void FirstComparatorNetwork(size_t); ///< Set to first comparator network.
+    size_t m_nFirst = 0; ///< Index of first matching at the topmost level.
+    size_t m_nLast = 0; ///< One more than the index of the last matching at the topmost level.
+    size_t m_nPruned[D] = {0}; ///< Number of matchings skipped at each level.
+    bool m_bDonor = true; ///< Whether there may be work left to donate.
+    bool m_bStarted = false; ///< Whether the search has started.
+    bool m_bSave = true; ///< Whether to save the sorting networks found.
+
+    bool FirstComparatorNetwork(size_t); ///< Set to first comparator network.
     bool NextComparatorNetwork(); ///< Change to next comparator network.
     void SynchMatchingRepresentations(size_t); ///< Synchronize the two different matching representations.
-    void InitMatchingRepresentations(size_t); ///< Initialize the two different matching representations.
+    bool InitMatchingRepresentations(size_t); ///< Initialize the two different matching representations.
+    bool NextMatching(size_t); ///< Advance a level to its next matching.
+    bool Repeats(size_t) const; ///< Does a matching repeat a comparator from the level above?
+    bool Skip(size_t); ///< Should a matching be skipped?
+    void Donate(); ///< Donate work to an idle thread.
+    CSearchableBase* Split(); ///< Split off unexplored matchings at the topmost level.
 
-    virtual void Save(); ///< Save comparator network.
-    virtual void SetToS(); ///< Set top of stack.
-    virtual void Process(); ///< Process a candidate comparator network.
+    void Save(); ///< Save comparator network.
+    void SetToS(); ///< Set top of stack.
+    void Process(); ///< Process a candidate comparator network.
 
     void Search(); ///< Do the actual search.
 
@@ -65,6 +182,16 @@ class CSearchable: public C1NF{
     virtual void Backtrack(); ///< Backtracking search.
 
     const size_t GetCount() const; ///< Get count.
+    virtual void GetWitnessStats(CWitnessCache&) const; ///< Add up counterexample cache counters.
+    virtual void GetPruneStats(size_t[]) const; ///< Add up pruning counters.
+    virtual void GetStats(CStats&) const; ///< Add up search statistics counters.
+    virtual const size_t GetCandidates() const; ///< Get number of candidates processed.
+    virtual const double GetProgress() const; ///< Get fraction of search done.
+
+    virtual void Checkpoint(std::ostream&) const; ///< Save resumable state.
+    virtual void Resume(std::istream&); ///< Restore resumable state.
+
+    virtual void Probe(std::mt19937_64&, CEstimate&); ///< Random probe of the search tree.
 }; //CSearchable
 
 #endif //__Searchable_h__
\ No newline at end of file
@@ -27,6 +27,13 @@
 
 size_t CSettings::m_nWidth = 9;
 size_t CSettings::m_nDepth = 6;
+eEngine CSettings::m_eEngine = eEngine::GrayCode;
+eKernel CSettings::m_eKernel = DetectKernel();
+bool CSettings::m_bPrune = false;
+bool CSettings::m_bReflect = false;
+bool CSettings::m_bSymmetry = false;
+size_t CSettings::m_nSubsumeLevel = 0;
+size_t CSettings::m_nSplitLevel = 0;
 
 /// Set the width.
 /// \param w Width.
@@ -42,3 +49,72 @@ void CSettings::SetDepth(const size_t d){
   m_nDepth = d;
 } //SetDepth
 
+/// Set the sorting test engine.
+/// \param e Sorting test engine.
+ 
+void CSettings::SetEngine(const eEngine e){
+  m_eEngine = e;
+} //SetEngine
+
+/// Set the kernel instruction set used by the bit-sliced sorting test, which
+/// must be supported by this CPU. The default is the widest one that is.
+/// \param k Kernel instruction set.
+ 
+void CSettings::SetKernel(const eKernel k){
+  m_eKernel = k;
+} //SetKernel
+
+/// Set whether to skip matchings that repeat a comparator from the level above.
+/// \param b true to prune repeated comparators.
+ 
+void CSettings::SetPrune(const bool b){
+  m_bPrune = b;
+} //SetPrune
+
+/// Set whether second level candidates are reduced by reflection as well as
+/// by permutations of pairs of channels.
+/// \param b true to reduce by reflection.
+ 
+void CSettings::SetReflect(const bool b){
+  m_bReflect = b;
+} //SetReflect
+
+/// Set whether third levels that a symmetry of the first two levels maps to
+/// smaller ones are skipped.
+/// \param b true to skip symmetric third levels.
+ 
+void CSettings::SetSymmetry(const bool b){
+  m_bSymmetry = b;
+} //SetSymmetry
+
+/// Set the level down to which prefixes are filtered by subsumption.
+/// \param k Level, or 0 for no filtering.
+ 
+void CSettings::SetSubsumeLevel(const size_t k){
+  m_nSubsumeLevel = k;
+} //SetSubsumeLevel
+
+/// Set the level down to which prefixes are extended, so that each task
+/// fixes that many levels.
+/// \param k Level, or 0 for no extension beyond the subsumption filter level.
+ 
+void CSettings::SetSplitLevel(const size_t k){
+  m_nSplitLevel = k;
+} //SetSplitLevel
+
+/// Get the name of the file for a sorting network found by a task, which
+/// encodes the width, depth, task index, and order found. For example, an
+/// 8-input sorting network of depth 5 that is the 20th found by the task with
+/// index 99 is saved to file `w8d5x99n20.txt`.
+/// \param n Width.
+/// \param d Depth.
+/// \param index Task index.
+/// \param i Number of sorting networks found by the task before this one.
+/// \return File name.
+
+std::string CSettings::GetFileName(const size_t n, const size_t d,
+  const size_t index, const size_t i)
+{
+  return "w" + std::to_string(n) + "d" + std::to_string(d) +
+    "x" + std::to_string(index) + "n" + std::to_string(i) + ".txt";
+} //GetFileName
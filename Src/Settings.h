@@ -26,6 +26,21 @@
 #ifndef __Settings_h__
 #define __Settings_h__
 
+#include <cstddef>
+#include <string>
+
+#include "Kernel.h"
+
+/// \brief Sorting test engine.
+///
+/// The algorithm used to test whether a candidate comparator network sorts.
+
+enum class eEngine{
+  GrayCode, ///< One test input at a time in Gray code order.
+  BitSlice, ///< All test inputs at once, one bit per input on each channel.
+  Table ///< One test input at a time through precomputed level transfer tables.
+}; //eEngine
+
 /// \brief The common variables class.
 ///
 /// A singleton class that encapsulates things that are common to
@@ -38,10 +53,27 @@ class CSettings{
   protected:
     static size_t m_nWidth; ///< Comparator network width.
     static size_t m_nDepth; ///< Comparator network depth.
+    static eEngine m_eEngine; ///< Sorting test engine.
+    static eKernel m_eKernel; ///< Bit-sliced sorting test kernel instruction set.
+    static bool m_bPrune; ///< Skip matchings that repeat a comparator from the level above.
+    static bool m_bReflect; ///< Reduce second level candidates by reflection too.
+    static bool m_bSymmetry; ///< Skip third levels that a symmetry of the first two maps to smaller ones.
+    static size_t m_nSubsumeLevel; ///< Filter prefixes by subsumption down to this level, or 0 for none.
+    static size_t m_nSplitLevel; ///< Extend prefixes without filtering down to this level, or 0 for none.
 
   public:
     static void SetWidth(const size_t); ///< Set width.
     static void SetDepth(const size_t); ///< Set depth.
+    static void SetEngine(const eEngine); ///< Set sorting test engine.
+    static void SetKernel(const eKernel); ///< Set bit-sliced sorting test kernel.
+    static void SetPrune(const bool); ///< Set whether to prune repeated comparators.
+    static void SetReflect(const bool); ///< Set whether to reduce second levels by reflection.
+    static void SetSymmetry(const bool); ///< Set whether to skip symmetric third levels.
+    static void SetSubsumeLevel(const size_t); ///< Set subsumption filter level.
+    static void SetSplitLevel(const size_t); ///< Set task split level.
+
+    static std::string GetFileName(const size_t, const size_t, const size_t,
+      const size_t); ///< Get name of file for a sorting network found by a task.
 }; //CSettings
 
 #endif
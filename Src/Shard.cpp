@@ -0,0 +1,175 @@
+/// \file Shard.cpp
+/// \brief Code for the shard result `CShard`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Shard.h"
+
+/// Default constructor, for a shard result that is to be loaded.
+
+CShard::CShard(){
+} //constructor
+
+/// Constructor.
+/// \param i Shard number.
+/// \param k Number of shards.
+/// \param strSettings Settings line.
+/// \param nTasks Number of tasks in the whole search.
+/// \param covered Indices of tasks covered.
+/// \param nCount Number of sorting networks found.
+/// \param fElapsed Elapsed time in seconds.
+/// \param fCPU CPU time in seconds.
+
+CShard::CShard(const size_t i, const size_t k, const std::string& strSettings,
+  const size_t nTasks, const std::vector<size_t>& covered, const size_t nCount,
+  const double fElapsed, const double fCPU):
+  m_nShard(i),
+  m_nNumShards(k),
+  m_strSettings(strSettings),
+  m_nNumTasks(nTasks),
+  m_stlCovered(covered),
+  m_nCount(nCount),
+  m_fElapsed(fElapsed),
+  m_fCPU(fCPU)
+{
+} //constructor
+
+/// Save to a text file, one keyword and its values per line. The list of
+/// task indices is preceded by its length.
+/// \param strFile File name.
+/// \return true if the file was written.
+
+bool CShard::Save(const std::string& strFile) const{
+  std::ofstream f(strFile);
+
+  f << "shard " << m_nShard << " " << m_nNumShards << std::endl;
+  f << m_strSettings << std::endl;
+  f << "tasks " << m_nNumTasks << std::endl;
+  f << "covered " << m_stlCovered.size();
+
+  for(const size_t i: m_stlCovered)
+    f << " " << i;
+
+  f << std::endl;
+  f << "count " << m_nCount << std::endl;
+  f << std::fixed << std::setprecision(2);
+  f << "elapsed " << m_fElapsed << std::endl;
+  f << "cpu " << m_fCPU << std::endl;
+
+  return !f.fail();
+} //Save
+
+/// Load from a text file saved by `CShard::Save()`.
+/// \param strFile File name.
+/// \return true if the file was read and is well formed.
+
+bool CShard::Load(const std::string& strFile){
+  std::ifstream f(strFile);
+  std::string strTag[6]; //line tags
+  size_t n = 0; //number of task indices
+
+  f >> strTag[0] >> m_nShard >> m_nNumShards >> std::ws;
+  std::getline(f, m_strSettings);
+  f >> strTag[1] >> m_nNumTasks >> strTag[2] >> n;
+
+  m_stlCovered.resize(n);
+
+  for(size_t& i: m_stlCovered)
+    f >> i;
+
+  f >> strTag[3] >> m_nCount >> strTag[4] >> m_fElapsed >> strTag[5] >> m_fCPU;
+
+  return !f.fail() && strTag[0] == "shard" && strTag[1] == "tasks" &&
+    strTag[2] == "covered" && strTag[3] == "count" && strTag[4] == "elapsed" &&
+    strTag[5] == "cpu" && m_nShard < m_nNumShards;
+} //Load
+
+/// Get the name of the file for a shard result, for example `shard-2-of-8.txt`
+/// for shard 2 of 8.
+/// \param i Shard number.
+/// \param k Number of shards.
+/// \return File name.
+
+std::string CShard::GetFileName(const size_t i, const size_t k){
+  return "shard-" + std::to_string(i) + "-of-" + std::to_string(k) + ".txt";
+} //GetFileName
+
+/// Reader function for the shard number.
+/// \return The shard number.
+
+const size_t CShard::GetShard() const{
+  return m_nShard;
+} //GetShard
+
+/// Reader function for the number of shards.
+/// \return The number of shards.
+
+const size_t CShard::GetNumShards() const{
+  return m_nNumShards;
+} //GetNumShards
+
+/// Reader function for the settings line.
+/// \return The settings line.
+
+const std::string& CShard::GetSettings() const{
+  return m_strSettings;
+} //GetSettings
+
+/// Reader function for the number of tasks in the whole search.
+/// \return The number of tasks.
+
+const size_t CShard::GetNumTasks() const{
+  return m_nNumTasks;
+} //GetNumTasks
+
+/// Reader function for the indices of the tasks covered by this shard.
+/// \return The task indices.
+
+const std::vector<size_t>& CShard::GetCovered() const{
+  return m_stlCovered;
+} //GetCovered
+
+/// Reader function for the number of sorting networks found.
+/// \return The count.
+
+const size_t CShard::GetCount() const{
+  return m_nCount;
+} //GetCount
+
+/// Reader function for the elapsed time.
+/// \return The elapsed time in seconds.
+
+const double CShard::GetElapsedSeconds() const{
+  return m_fElapsed;
+} //GetElapsedSeconds
+
+/// Reader function for the CPU time.
+/// \return The CPU time in seconds.
+
+const double CShard::GetCPUSeconds() const{
+  return m_fCPU;
+} //GetCPUSeconds
@@ -0,0 +1,77 @@
+/// \file Shard.h
+/// \brief Header for the shard result `CShard`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Shard_h__
+#define __Shard_h__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// \brief Shard result.
+///
+/// The tasks of a search can be divided between \f$k\f$ independent
+/// processes, called _shards_. Tasks are numbered in the order in which they
+/// are created from the prefixes, which does not depend on the number of
+/// threads, and shard \f$i\f$ takes the tasks whose indices are congruent to
+/// \f$i\f$ modulo \f$k\f$. Each shard saves its result with `CShard::Save()`
+/// to a text file with one keyword and its values on each line: the shard
+/// number and number of shards, the settings, the number of tasks in the
+/// whole search, the indices of the tasks it covered, the number of sorting
+/// networks found, and the elapsed and CPU times in seconds. The results are
+/// read back with `CShard::Load()` to be merged.
+
+class CShard{
+  private:
+    size_t m_nShard = 0; ///< Shard number.
+    size_t m_nNumShards = 1; ///< Number of shards.
+    std::string m_strSettings; ///< Settings line.
+    size_t m_nNumTasks = 0; ///< Number of tasks in the whole search.
+    std::vector<size_t> m_stlCovered; ///< Indices of tasks covered.
+    size_t m_nCount = 0; ///< Number of sorting networks found.
+    double m_fElapsed = 0; ///< Elapsed time in seconds.
+    double m_fCPU = 0; ///< CPU time in seconds.
+
+  public:
+    CShard(); ///< Default constructor.
+    CShard(const size_t, const size_t, const std::string&, const size_t,
+      const std::vector<size_t>&, const size_t, const double, const double); ///< Constructor.
+
+    bool Save(const std::string&) const; ///< Save to a file.
+    bool Load(const std::string&); ///< Load from a file.
+
+    static std::string GetFileName(const size_t, const size_t); ///< Get file name.
+
+    const size_t GetShard() const; ///< Get shard number.
+    const size_t GetNumShards() const; ///< Get number of shards.
+    const std::string& GetSettings() const; ///< Get settings line.
+    const size_t GetNumTasks() const; ///< Get number of tasks.
+    const std::vector<size_t>& GetCovered() const; ///< Get indices of tasks covered.
+    const size_t GetCount() const; ///< Get count.
+    const double GetElapsedSeconds() const; ///< Get elapsed time.
+    const double GetCPUSeconds() const; ///< Get CPU time.
+}; //CShard
+
+#endif //__Shard_h__
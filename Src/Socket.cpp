@@ -0,0 +1,306 @@
+/// \file Socket.cpp
+/// \brief Code for the TCP socket `CSocket`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+
+  #ifdef _MSC_VER
+    #pragma comment(lib, "Ws2_32.lib")
+  #endif //_MSC_VER
+
+  typedef int socklen_t; ///< Type of socket address lengths.
+  #define closesocket_(s) closesocket(s) ///< Close a socket.
+#else
+  #include <arpa/inet.h>
+  #include <netdb.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #include <sys/select.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+
+  typedef int SOCKET; ///< Type of socket handles.
+  #define INVALID_SOCKET (-1) ///< Invalid socket handle.
+  #define closesocket_(s) close(s) ///< Close a socket.
+#endif //_WIN32
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0 ///< No such flag here.
+#endif //MSG_NOSIGNAL
+
+#include <algorithm>
+
+#include "Socket.h"
+
+static const std::uintptr_t INVALID = (std::uintptr_t)INVALID_SOCKET; ///< Invalid socket handle.
+
+/// Constructor. The socket is not open.
+
+CSocket::CSocket():
+  m_nSocket(INVALID)
+{
+} //constructor
+
+/// Destructor. Close the socket if it is open.
+
+CSocket::~CSocket(){
+  Close();
+} //destructor
+
+/// Start up the socket library, which is only needed on Windows.
+/// \return true if it started up.
+
+bool CSocket::Startup(){
+  #ifdef _WIN32
+    WSADATA wsaData;
+    return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+  #else
+    return true;
+  #endif //_WIN32
+} //Startup
+
+/// Clean up the socket library, which is only needed on Windows.
+
+void CSocket::Cleanup(){
+  #ifdef _WIN32
+    WSACleanup();
+  #endif //_WIN32
+} //Cleanup
+
+/// Listen for connections on a port, either on every network interface or
+/// only on the loopback interface, so that only this machine can connect.
+/// \param nPort Port number.
+/// \param bLocal Whether to listen only on the loopback interface.
+/// \return true if listening.
+
+bool CSocket::Listen(const unsigned short nPort, const bool bLocal){
+  Close();
+
+  const SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+  if(s == INVALID_SOCKET)
+    return false;
+
+  const int nYes = 1; //for setting options
+  setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&nYes, sizeof(nYes));
+
+  sockaddr_in addr = {}; //address to listen on
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(bLocal? INADDR_LOOPBACK: INADDR_ANY);
+  addr.sin_port = htons(nPort);
+
+  if(bind(s, (const sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, 16) != 0){
+    closesocket_(s);
+    return false;
+  } //if
+
+  m_nSocket = (std::uintptr_t)s;
+  return true;
+} //Listen
+
+/// Accept a connection on a listening socket.
+/// \param c [out] Socket for the connection.
+/// \return true if a connection was accepted.
+
+bool CSocket::Accept(CSocket& c){
+  const SOCKET s = accept((SOCKET)m_nSocket, nullptr, nullptr);
+
+  if(s == INVALID_SOCKET)
+    return false;
+
+  const int nYes = 1; //for setting options
+  setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&nYes, sizeof(nYes));
+
+  c.Close();
+  c.m_nSocket = (std::uintptr_t)s;
+  return true;
+} //Accept
+
+/// Connect to a host.
+/// \param strHost Host name or address.
+/// \param strPort Port number.
+/// \return true if connected.
+
+bool CSocket::Connect(const std::string& strHost, const std::string& strPort){
+  Close();
+
+  addrinfo hints = {}; //kind of address wanted
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+
+  addrinfo* pResult = nullptr; //list of addresses
+
+  if(getaddrinfo(strHost.c_str(), strPort.c_str(), &hints, &pResult) != 0)
+    return false;
+
+  for(addrinfo* p=pResult; p && m_nSocket == INVALID; p=p->ai_next){ //for each address until connected
+    const SOCKET s = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+
+    if(s == INVALID_SOCKET)
+      continue;
+
+    if(connect(s, p->ai_addr, (socklen_t)p->ai_addrlen) == 0){
+      const int nYes = 1; //for setting options
+      setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&nYes, sizeof(nYes));
+      m_nSocket = (std::uintptr_t)s;
+    } //if
+
+    else closesocket_(s);
+  } //for
+
+  freeaddrinfo(pResult);
+
+  return m_nSocket != INVALID;
+} //Connect
+
+/// Close the socket if it is open, and discard anything not yet read.
+
+void CSocket::Close(){
+  if(m_nSocket != INVALID)
+    closesocket_((SOCKET)m_nSocket);
+
+  m_nSocket = INVALID;
+  m_strBuffer.clear();
+} //Close
+
+/// Check whether the socket is open.
+/// \return true if it is open.
+
+bool CSocket::IsOpen() const{
+  return m_nSocket != INVALID;
+} //IsOpen
+
+/// Send bytes, waiting until they have all been sent.
+/// \param s Bytes to send.
+/// \return true if they were sent.
+
+bool CSocket::Write(const std::string& s){
+  size_t nSent = 0; //number of bytes sent so far
+
+  while(nSent < s.size()){
+    const int n = send((SOCKET)m_nSocket, s.data() + nSent,
+      (int)(s.size() - nSent), MSG_NOSIGNAL);
+
+    if(n <= 0)
+      return false;
+
+    nSent += (size_t)n;
+  } //while
+
+  return true;
+} //Write
+
+/// Send a line, that is, a string followed by a newline.
+/// \param strLine String, which must not contain a newline.
+/// \return true if it was sent.
+
+bool CSocket::Send(const std::string& strLine){
+  return Write(strLine + "\n");
+} //Send
+
+/// Receive whatever has arrived, waiting if nothing has, and append it to
+/// the buffer.
+/// \return false if the connection has been closed or has failed.
+
+bool CSocket::Receive(){
+  char buffer[4096]; //bytes received
+
+  const int n = recv((SOCKET)m_nSocket, buffer, (int)sizeof(buffer), 0);
+
+  if(n <= 0)
+    return false;
+
+  m_strBuffer.append(buffer, (size_t)n);
+  return true;
+} //Receive
+
+/// Get the next whole line from the buffer, without its newline.
+/// \param strLine [out] Line.
+/// \return true if there was a whole line in the buffer.
+
+bool CSocket::GetLine(std::string& strLine){
+  const size_t n = m_strBuffer.find('\n'); //end of first line
+
+  if(n == std::string::npos)
+    return false;
+
+  strLine = m_strBuffer.substr(0, n);
+  m_strBuffer.erase(0, n + 1);
+
+  if(!strLine.empty() && strLine.back() == '\r')
+    strLine.pop_back();
+
+  return true;
+} //GetLine
+
+/// Get the next line, waiting for it to arrive if need be.
+/// \param strLine [out] Line.
+/// \return false if the connection was closed or failed first.
+
+bool CSocket::ReadLine(std::string& strLine){
+  while(!GetLine(strLine))
+    if(!Receive())
+      return false;
+
+  return true;
+} //ReadLine
+
+/// Wait until at least one open socket in a list can be read from without
+/// waiting, or a time limit runs out. A listening socket can be read from
+/// when a connection is waiting to be accepted.
+/// \param sockets List of sockets.
+/// \param ready [out] Whether each socket can be read from.
+/// \param nMilliseconds Time limit in milliseconds.
+
+void CSocket::Select(const std::vector<CSocket*>& sockets,
+  std::vector<bool>& ready, const size_t nMilliseconds)
+{
+  fd_set fds; //set of sockets
+  FD_ZERO(&fds);
+  SOCKET nMax = 0; //largest socket handle
+
+  for(const CSocket* p: sockets)
+    if(p->IsOpen()){
+      FD_SET((SOCKET)p->m_nSocket, &fds);
+      nMax = std::max(nMax, (SOCKET)p->m_nSocket);
+    } //if
+
+  timeval t; //time limit
+  t.tv_sec = (long)(nMilliseconds/1000);
+  t.tv_usec = (long)(1000*(nMilliseconds%1000));
+
+  const int n = select((int)nMax + 1, &fds, nullptr, nullptr, &t);
+
+  ready.assign(sockets.size(), false);
+
+  if(n > 0)
+    for(size_t i=0; i<sockets.size(); i++)
+      ready[i] = sockets[i]->IsOpen() &&
+        FD_ISSET((SOCKET)sockets[i]->m_nSocket, &fds) != 0;
+} //Select
@@ -0,0 +1,73 @@
+/// \file Socket.h
+/// \brief Header for the TCP socket `CSocket`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Socket_h__
+#define __Socket_h__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// \brief TCP socket.
+///
+/// A thin portable wrapper for a TCP socket using Winsock on Windows and
+/// BSD sockets elsewhere, carrying text messages of one line each. Received
+/// bytes are buffered until a whole line has arrived. `CSocket::Startup()`
+/// must be called once before any socket is used, and `CSocket::Cleanup()`
+/// once after they are all closed.
+
+class CSocket{
+  private:
+    std::uintptr_t m_nSocket; ///< Socket handle.
+    std::string m_strBuffer; ///< Bytes received but not yet read.
+
+  public:
+    CSocket(); ///< Constructor.
+    ~CSocket(); ///< Destructor.
+
+    CSocket(const CSocket&) = delete; ///< No copy constructor.
+    CSocket& operator=(const CSocket&) = delete; ///< No assignment.
+
+    static bool Startup(); ///< Start up the socket library.
+    static void Cleanup(); ///< Clean up the socket library.
+
+    bool Listen(const unsigned short, const bool); ///< Listen on a port.
+    bool Accept(CSocket&); ///< Accept a connection.
+    bool Connect(const std::string&, const std::string&); ///< Connect to a host.
+    void Close(); ///< Close.
+    bool IsOpen() const; ///< Is it open?
+
+    bool Write(const std::string&); ///< Send bytes.
+    bool Send(const std::string&); ///< Send a line.
+    bool Receive(); ///< Receive what has arrived.
+    bool GetLine(std::string&); ///< Get a line that has been received.
+    bool ReadLine(std::string&); ///< Wait for a line and get it.
+
+    static void Select(const std::vector<CSocket*>&, std::vector<bool>&,
+      const size_t); ///< Wait for sockets to be readable.
+}; //CSocket
+
+#endif //__Socket_h__
@@ -24,37 +24,29 @@
 // IN THE SOFTWARE.
 
 #include "SortingNetwork.h"
+#include "TernaryGrayCode.h"
 
-/// Create a binary Gray code generator.
-
-CSortingNetwork::CSortingNetwork(): CComparatorNetwork(){
-  m_pGrayCode = new CBinaryGrayCode;
-} //constructor
-
-/// Delete the binary Gray code generator.
-
-CSortingNetwork::~CSortingNetwork(){
-  delete m_pGrayCode;
-} //destructor
-
-/// Set the values on every channel between two levels to zero.
+/// Set the values on every channel between two levels to zero, and the input
+/// bit string to zero.
 /// \param first First level to set to zero.
 /// \param last Last level to set to zero.
 
-void CSortingNetwork::InitValues(const size_t first, const size_t last){
+template<size_t N, size_t D, class G>
+void CSortingNetwork<N, D, G>::InitValues(const size_t first, const size_t last){
+  m_nInput = 0; //all zeros
+
   for(size_t i=first; i<=last; i++) //for each level in range
-    for(size_t j=0; j<m_nWidth; j++) //for each channel
-      m_nValue[i][j] = 0; //set the value on this channel at that level to zero
+    m_nValue[i] = 0; //set the value on every channel at that level to zero
 } //InitValues
 
 /// Initialize the network for the sorting test, that is, make the
 /// Gray code word for input be all zeros, and the values on every channel at
 /// every level be zero.
 
-void CSortingNetwork::Initialize(){ 
-  m_pGrayCode->Initialize(); //initialize the Gray code to all zeros.
-  InitValues(0, m_nDepth - 1); //initialize the network values to all zeros.
-  m_nZeros = m_nWidth - 1; //all zeros
+template<size_t N, size_t D, class G> void CSortingNetwork<N, D, G>::Initialize(){ 
+  m_cGrayCode.Initialize(); //initialize the Gray code to all zeros.
+  InitValues(0, D - 1); //initialize the network values to all zeros.
+  m_nZeros = N - 1; //all zeros
 } //initialize
 
 /// Flip bit and propagate down the comparator network. Note that when a
@@ -72,16 +64,18 @@ void CSortingNetwork::Initialize(){
 /// \param last Propagate change down to this level.
 /// \return Channel whose value is flipped after the last level.
 
-size_t CSortingNetwork::FlipInput(size_t j, const size_t first, const size_t last){
-  const size_t nBit = m_nValue[first][j] ^ 1;
+template<size_t N, size_t D, class G>
+size_t CSortingNetwork<N, D, G>::FlipInput(size_t j, const size_t first, const size_t last){
+  const size_t nBit = ((m_nValue[first] >> j) & 1) ^ 1;
   m_nZeros += nBit? -1: 1; //if nBit has flipped to 1, one less zero, else one more
+  m_nInput ^= (size_t)1 << j; //flip it in the input bit string too
   
   for(size_t i=first; i<=last; i++){ //for each layer in range
-    m_nValue[i][j] = nBit; //flip the value on channel j at that level 
+    m_nValue[i] ^= (uint16_t)(1 << j); //flip the value on channel j at that level 
 
     const size_t k = m_nComparator[i][j]; //channel joined via a comparator
 
-    if(xor(m_nValue[i][k], j > k))
+    if(xnor((m_nValue[i] >> k) & 1, j > k))
       j = k;
   } //for
 
@@ -93,23 +87,31 @@ size_t CSortingNetwork::FlipInput(size_t j, const size_t first, const size_t las
 /// \param delta Index of channel to flip.
 /// \return true if it still sorts when channel is flipped.
 
-bool CSortingNetwork::StillSorts(const size_t delta){
-  const size_t nTarget = m_nValue[0][delta]? m_nZeros: m_nZeros - 1;
-  return FlipInput(delta, 0, m_nDepth - 1) == nTarget;
+template<size_t N, size_t D, class G>
+bool CSortingNetwork<N, D, G>::StillSorts(const size_t delta){
+  const size_t nTarget = ((m_nValue[0] >> delta) & 1)? m_nZeros: m_nZeros - 1;
+  return FlipInput(delta, 0, D - 1) == nTarget;
 } //StillSorts
 
 /// Check whether sorting network sorts all inputs.
 /// \return true if it sorts.
 
-bool CSortingNetwork::Sorts(){ 
+template<size_t N, size_t D, class G> bool CSortingNetwork<N, D, G>::Sorts(){ 
   size_t i = 0; //index of bit to flip
   bool bSorts = true; //assume it sorts until we find otherwise
   Initialize(); //intialize input and values in comparator network to zero
 
-  while(bSorts && i < m_nWidth){ //bail if it doesn't sort, or we've tried all binary inputs
-    i = m_pGrayCode->Next(); //next bit to flip in Gray code order
-    bSorts = bSorts && (i >= m_nWidth || StillSorts(i)); //check whether it still sorts when this bit is flipped
+  while(bSorts && i < N){ //bail if it doesn't sort, or we've tried all binary inputs
+    i = m_cGrayCode.Next(); //next bit to flip in Gray code order
+    bSorts = bSorts && (i >= N || StillSorts(i)); //check whether it still sorts when this bit is flipped
   } //while
 
   return bSorts;
-} //Sorts
\ No newline at end of file
+} //Sorts
+
+//explicit instantiation for every width and depth, and for both Gray codes
+
+#define INSTANTIATE(n, d) \
+  template class CSortingNetwork<n, d>; \
+  template class CSortingNetwork<n, d, CTernaryGrayCode<n>>;
+FOR_EACH_SHAPE(INSTANTIATE)
@@ -42,24 +42,32 @@
 /// speeds up the test. The main function of interest here is
 /// `CSortingNetwork::Sorts()` which returns `true` if the base comparator
 /// network sorts all inputs.
+///
+/// The Gray code generator is a template parameter and a member object rather
+/// than a pointer, so that calls to it are resolved at compile time.
+///
+/// \tparam N Number of channels.
+/// \tparam D Number of levels.
+/// \tparam G Gray code generator.
 
-class CSortingNetwork: public CComparatorNetwork{
+template<size_t N, size_t D, class G = CBinaryGrayCode<N>>
+class CSortingNetwork: public CComparatorNetwork<N, D>{
   protected: 
-    CBinaryGrayCode *m_pGrayCode = nullptr; ///< Gray code generator.
-    size_t m_nValue[MAXDEPTH][MAXINPUTS] = {0}; ///< Values at each level when sorting.
+    using CComparatorNetwork<N, D>::m_nComparator;
+
+    G m_cGrayCode; ///< Gray code generator.
+    uint16_t m_nValue[D] = {0}; ///< Values at each level when sorting, one bit per channel.
     size_t m_nZeros = 0; ///< Number of zeros in the input.
+    size_t m_nInput = 0; ///< Input as a bit string, one bit per channel.
 
-    virtual void Initialize(); ///< Initialize the sorting test.
-    virtual bool Sorts(); ///< Does it sort?
+    void Initialize(); ///< Initialize the sorting test.
+    bool Sorts(); ///< Does it sort?
 
-    virtual bool StillSorts(const size_t); ///< Does it still sort when a bit is changed?
+    bool StillSorts(const size_t); ///< Does it still sort when a bit is changed?
 
     size_t FlipInput(size_t, const size_t, const size_t); ///< Recompute network values when a bit is changed.
     void InitValues(const size_t, const size_t); ///< Initialize the network values to the all zero input.
 
-  public:
-    CSortingNetwork(); ///< Constructor.
-    ~CSortingNetwork(); ///< Destructor.
 }; //CSortingNetwork
 
 #endif //__SortingNetwork_h__
\ No newline at end of file
@@ -0,0 +1,123 @@
+/// \file Stats.cpp
+/// \brief Code for the search statistics counters `CStats`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "Stats.h"
+
+/// Add the counters from another instance to the ones in this instance.
+/// \param c Another instance.
+
+void CStats::Accumulate(const CStats& c){
+  for(size_t i=0; i<MAXDEPTH; i++)
+    m_nVisited[i] += c.m_nVisited[i];
+
+  m_nNearsorts += c.m_nNearsorts;
+  m_nNearsortRejects += c.m_nNearsortRejects;
+  m_nNearsorts2 += c.m_nNearsorts2;
+  m_nNearsort2Rejects += c.m_nNearsort2Rejects;
+  m_nSorts += c.m_nSorts;
+  m_nVectors += c.m_nVectors;
+  m_nInsertions += c.m_nInsertions;
+} //Accumulate
+
+/// Get the number of matchings visited, added up over all levels, which is
+/// the number of nodes of the search tree visited.
+/// \return The number of matchings visited.
+
+const size_t CStats::GetVisited() const{
+  size_t n = 0; //number of matchings visited
+
+  for(size_t i=0; i<MAXDEPTH; i++)
+    n += m_nVisited[i];
+
+  return n;
+} //GetVisited
+
+/// Save the counters as a JSON object. The array of matchings visited has an
+/// entry for each level, which counts the times that the level was set to a
+/// matching by `CSearchable::NextMatching()`. Levels that are not enumerated
+/// are set once per task, apart from those of the prefix, which are not
+/// counted.
+/// \param s [out] Stream to save to.
+/// \param d Depth.
+
+void CStats::Save(std::ostream& s, const size_t d) const{
+  s << "{" << std::endl;
+  s << "    \"visited\": [";
+
+  for(size_t i=0; i<d; i++)
+    s << (i? ", ": "") << m_nVisited[i];
+
+  s << "]," << std::endl;
+  s << "    \"nearsort_tests\": " << m_nNearsorts << "," << std::endl;
+  s << "    \"nearsort_rejects\": " << m_nNearsortRejects << "," << std::endl;
+  s << "    \"nearsort2_tests\": " << m_nNearsorts2 << "," << std::endl;
+  s << "    \"nearsort2_rejects\": " << m_nNearsort2Rejects << "," << std::endl;
+  s << "    \"sorting_tests\": " << m_nSorts << "," << std::endl;
+  s << "    \"gray_code_inputs\": " << m_nVectors << "," << std::endl;
+  s << "    \"autocomplete_insertions\": " << m_nInsertions << std::endl;
+  s << "  }";
+} //Save
+
+/// Save the counters as metrics in the Prometheus text exposition format.
+/// The number of matchings visited is labelled with the level, up to the
+/// deepest level visited. The nearsort and nearsort2 tests share metrics
+/// labelled with the heuristic, so that the fraction of candidates rejected by
+/// each can be graphed by dividing the rate of rejects by the rate of tests.
+/// \param s [out] Stream to save to.
+
+void CStats::SaveMetrics(std::ostream& s) const{
+  size_t d = MAXDEPTH; //one more than the deepest level visited
+
+  while(d > 0 && m_nVisited[d - 1] == 0)
+    d--;
+
+  s << "# HELP search_visited_total Matchings visited at each level." << std::endl;
+  s << "# TYPE search_visited_total counter" << std::endl;
+
+  for(size_t i=0; i<d; i++)
+    s << "search_visited_total{level=\"" << i << "\"} " << m_nVisited[i] << std::endl;
+
+  s << "# HELP search_heuristic_tests_total Candidates tested by a heuristic." << std::endl;
+  s << "# TYPE search_heuristic_tests_total counter" << std::endl;
+  s << "search_heuristic_tests_total{heuristic=\"nearsort\"} " << m_nNearsorts << std::endl;
+  s << "search_heuristic_tests_total{heuristic=\"nearsort2\"} " << m_nNearsorts2 << std::endl;
+
+  s << "# HELP search_heuristic_rejects_total Candidates rejected by a heuristic." << std::endl;
+  s << "# TYPE search_heuristic_rejects_total counter" << std::endl;
+  s << "search_heuristic_rejects_total{heuristic=\"nearsort\"} " << m_nNearsortRejects << std::endl;
+  s << "search_heuristic_rejects_total{heuristic=\"nearsort2\"} " << m_nNearsort2Rejects << std::endl;
+
+  s << "# HELP search_sorting_tests_total Sorting tests." << std::endl;
+  s << "# TYPE search_sorting_tests_total counter" << std::endl;
+  s << "search_sorting_tests_total " << m_nSorts << std::endl;
+
+  s << "# HELP search_gray_code_inputs_total Gray code test inputs tried." << std::endl;
+  s << "# TYPE search_gray_code_inputs_total counter" << std::endl;
+  s << "search_gray_code_inputs_total " << m_nVectors << std::endl;
+
+  s << "# HELP search_autocomplete_insertions_total Comparators inserted into the last level by autocomplete." << std::endl;
+  s << "# TYPE search_autocomplete_insertions_total counter" << std::endl;
+  s << "search_autocomplete_insertions_total " << m_nInsertions << std::endl;
+} //SaveMetrics
@@ -0,0 +1,125 @@
+/// \file Stats.h
+/// \brief Interface for the search statistics counters `CStats`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Stats_h__
+#define __Stats_h__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "Defines.h"
+
+/// \brief Search statistics counters.
+///
+/// Counters that show where the time goes in a search: the number of
+/// matchings visited at each level, the number of calls to
+/// `CNearsort::Nearsorts()` and `CNearsort2::Nearsorts2()` and how many of
+/// them rejected the candidate, the number of calls to the sorting test,
+/// the number of Gray code test inputs tried by the sorting and nearsort
+/// tests, and the number of comparators inserted into the last level by
+/// `CAutocomplete`. Each searchable sorting network has its own counters,
+/// which only its thread touches, and the thread manager adds them up when
+/// the task is processed, so they cost one increment each.
+///
+/// The counting functions are inline, and they do nothing unless `STATS` is
+/// defined (see `Defines.h`), so that defining `NOSTATS` removes the counters
+/// from production builds altogether.
+
+class CStats{
+  private:
+    size_t m_nVisited[MAXDEPTH] = {0}; ///< Number of matchings visited at each level.
+    size_t m_nNearsorts = 0; ///< Number of nearsort tests.
+    size_t m_nNearsortRejects = 0; ///< Number of candidates rejected by the nearsort test.
+    size_t m_nNearsorts2 = 0; ///< Number of nearsort2 tests.
+    size_t m_nNearsort2Rejects = 0; ///< Number of candidates rejected by the nearsort2 test.
+    size_t m_nSorts = 0; ///< Number of sorting tests.
+    size_t m_nVectors = 0; ///< Number of Gray code test inputs tried.
+    size_t m_nInsertions = 0; ///< Number of comparators inserted into the last level by autocomplete.
+
+  public:
+    /// Count a matching visited at a level.
+    /// \param level Level.
+
+    void CountVisit(const size_t level){
+      #ifdef STATS
+        m_nVisited[level]++;
+      #endif //STATS
+    } //CountVisit
+
+    /// Count a nearsort test.
+    /// \param bPassed Whether the candidate passed.
+
+    void CountNearsort(const bool bPassed){
+      #ifdef STATS
+        m_nNearsorts++;
+        m_nNearsortRejects += !bPassed;
+      #endif //STATS
+    } //CountNearsort
+
+    /// Count a nearsort2 test.
+    /// \param bPassed Whether the candidate passed.
+
+    void CountNearsort2(const bool bPassed){
+      #ifdef STATS
+        m_nNearsorts2++;
+        m_nNearsort2Rejects += !bPassed;
+      #endif //STATS
+    } //CountNearsort2
+
+    /// Count a sorting test.
+
+    void CountSort(){
+      #ifdef STATS
+        m_nSorts++;
+      #endif //STATS
+    } //CountSort
+
+    /// Count a Gray code test input.
+
+    void CountVector(){
+      #ifdef STATS
+        m_nVectors++;
+      #endif //STATS
+    } //CountVector
+
+    /// Count the comparators in a last level built by autocomplete.
+    /// \param comparator Testable representation of the last level.
+    /// \param n Number of channels.
+
+    void CountInsertions(const uint8_t comparator[], const size_t n){
+      #ifdef STATS
+        for(size_t j=0; j<n; j++)
+          m_nInsertions += comparator[j] > j;
+      #endif //STATS
+    } //CountInsertions
+
+    void Accumulate(const CStats&); ///< Add counters from another instance.
+    const size_t GetVisited() const; ///< Get number of matchings visited.
+    void Save(std::ostream&, const size_t) const; ///< Save as a JSON object.
+    void SaveMetrics(std::ostream&) const; ///< Save in Prometheus text format.
+}; //CStats
+
+#endif //__Stats_h__
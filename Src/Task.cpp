@@ -23,31 +23,156 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
 
-#include <chrono>
-#include <thread>
-
 #include "Task.h"
-#include "Nearsort2.h"
+#include "Searchable.h"
+#include "ThreadManager.h"
+#include "Timer.h"
+#include "Probes.h"
 
 /// Default constructor.
 /// \param p Pointer to searchable sorting network.
 
-CTask::CTask(CSearchable* p): 
-  CBaseTask(), m_pSearch(p){
+CTask::CTask(CSearchableBase* p): 
+  m_pSearch(p){
 } //constructor
 
-/// Perform this task. This function overrides `CBaseTask::Perform()`.
+/// Destructor. Delete the searchable sorting network.
+
+CTask::~CTask(){
+  delete m_pSearch;
+} //destructor
+
+/// Perform this task, recording which thread performed it, when it started
+/// and finished, and the CPU time used by the thread in between, and firing
+/// the static tracepoints at its start and end (see `Probes.h`).
 
 void CTask::Perform(){
+  m_cRecord.m_nThread = CThreadManager::GetThread();
+  m_cRecord.m_tStart = std::chrono::steady_clock::now();
+  const double fStartCPU = CTimer::GetThreadCPUTime(); //CPU time at start
+  PROBE_TASK_START(GetIndex(), m_cRecord.m_nThread);
+
   if(m_pSearch)
     m_pSearch->Backtrack();
+
+  m_cRecord.m_fCPUSeconds = CTimer::GetThreadCPUTime() - fStartCPU;
+  m_cRecord.m_tFinish = std::chrono::steady_clock::now();
+  PROBE_TASK_END(GetIndex(), m_cRecord.m_nThread, GetCount());
 } //Perform
 
+/// Add the counters from the counterexample caches of the searchable sorting
+/// network to those in another cache.
+/// \param c [in, out] Cache whose counters are to be added to.
+
+void CTask::GetWitnessStats(CWitnessCache& c) const{
+  if(m_pSearch)
+    m_pSearch->GetWitnessStats(c);
+} //GetWitnessStats
+
+/// Add the number of matchings skipped at each level of the searchable
+/// sorting network to an array of counters.
+/// \param p [in, out] Array of `MAXDEPTH` counters to be added to.
+
+void CTask::GetPruneStats(size_t p[]) const{
+  if(m_pSearch)
+    m_pSearch->GetPruneStats(p);
+} //GetPruneStats
+
+/// Add the search statistics counters of the searchable sorting network to
+/// those in another instance.
+/// \param c [in, out] Counters to be added to.
+
+void CTask::GetStats(CStats& c) const{
+  if(m_pSearch)
+    m_pSearch->GetStats(c);
+} //GetStats
+
+/// Tell the searchable sorting network which thread manager to donate work to.
+/// \param p Pointer to thread manager.
+
+void CTask::SetThreadManager(CThreadManager* p){
+  if(m_pSearch)
+    m_pSearch->SetThreadManager(p);
+} //SetThreadManager
+
 /// Reader function for the number of sorting networks found.
 /// \return The count.
 
-size_t CTask::GetCount(){
-  const size_t nCount = m_pSearch? m_pSearch->GetCount(): 0;
-  delete m_pSearch;
-  return nCount;
+size_t CTask::GetCount() const{
+  return m_pSearch? m_pSearch->GetCount(): 0;
 } //GetCount
+
+/// Save the resumable state of the searchable sorting network.
+/// \param s [out] Stream to save to.
+
+void CTask::Checkpoint(std::ostream& s) const{
+  if(m_pSearch)
+    m_pSearch->Checkpoint(s);
+} //Checkpoint
+
+/// Reader function for the task index of the searchable sorting network.
+/// \return The task index.
+
+size_t CTask::GetIndex() const{
+  return m_pSearch? m_pSearch->GetIndex(): 0;
+} //GetIndex
+
+/// Reader function for the index of the new task that the searchable sorting
+/// network descends from.
+/// \return The root task index.
+
+size_t CTask::GetRoot() const{
+  return m_pSearch? m_pSearch->GetRoot(): 0;
+} //GetRoot
+
+/// Reader function for the number of candidates processed by the searchable
+/// sorting network.
+/// \return The number of candidates processed.
+
+size_t CTask::GetCandidates() const{
+  return m_pSearch? m_pSearch->GetCandidates(): 0;
+} //GetCandidates
+
+/// Get the fraction of the search of the searchable sorting network that has
+/// been done. This must only be called while the search is halted.
+/// \return Fraction of the search done, from 0 to 1.
+
+double CTask::GetProgress() const{
+  return m_pSearch? m_pSearch->GetProgress(): 0;
+} //GetProgress
+
+/// Get the part of its root task that the searchable sorting network covers
+/// in this run.
+/// \return Share of the root task, as a fraction of it.
+
+double CTask::GetShare() const{
+  return m_pSearch? m_pSearch->GetShare(): 0;
+} //GetShare
+
+/// Get the part of its root task that the searchable sorting network has
+/// done in this run. This must only be called while the search is halted.
+/// \return Share of the root task done, as a fraction of it.
+
+double CTask::GetShareDone() const{
+  return m_pSearch? m_pSearch->GetShareDone(): 0;
+} //GetShareDone
+
+/// Get the record of this task for the trace, that is, the record made by
+/// `CTask::Perform()` together with the task index, the number of matchings
+/// visited, the number of candidates processed, and the number of sorting
+/// networks found. The number of matchings visited is only counted if `STATS`
+/// is defined.
+/// \return The task record.
+
+CTaskRecord CTask::GetRecord() const{
+  CTaskRecord r = m_cRecord; //task record
+  CStats c; //search statistics counters
+  GetStats(c);
+
+  r.m_nIndex = GetIndex();
+  r.m_nNodes = c.GetVisited();
+  r.m_nCandidates = GetCandidates();
+  r.m_nCount = GetCount();
+
+  return r;
+} //GetRecord
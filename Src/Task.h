@@ -26,24 +26,47 @@
 #ifndef __Task_h__
 #define __Task_h__
 
-#include "BaseTask.h"
+#include <cstddef>
+#include <iostream>
 
-class CSearchable;
+#include "Trace.h"
+
+class CSearchableBase;
+class CWitnessCache;
+class CStats;
+class CThreadManager;
 
 /// \brief Task.
 ///
-/// This task descriptor, derived from `CBaseTask`, overrides the 
-/// `CBaseTask::Perform()` function.
+/// This task descriptor holds a searchable sorting network, and has the
+/// function `CTask::Perform()` that `CTaskPool` calls to search it.
+/// `CTask::Perform()` records when the task started and finished, which
+/// thread performed it, and the CPU time that it used, for the trace kept by
+/// the thread manager (see `CTrace`).
 
-class CTask: public CBaseTask{
+class CTask{
   private:
-    CSearchable* m_pSearch = nullptr; ///< Searchable sorting network.
+    CSearchableBase* m_pSearch = nullptr; ///< Searchable sorting network.
+    CTaskRecord m_cRecord; ///< Record of the task for the trace.
 
   public:
-    CTask(CSearchable*); ///< Default constructor.
+    CTask(CSearchableBase*); ///< Default constructor.
+    ~CTask(); ///< Destructor.
 
-    virtual void Perform(); ///< Perform the task.
-    size_t GetCount(); ///< Get count.
+    void Perform(); ///< Perform the task.
+    size_t GetCount() const; ///< Get count.
+    void GetWitnessStats(CWitnessCache&) const; ///< Add up counterexample cache counters.
+    void GetPruneStats(size_t[]) const; ///< Add up pruning counters.
+    void GetStats(CStats&) const; ///< Add up search statistics counters.
+    void SetThreadManager(CThreadManager*); ///< Set thread manager.
+    void Checkpoint(std::ostream&) const; ///< Save resumable state.
+    size_t GetIndex() const; ///< Get task index.
+    size_t GetRoot() const; ///< Get root task index.
+    size_t GetCandidates() const; ///< Get number of candidates processed.
+    double GetProgress() const; ///< Get fraction of search done.
+    double GetShare() const; ///< Get share of root task in this run.
+    double GetShareDone() const; ///< Get share of root task done in this run.
+    CTaskRecord GetRecord() const; ///< Get record for the trace.
 }; //CTask
 
 #endif //__Task_h__
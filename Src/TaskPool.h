@@ -0,0 +1,447 @@
+/// \file TaskPool.h
+/// \brief Header for the work-stealing task pool `CTaskPool`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __TaskPool_h__
+#define __TaskPool_h__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Work-stealing task pool.
+///
+/// A self-contained pool of `std::thread`s that performs tasks of type `t`,
+/// which must have a function `Perform()`. It has a given number of threads,
+/// by default one per hardware thread, and each thread has its own queue of
+/// tasks, which it takes from the front of. A thread whose queue is empty
+/// steals from the back of the other threads' queues, and if they are all
+/// empty, posts a request for work with `CTaskPool::Request()` and waits. A
+/// busy task that sees the request with `CTaskPool::Requested()` may claim it
+/// with `CTaskPool::Claim()` and push a new task onto its own thread's queue
+/// with `CTaskPool::Push()`, from which the idle thread steals it.
+///
+/// The tasks are inserted with `CTaskPool::Insert()`, performed by the
+/// threads started by `CTaskPool::Spawn()` until there are none left, and
+/// `CTaskPool::Wait()` waits for the threads to finish. Each task is passed to
+/// the virtual function `CTaskPool::CompleteTask()` by the thread that performed
+/// it as soon as it completes, and then to the virtual function
+/// `CTaskPool::ProcessTask()` by `CTaskPool::Process()` in the calling thread
+/// after the threads have finished, after which it is deleted.
+///
+/// The threads can be paused, for example to save the state of every task
+/// at the same moment. `CTaskPool::Pause()` waits until every thread has
+/// halted, either between tasks or in a task that has seen
+/// `CTaskPool::Paused()` and called `CTaskPool::Halt()` at a point where its
+/// state is consistent. `CTaskPool::GetTasks()` then lists the tasks, and
+/// `CTaskPool::Unpause()` lets the threads continue. `CTaskPool::GetRunning()`
+/// lists just the tasks that were being performed when they halted, and
+/// `CTaskPool::GetCurrent()` the one being performed by a given thread.
+///
+/// This replaces `CBaseThreadManager` from the `thread++` library.
+///
+/// Everything is in this header so that it can be used without building
+/// a library.
+///
+/// \tparam t Task type.
+
+template<class t> class CTaskPool{
+  private:
+    size_t m_nNumThreads = 1; ///< Number of threads.
+    std::vector<std::thread> m_stlThread; ///< Threads.
+    std::vector<std::deque<t*>> m_stlQueue; ///< Task queue for each thread.
+    std::vector<std::mutex> m_stlQueueMutex; ///< Mutex for each task queue.
+    std::vector<t*> m_stlResult; ///< Completed tasks.
+    std::mutex m_stdResultMutex; ///< Mutex for completed tasks.
+    size_t m_nNextQueue = 0; ///< Queue for the next task pushed by a thread that is not one of ours.
+
+    std::vector<t*> m_stlCurrent; ///< Task being performed by each thread, if any.
+
+    std::atomic<size_t> m_nPending; ///< Number of tasks pushed but not yet completed.
+    std::atomic<size_t> m_nRequests; ///< Number of unclaimed requests for work.
+
+    std::atomic<bool> m_bPause; ///< Whether the threads are to halt.
+    std::mutex m_stdPauseMutex; ///< Mutex for pausing.
+    std::condition_variable m_stdPauseCV; ///< Condition variable for pausing.
+    size_t m_nRunning = 0; ///< Number of threads that have not finished.
+    size_t m_nHalted = 0; ///< Number of threads halted.
+
+    static thread_local size_t m_nThread; ///< Index of the current thread, or out of range if not one of ours.
+
+    t* Pop(const size_t); ///< Pop a task from a thread's own queue.
+    t* Steal(const size_t); ///< Steal a task from another thread's queue.
+    void Run(const size_t); ///< Thread function.
+
+  protected:
+    void Push(t*); ///< Push a task onto a queue.
+    bool Finished(const std::chrono::milliseconds&); ///< Wait for all threads to finish.
+    void Pause(); ///< Pause all threads.
+    void Unpause(); ///< Let paused threads continue.
+    void GetTasks(std::vector<t*>&, std::vector<t*>&) const; ///< List tasks while paused.
+    void GetRunning(std::vector<t*>&) const; ///< List tasks being performed while paused.
+    t* GetCurrent(const size_t) const; ///< Get task being performed by a thread while paused.
+
+    virtual void CompleteTask(t*){} ///< Called by the thread that performed a task.
+    virtual void ProcessTask(t*){} ///< Process the result of a task.
+
+  public:
+    CTaskPool(const size_t=0); ///< Constructor.
+    virtual ~CTaskPool(); ///< Destructor.
+
+    void Insert(t*); ///< Insert a task.
+    void Spawn(); ///< Spawn threads.
+    void Wait(); ///< Wait for threads to finish.
+    void Process(); ///< Process the results of completed tasks.
+
+    bool Requested() const; ///< Has an idle thread asked for work?
+    bool Claim(); ///< Claim a request for work.
+    void Request(); ///< Make a request for work.
+
+    bool Paused() const; ///< Are the threads to halt?
+    void Halt(); ///< Halt until unpaused.
+
+    const size_t GetNumThreads() const; ///< Get number of threads.
+    static const size_t GetThread(); ///< Get index of current thread.
+}; //CTaskPool
+
+template<class t> thread_local size_t CTaskPool<t>::m_nThread = (size_t)-1;
+
+/// Constructor.
+/// \param n Number of threads, or 0 for one per hardware thread.
+
+template<class t> CTaskPool<t>::CTaskPool(const size_t n):
+  m_nNumThreads(n > 0? n: std::max(std::thread::hardware_concurrency(), 1U)),
+  m_stlQueue(m_nNumThreads),
+  m_stlQueueMutex(m_nNumThreads),
+  m_stlCurrent(m_nNumThreads, nullptr),
+  m_nPending(0),
+  m_nRequests(0),
+  m_bPause(false)
+{
+} //constructor
+
+/// Destructor. Wait for the threads, if any, and delete any tasks that have
+/// not been processed.
+
+template<class t> CTaskPool<t>::~CTaskPool(){
+  Wait();
+
+  for(std::deque<t*>& q: m_stlQueue)
+    for(t* pTask: q)
+      delete pTask;
+
+  for(t* pTask: m_stlResult)
+    delete pTask;
+} //destructor
+
+/// Insert a task. This is the same as `CTaskPool::Push()`, which may also be
+/// called by the tasks themselves while the threads are running.
+/// \param pTask Pointer to a task.
+
+template<class t> void CTaskPool<t>::Insert(t* pTask){
+  Push(pTask);
+} //Insert
+
+/// Push a task onto the back of the queue of the current thread, or if the
+/// current thread is not one of ours, of the next queue in turn.
+/// \param pTask Pointer to a task.
+
+template<class t> void CTaskPool<t>::Push(t* pTask){
+  size_t i = m_nThread; //index of queue
+
+  if(i >= m_nNumThreads){ //not one of our threads
+    i = m_nNextQueue;
+    m_nNextQueue = (m_nNextQueue + 1)%m_nNumThreads;
+  } //if
+
+  m_nPending++;
+
+  std::lock_guard<std::mutex> lock(m_stlQueueMutex[i]);
+  m_stlQueue[i].push_back(pTask);
+} //Push
+
+/// Pop a task from the front of a thread's own queue.
+/// \param i Index of thread.
+/// \return Pointer to a task, or `nullptr` if the queue is empty.
+
+template<class t> t* CTaskPool<t>::Pop(const size_t i){
+  std::lock_guard<std::mutex> lock(m_stlQueueMutex[i]);
+
+  if(m_stlQueue[i].empty())
+    return nullptr;
+
+  t* pTask = m_stlQueue[i].front();
+  m_stlQueue[i].pop_front();
+
+  return pTask;
+} //Pop
+
+/// Steal a task from the back of another thread's queue, trying them in turn
+/// starting with the next one.
+/// \param i Index of the thief.
+/// \return Pointer to a task, or `nullptr` if there is none.
+
+template<class t> t* CTaskPool<t>::Steal(const size_t i){
+  for(size_t k=1; k<m_nNumThreads; k++){ //for each other thread
+    const size_t j = (i + k)%m_nNumThreads; //index of victim
+    std::lock_guard<std::mutex> lock(m_stlQueueMutex[j]);
+
+    if(!m_stlQueue[j].empty()){
+      t* pTask = m_stlQueue[j].back();
+      m_stlQueue[j].pop_back();
+      return pTask;
+    } //if
+  } //for
+
+  return nullptr;
+} //Steal
+
+/// Thread function. Perform tasks from this thread's own queue, or stolen
+/// from other threads, until there are none left anywhere. When there are
+/// none to be had, post a single request for work and wait for one to be
+/// pushed. A request that is still unclaimed when work is found is withdrawn.
+/// Halt between tasks if the threads are paused.
+/// \param i Index of this thread.
+
+template<class t> void CTaskPool<t>::Run(const size_t i){
+  m_nThread = i;
+  bool bRequested = false; //whether this thread has an outstanding request
+
+  while(m_nPending > 0){ //while there is work left somewhere
+    if(Paused())
+      Halt();
+
+    t* pTask = Pop(i); //try own queue
+
+    if(!pTask)
+      pTask = Steal(i); //try stealing
+
+    if(pTask){
+      if(bRequested){
+        Claim(); //withdraw the request if no one has claimed it yet
+        bRequested = false;
+      } //if
+
+      m_stlCurrent[i] = pTask;
+      pTask->Perform();
+      CompleteTask(pTask);
+
+      std::lock_guard<std::mutex> lock(m_stdResultMutex);
+      m_stlResult.push_back(pTask);
+      m_stlCurrent[i] = nullptr;
+      m_nPending--;
+    } //if
+
+    else{ //idle
+      if(!bRequested){
+        Request();
+        bRequested = true;
+      } //if
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } //else
+  } //while
+
+  std::lock_guard<std::mutex> lock(m_stdPauseMutex);
+  m_nRunning--;
+  m_stdPauseCV.notify_all();
+} //Run
+
+/// Spawn the threads.
+
+template<class t> void CTaskPool<t>::Spawn(){
+  m_nRunning = m_nNumThreads;
+
+  for(size_t i=0; i<m_nNumThreads; i++)
+    m_stlThread.push_back(std::thread(&CTaskPool::Run, this, i));
+} //Spawn
+
+/// Wait for all threads to finish.
+
+template<class t> void CTaskPool<t>::Wait(){
+  for(std::thread& stdThread: m_stlThread)
+    stdThread.join();
+
+  m_stlThread.clear();
+} //Wait
+
+/// Process the results of the completed tasks and delete them.
+
+template<class t> void CTaskPool<t>::Process(){
+  for(t* pTask: m_stlResult){
+    ProcessTask(pTask);
+    delete pTask;
+  } //for
+
+  m_stlResult.clear();
+} //Process
+
+/// Check whether there is a request for work that has not been claimed. This
+/// may be polled often by busy tasks, so it uses a relaxed load.
+/// \return true if an idle thread has asked for work.
+
+template<class t> bool CTaskPool<t>::Requested() const{
+  return m_nRequests.load(std::memory_order_relaxed) > 0;
+} //Requested
+
+/// Claim an unclaimed request for work, if there is one.
+/// \return true if a request was claimed.
+
+template<class t> bool CTaskPool<t>::Claim(){
+  size_t n = m_nRequests; //number of requests
+
+  while(n > 0)
+    if(m_nRequests.compare_exchange_weak(n, n - 1))
+      return true;
+
+  return false;
+} //Claim
+
+/// Post a request for work, or return a claimed request that could not be
+/// satisfied.
+
+template<class t> void CTaskPool<t>::Request(){
+  m_nRequests++;
+} //Request
+
+/// Wait a while for all threads to finish, that is, to run out of tasks.
+/// \param tWait Maximum time to wait.
+/// \return true if all threads have finished.
+
+template<class t>
+bool CTaskPool<t>::Finished(const std::chrono::milliseconds& tWait){
+  std::unique_lock<std::mutex> lock(m_stdPauseMutex);
+  const std::chrono::steady_clock::time_point tEnd =
+    std::chrono::steady_clock::now() + tWait; //when to give up
+
+  while(m_nRunning > 0)
+    if(m_stdPauseCV.wait_until(lock, tEnd) == std::cv_status::timeout)
+      break;
+
+  return m_nRunning == 0;
+} //Finished
+
+/// Check whether the threads are to halt. This may be polled often by busy
+/// tasks, so it uses a relaxed load.
+/// \return true if the threads are to halt.
+
+template<class t> bool CTaskPool<t>::Paused() const{
+  return m_bPause.load(std::memory_order_relaxed);
+} //Paused
+
+/// Halt the calling thread until the threads are unpaused. Tasks must call
+/// this only when their state is consistent.
+
+template<class t> void CTaskPool<t>::Halt(){
+  std::unique_lock<std::mutex> lock(m_stdPauseMutex);
+  m_nHalted++;
+  m_stdPauseCV.notify_all();
+
+  while(m_bPause)
+    m_stdPauseCV.wait(lock);
+
+  m_nHalted--;
+} //Halt
+
+/// Pause the threads, and wait until every thread that has not finished has
+/// halted.
+
+template<class t> void CTaskPool<t>::Pause(){
+  std::unique_lock<std::mutex> lock(m_stdPauseMutex);
+  m_bPause = true;
+
+  while(m_nHalted < m_nRunning)
+    m_stdPauseCV.wait(lock);
+} //Pause
+
+/// Let the paused threads continue.
+
+template<class t> void CTaskPool<t>::Unpause(){
+  std::lock_guard<std::mutex> lock(m_stdPauseMutex);
+  m_bPause = false;
+  m_stdPauseCV.notify_all();
+} //Unpause
+
+/// List the tasks that have not been completed, that is, the ones being
+/// performed followed by the ones in the queues, and the ones that have been
+/// completed but not processed. This must only be called while the threads
+/// are paused, or before they are spawned.
+/// \param unfinished [out] Tasks that have not been completed.
+/// \param finished [out] Tasks that have been completed.
+
+template<class t> void CTaskPool<t>::GetTasks(std::vector<t*>& unfinished,
+  std::vector<t*>& finished) const
+{
+  for(t* pTask: m_stlCurrent)
+    if(pTask)
+      unfinished.push_back(pTask);
+
+  for(const std::deque<t*>& q: m_stlQueue)
+    unfinished.insert(unfinished.end(), q.begin(), q.end());
+
+  finished.insert(finished.end(), m_stlResult.begin(), m_stlResult.end());
+} //GetTasks
+
+/// List the tasks being performed. This must only be called while the threads
+/// are paused.
+/// \param running [out] Tasks being performed.
+
+template<class t> void CTaskPool<t>::GetRunning(std::vector<t*>& running) const{
+  for(t* pTask: m_stlCurrent)
+    if(pTask)
+      running.push_back(pTask);
+} //GetRunning
+
+/// Get the task being performed by a thread. This must only be called while
+/// the threads are paused.
+/// \param i Thread index.
+/// \return Pointer to the task, or `nullptr` if the thread is between tasks.
+
+template<class t> t* CTaskPool<t>::GetCurrent(const size_t i) const{
+  return m_stlCurrent[i];
+} //GetCurrent
+
+/// Get the index of the thread that calls this function, for example from
+/// `CTaskPool::CompleteTask()` or from a task, so that it can keep counters
+/// of its own.
+/// \return Thread index from 0 to one less than the number of threads, or
+/// out of range if it is not one of the pool's threads.
+
+template<class t> const size_t CTaskPool<t>::GetThread(){
+  return m_nThread;
+} //GetThread
+
+/// Reader function for the number of threads.
+/// \return The number of threads.
+
+template<class t> const size_t CTaskPool<t>::GetNumThreads() const{
+  return m_nNumThreads;
+} //GetNumThreads
+
+#endif //__TaskPool_h__
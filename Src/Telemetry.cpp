@@ -0,0 +1,144 @@
+/// \file Telemetry.cpp
+/// \brief Code for the metrics endpoint `CTelemetry`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+  #include <psapi.h>
+
+  #ifdef _MSC_VER
+    #pragma comment(lib, "Psapi.lib")
+  #endif //_MSC_VER
+#else
+  #include <unistd.h>
+#endif //_WIN32
+
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include "Telemetry.h"
+#include "Defines.h"
+
+/// Listen for scrapes on a port of the loopback interface.
+/// \param nPort Port number.
+/// \return true if listening.
+
+bool CTelemetry::Listen(const unsigned short nPort){
+  return m_cListener.Listen(nPort, true);
+} //Listen
+
+/// If a connection is waiting, accept it and read its request line, waiting
+/// at most `SCRAPETIMEOUT` milliseconds in total for it, however it is split
+/// into pieces, so that a client that dribbles its request cannot hold up
+/// the caller. A request that is not a scrape is answered and closed here.
+/// \return true if a scrape was accepted, which must be answered with
+/// `CTelemetry::Respond()`.
+
+bool CTelemetry::Accept(){
+  std::vector<CSocket*> sockets(1, &m_cListener); //sockets to wait for
+  std::vector<bool> ready; //whether each socket can be read from
+  CSocket::Select(sockets, ready, 0);
+
+  if(!ready[0] || !m_cListener.Accept(m_cClient))
+    return false; //no connection waiting
+
+  std::string strLine; //request line
+  sockets.assign(1, &m_cClient);
+
+  const std::chrono::steady_clock::time_point tDeadline =
+    std::chrono::steady_clock::now() +
+    std::chrono::milliseconds(SCRAPETIMEOUT); //time to give up
+
+  while(!m_cClient.GetLine(strLine)){ //until the request line has arrived
+    const std::chrono::steady_clock::time_point tNow =
+      std::chrono::steady_clock::now(); //current time
+
+    if(tNow >= tDeadline){ //too slow
+      m_cClient.Close();
+      return false;
+    } //if
+
+    CSocket::Select(sockets, ready, (size_t)std::chrono::duration_cast<
+      std::chrono::milliseconds>(tDeadline - tNow).count());
+
+    if(!ready[0] || !m_cClient.Receive()){ //too slow or closed
+      m_cClient.Close();
+      return false;
+    } //if
+  } //while
+
+  if(strLine.compare(0, 13, "GET /metrics ") != 0){ //not a scrape
+    Reply("404 Not Found", "Not found\n");
+    return false;
+  } //if
+
+  return true;
+} //Accept
+
+/// Answer an accepted scrape with metrics and close the connection.
+/// \param strMetrics Metrics in Prometheus text exposition format.
+
+void CTelemetry::Respond(const std::string& strMetrics){
+  Reply("200 OK", strMetrics);
+} //Respond
+
+/// Send an HTTP response with a plain text body and close the connection.
+/// \param strStatus Status code and reason phrase.
+/// \param strBody Body.
+
+void CTelemetry::Reply(const std::string& strStatus, const std::string& strBody){
+  m_cClient.Write("HTTP/1.0 " + strStatus + "\r\n"
+    "Content-Type: text/plain; version=0.0.4\r\n"
+    "Content-Length: " + std::to_string(strBody.size()) + "\r\n"
+    "Connection: close\r\n\r\n" + strBody);
+  m_cClient.Close();
+} //Reply
+
+/// Get the amount of physical memory used by this process, which is read
+/// from `/proc/self/statm` on Linux and is not available on other POSIX
+/// systems.
+/// \return Resident memory in bytes, or 0 if it is not available.
+
+const size_t CTelemetry::GetMemory(){
+  #ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc; //memory counters
+
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+      return (size_t)pmc.WorkingSetSize;
+
+    return 0;
+  #else
+    std::ifstream f("/proc/self/statm"); //memory use in pages
+    size_t nSize = 0; //total program size
+    size_t nResident = 0; //resident set size
+
+    if(!(f >> nSize >> nResident))
+      return 0;
+
+    return nResident*(size_t)sysconf(_SC_PAGESIZE);
+  #endif //_WIN32
+} //GetMemory
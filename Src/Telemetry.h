@@ -0,0 +1,61 @@
+/// \file Telemetry.h
+/// \brief Header for the metrics endpoint `CTelemetry`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Telemetry_h__
+#define __Telemetry_h__
+
+#include <cstddef>
+#include <string>
+
+#include "Socket.h"
+
+/// \brief Metrics endpoint.
+///
+/// A read-only HTTP endpoint on a port of the loopback interface, so that
+/// only processes on the same machine can reach it, which serves the state of
+/// a running search in the Prometheus text exposition format to a monitoring
+/// system that scrapes it. It is polled by `CThreadManager::Wait()` between
+/// its checks for finished threads, so it needs no thread of its own. A scrape
+/// is a `GET` request for `/metrics`; anything else gets `404 Not Found`.
+/// A client that has not sent its whole request line within `SCRAPETIMEOUT`
+/// milliseconds of connecting is dropped, so that it cannot hold up the
+/// search's checkpoints, progress reports, or interrupt handling.
+
+class CTelemetry{
+  private:
+    CSocket m_cListener; ///< Socket listening for scrapes.
+    CSocket m_cClient; ///< Socket connected to the client being served.
+
+    void Reply(const std::string&, const std::string&); ///< Send a response and close.
+
+  public:
+    bool Listen(const unsigned short); ///< Listen on a port.
+    bool Accept(); ///< Accept a scrape.
+    void Respond(const std::string&); ///< Send metrics.
+
+    static const size_t GetMemory(); ///< Get resident memory.
+}; //CTelemetry
+
+#endif //__Telemetry_h__
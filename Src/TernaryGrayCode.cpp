@@ -28,10 +28,10 @@
 /// Reset Gray code generator to the first word in Gray code order, the
 /// all-zero word.
 
-void CTernaryGrayCode::Initialize(){ 
-  CBinaryGrayCode::Initialize(); //reset as for the binary version
+template<size_t N> void CTernaryGrayCode<N>::Initialize(){ 
+  CBinaryGrayCode<N>::Initialize(); //reset as for the binary version
   
-  for(size_t i=0; i<=m_nWidth+2; i++) //reset the direction array too
+  for(size_t i=0; i<=N+2; i++) //reset the direction array too
     m_nDirection[i] = 0;
 } //initialize
 
@@ -39,7 +39,7 @@ void CTernaryGrayCode::Initialize(){
 /// differ from the previous one in exactly one bit.
 /// \return Index of changed bit. Out of range means we're finished.
 
-size_t CTernaryGrayCode::Next(){
+template<size_t N> size_t CTernaryGrayCode<N>::Next(){
   const size_t i = m_nStack[0]; 
   m_nStack[0] = 1;
 
@@ -49,8 +49,13 @@ size_t CTernaryGrayCode::Next(){
   if(m_nBit[2*i] == m_nBit[2*i - 1]){
     m_nDirection[i] ^= 1;
     m_nStack[i - 1] = m_nStack[i];
-    m_nStack[i] = i + 1;
+    m_nStack[i] = (uint8_t)(i + 1);
   } //if
 
   return j - 1;
 } //Next
+
+//explicit instantiation for every width
+
+#define INSTANTIATE(n) template class CTernaryGrayCode<n>;
+FOR_EACH_WIDTH(INSTANTIATE)
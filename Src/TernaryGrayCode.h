@@ -59,10 +59,15 @@
 /// 
 /// This class implements a nonrecursive version of the
 /// algorithm from [the paper](https://ianparberry.com/pubs/9-input.pdf).
+///
+/// \tparam N Number of bits.
 
-class CTernaryGrayCode: public CBinaryGrayCode{
+template<size_t N> class CTernaryGrayCode: public CBinaryGrayCode<N>{
   protected:
-    int m_nDirection[MAXINPUTS + 3]; ///< Direction of ternary change.
+    using CBinaryGrayCode<N>::m_nBit;
+    using CBinaryGrayCode<N>::m_nStack;
+
+    uint8_t m_nDirection[N + 3]; ///< Direction of ternary change.
 
   public:
     void Initialize(); ///< Get first code word.
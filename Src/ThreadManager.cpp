@@ -23,28 +23,632 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
 
-#include <functional>
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
 
 #include "ThreadManager.h"
+#include "Searchable.h"
+#include "Telemetry.h"
+#include "Timer.h"
 
-/// Default constructor.
+volatile std::sig_atomic_t CThreadManager::m_nSignal = 0;
 
-CThreadManager::CThreadManager(): CBaseThreadManager(){
+/// Constructor.
+/// \param n Number of threads, or 0 for one per hardware thread.
+
+CThreadManager::CThreadManager(const size_t n):
+  CTaskPool(n),
+  m_nNextIndex(0),
+  m_nDonations(0)
+{
+  m_stlThreadCandidates.assign(GetNumThreads(), 0);
 } //constructor
 
-/// Overrides the virtual function `CBaseThreadManager::ProcessTask()` in order
+/// Insert a task before the threads are spawned, and tell its searchable
+/// sorting network where to donate work to. Tasks are assumed to have been
+/// given indices less than the number of tasks to be set by
+/// `CThreadManager::SetNumTasks()`, or to have been resumed from a checkpoint
+/// along with the index to give the next task, so that donated tasks can be
+/// given indices that follow them. The task is counted as not completed
+/// under its root.
+/// \param pTask Pointer to a task descriptor.
+
+void CThreadManager::Insert(CTask* pTask){
+  pTask->SetThreadManager(this);
+  AddPiece(pTask->GetRoot());
+  CTaskPool::Insert(pTask);
+} //Insert
+
+/// Count one more task not yet completed that descends from a root task.
+/// \param root Index of root task.
+
+void CThreadManager::AddPiece(const size_t root){
+  std::lock_guard<std::mutex> lock(m_stdRootMutex);
+  m_stlPieces[root]++;
+} //AddPiece
+
+/// Overrides the virtual function `CTaskPool::CompleteTask()` in order to add
+/// the candidates processed in a completed task to the counter of the thread
+/// that performed it, which only that thread touches, and to record the root
+/// of the task as covered if this was the last of its tasks to complete.
+/// \param pTask Pointer to a task descriptor.
+
+void CThreadManager::CompleteTask(CTask* pTask){
+  if(!pTask)
+    return; //safety
+
+  const size_t i = GetThread(); //index of this thread
+
+  if(i < m_stlThreadCandidates.size()) //safety
+    m_stlThreadCandidates[i] += pTask->GetCandidates();
+
+  const size_t root = pTask->GetRoot(); //index of root task
+  std::lock_guard<std::mutex> lock(m_stdRootMutex);
+
+  if(--m_stlPieces[root] == 0){ //last one
+    m_stlPieces.erase(root);
+    m_stlCovered.insert(root);
+  } //if
+} //CompleteTask
+
+/// Overrides the virtual function `CTaskPool::ProcessTask()` in order
 /// to process the results stored in the completed task descriptor. 
 /// \param pTask Pointer to a task descriptor.
 
 void CThreadManager::ProcessTask(CTask* pTask){
-  if(pTask) //safety
+  if(pTask){ //safety
+    pTask->GetWitnessStats(m_cWitnessStats);
+    pTask->GetPruneStats(m_nPruned);
+    pTask->GetStats(m_cStats);
+    m_cTrace.Add(pTask->GetRecord());
     m_nCount += pTask->GetCount();
+  } //if
 } //ProcessTask
 
+/// Donate work in the form of a searchable sorting network to be wrapped in
+/// a new task and pushed onto the current thread's queue. The task is
+/// counted as not completed under its root before any thread can take it.
+/// \param pSearch Pointer to a searchable sorting network.
+
+void CThreadManager::Donate(CSearchableBase* pSearch){
+  CTask* pTask = new CTask(pSearch); //new task
+  pTask->SetThreadManager(this);
+  AddPiece(pTask->GetRoot());
+  Push(pTask);
+  m_nDonations++;
+} //Donate
+
+/// Get an index for a new task, following those of the tasks created so far
+/// in the same shard.
+/// \return Task index.
+
+size_t CThreadManager::GetTaskIndex(){
+  return m_nNextIndex.fetch_add(m_nNumShards);
+} //GetTaskIndex
+
+/// Set the shard of the search that this process is to perform. This must be
+/// called before any tasks are created.
+/// \param i Shard number.
+/// \param k Number of shards.
+
+void CThreadManager::SetShard(const size_t i, const size_t k){
+  m_nShard = i;
+  m_nNumShards = k;
+} //SetShard
+
+/// Check whether a task of the whole search is in this shard.
+/// \param index Task index.
+/// \return true if the task is in this shard.
+
+bool CThreadManager::Owns(const size_t index) const{
+  return index%m_nNumShards == m_nShard;
+} //Owns
+
+/// Set the number of tasks in the whole search, after the tasks in this shard
+/// have been inserted. Donated tasks are given the indices in this shard
+/// that follow them.
+/// \param n Number of tasks in the whole search.
+
+void CThreadManager::SetNumTasks(const size_t n){
+  m_nNumTasks = n;
+  m_nNextIndex = n + (m_nShard + m_nNumShards - n%m_nNumShards)%m_nNumShards;
+} //SetNumTasks
+
+/// Spawn the threads, starting the trace at the same moment, so that the
+/// trace covers the whole time that the threads run.
+
+void CThreadManager::Spawn(){
+  m_cTrace.Start(GetNumThreads());
+  CTaskPool::Spawn();
+} //Spawn
+
+/// Wait for the threads to finish. Every `CHECKPOINTINTERVAL` seconds, and
+/// when a signal has been received, pause the threads and save a checkpoint.
+/// After a signal, exit without waiting for the threads. If a progress
+/// interval has been set, pause the threads that often to report progress,
+/// and when the threads have finished, save the final status. If a metrics
+/// endpoint has been set, answer scrapes from it, pausing the threads while
+/// the metrics are gathered. When the threads have finished, delete the
+/// checkpoint file, since the results are complete.
+
+void CThreadManager::Wait(){
+  const std::chrono::steady_clock::time_point tStart =
+    std::chrono::steady_clock::now(); //time threads were waited for
+  const std::chrono::seconds tInterval(CHECKPOINTINTERVAL); //time between checkpoints
+  const std::chrono::seconds tProgressInterval(m_nProgressInterval); //time between progress reports
+  std::chrono::steady_clock::time_point tNext = tStart + tInterval; //time of next checkpoint
+  std::chrono::steady_clock::time_point tNextProgress = tStart + tProgressInterval; //time of next progress report
+  std::chrono::steady_clock::time_point tLastProgress = tStart; //time of last progress report
+
+  while(!Finished(std::chrono::milliseconds(100))){ //poll for signals
+    const int nSignal = m_nSignal; //signal received, if any
+    const std::chrono::steady_clock::time_point tNow =
+      std::chrono::steady_clock::now(); //current time
+    const bool bCheckpoint = nSignal || tNow >= tNext; //whether to save a checkpoint
+    const bool bProgress = m_nProgressInterval > 0 && tNow >= tNextProgress; //whether to report progress
+
+    if(bCheckpoint || bProgress){
+      Pause(); //halt all threads at consistent states
+
+      if(bProgress){
+        const std::chrono::duration<double> tElapsed = tNow - tStart; //time so far
+        const std::chrono::duration<double> tSince = tNow - tLastProgress; //time since last report
+        Progress(tElapsed.count(), tSince.count(), true);
+        tLastProgress = tNow;
+        tNextProgress = tNow + tProgressInterval;
+      } //if
+
+      if(bCheckpoint){
+        SaveCheckpoint();
+
+        if(nSignal){ //interrupted
+          if(!m_strCheckpoint.empty())
+            std::cout << "Interrupted, checkpoint saved to " << m_strCheckpoint << std::endl;
+          else std::cout << "Interrupted" << std::endl;
+
+          std::_Exit(128 + nSignal); //the threads are halted, so don't join them
+        } //if
+
+        tNext = std::chrono::steady_clock::now() + tInterval;
+      } //if
+
+      Unpause();
+    } //if
+
+    if(m_pTelemetry && m_pTelemetry->Accept()){ //scrape
+      const std::chrono::duration<double> tElapsed =
+        std::chrono::steady_clock::now() - tStart; //time so far
+      std::ostringstream s; //metrics
+
+      Pause(); //halt all threads at consistent states
+      Metrics(s, tElapsed.count());
+      Unpause();
+
+      m_pTelemetry->Respond(s.str());
+    } //if
+  } //while
+
+  CTaskPool::Wait(); //join the threads
+  m_cTrace.Finish();
+
+  if(m_nProgressInterval > 0){ //save final status
+    const std::chrono::steady_clock::time_point tNow =
+      std::chrono::steady_clock::now(); //current time
+    const std::chrono::duration<double> tElapsed = tNow - tStart; //time taken
+    const std::chrono::duration<double> tSince = tNow - tLastProgress; //time since last report
+    Progress(tElapsed.count(), tSince.count(), false);
+  } //if
+
+  if(!m_strCheckpoint.empty())
+    std::remove(m_strCheckpoint.c_str());
+} //Wait
+
+/// Set how often to report progress, and the name of the status file that
+/// the progress reports are saved to.
+/// \param nSeconds Number of seconds between progress reports, 0 for none.
+/// \param strFile Status file name.
+
+void CThreadManager::SetProgress(const size_t nSeconds, const std::string& strFile){
+  m_nProgressInterval = nSeconds;
+  m_strStatus = strFile;
+} //SetProgress
+
+/// Set the metrics endpoint that `CThreadManager::Wait()` answers scrapes
+/// from while the threads run.
+/// \param pTelemetry Pointer to a metrics endpoint that is listening, or
+/// `nullptr` for none.
+
+void CThreadManager::SetTelemetry(CTelemetry* pTelemetry){
+  m_pTelemetry = pTelemetry;
+} //SetTelemetry
+
+/// Save metrics in the Prometheus text exposition format, that is, the
+/// elapsed time, the number of tasks in this run that are queued, running and
+/// done, the fraction done by each running task from
+/// `CTask::GetProgress()`, the number of candidates processed by each thread,
+/// the number of sorting networks found and of tasks donated, the resident
+/// memory, and the counterexample cache and search statistics counters added
+/// up over all tasks, including the ones not yet completed. The candidates
+/// processed by a thread are counted as a total, so that the throughput of
+/// each thread is its rate of increase. This must only be called while the
+/// threads are paused, or after they have finished.
+/// \param s [out] Stream to save to.
+/// \param fElapsed Number of seconds since the threads were spawned.
+
+void CThreadManager::Metrics(std::ostream& s, const double fElapsed){
+  std::vector<CTask*> unfinished; //tasks not completed
+  std::vector<CTask*> finished; //tasks completed
+  std::vector<CTask*> running; //tasks being performed
+  GetTasks(unfinished, finished);
+  GetRunning(running);
+
+  size_t nCount = m_nCount; //number of sorting networks found
+  CWitnessCache cWitnessStats; //counterexample cache counters
+  CStats cStats; //search statistics counters
+
+  cWitnessStats.Accumulate(m_cWitnessStats);
+  cStats.Accumulate(m_cStats);
+
+  for(CTask* pTask: unfinished){
+    nCount += pTask->GetCount();
+    pTask->GetWitnessStats(cWitnessStats);
+    pTask->GetStats(cStats);
+  } //for
+
+  for(CTask* pTask: finished){
+    nCount += pTask->GetCount();
+    pTask->GetWitnessStats(cWitnessStats);
+    pTask->GetStats(cStats);
+  } //for
+
+  s << "# HELP search_elapsed_seconds Seconds since the threads were spawned." << std::endl;
+  s << "# TYPE search_elapsed_seconds gauge" << std::endl;
+  s << "search_elapsed_seconds " << fElapsed << std::endl;
+
+  s << "# HELP search_tasks Tasks in this run by state." << std::endl;
+  s << "# TYPE search_tasks gauge" << std::endl;
+  s << "search_tasks{state=\"queued\"} " << unfinished.size() - running.size() << std::endl;
+  s << "search_tasks{state=\"running\"} " << running.size() << std::endl;
+  s << "search_tasks{state=\"done\"} " << finished.size() << std::endl;
+
+  s << "# HELP search_task_fraction_done Fraction of each running task done." << std::endl;
+  s << "# TYPE search_task_fraction_done gauge" << std::endl;
+
+  for(size_t i=0; i<GetNumThreads(); i++){
+    const CTask* pTask = GetCurrent(i); //task being performed by this thread
+
+    if(pTask)
+      s << "search_task_fraction_done{task=\"" << pTask->GetIndex() <<
+        "\",thread=\"" << i << "\"} " << pTask->GetProgress() << std::endl;
+  } //for
+
+  s << "# HELP search_thread_candidates_total Candidates processed by each thread." << std::endl;
+  s << "# TYPE search_thread_candidates_total counter" << std::endl;
+
+  for(size_t i=0; i<GetNumThreads(); i++){
+    const CTask* pTask = GetCurrent(i); //task being performed by this thread
+    const size_t n = m_stlThreadCandidates[i] + (pTask? pTask->GetCandidates(): 0); //candidates
+
+    s << "search_thread_candidates_total{thread=\"" << i << "\"} " << n << std::endl;
+  } //for
+
+  s << "# HELP search_networks_found_total Sorting networks found." << std::endl;
+  s << "# TYPE search_networks_found_total counter" << std::endl;
+  s << "search_networks_found_total " << nCount << std::endl;
+
+  s << "# HELP search_donations_total Tasks donated to idle threads." << std::endl;
+  s << "# TYPE search_donations_total counter" << std::endl;
+  s << "search_donations_total " << m_nDonations << std::endl;
+
+  const size_t nMemory = CTelemetry::GetMemory(); //resident memory in bytes
+
+  if(nMemory > 0){ //available
+    s << "# HELP search_resident_memory_bytes Resident memory." << std::endl;
+    s << "# TYPE search_resident_memory_bytes gauge" << std::endl;
+    s << "search_resident_memory_bytes " << nMemory << std::endl;
+  } //if
+
+  s << "# HELP search_cache_lookups_total Candidates looked up in the counterexample cache." << std::endl;
+  s << "# TYPE search_cache_lookups_total counter" << std::endl;
+  s << "search_cache_lookups_total " << cWitnessStats.GetLookups() << std::endl;
+
+  s << "# HELP search_cache_hits_total Candidates refuted by the counterexample cache." << std::endl;
+  s << "# TYPE search_cache_hits_total counter" << std::endl;
+  s << "search_cache_hits_total " << cWitnessStats.GetHits() << std::endl;
+
+  cStats.SaveMetrics(s);
+} //Metrics
+
+/// Report progress, that is, the number of tasks completed out of the tasks
+/// in this run, the fraction of the search done, the number of candidates
+/// processed per second since the last report, the fraction done by each
+/// running task, and the estimated time left. Each task is weighted by the
+/// share of its root task that it covers in this run, `CTask::GetShare()`,
+/// so that the tasks split off a root task add up to it however many there
+/// are, and a task that has not completed counts as the share of it done,
+/// `CTask::GetShareDone()`. The time left is extrapolated from the elapsed
+/// time on the assumption that the rest of the search will take as long per
+/// root task as the part done so far. Print the report to the console if asked, and save it in JSON format
+/// to the status file. This must only be called while the threads are
+/// paused, or after they have finished.
+/// \param fElapsed Number of seconds since the threads were spawned.
+/// \param fSince Number of seconds since the last report.
+/// \param bPrint Whether to print the report to the console.
+
+void CThreadManager::Progress(const double fElapsed, const double fSince,
+  const bool bPrint)
+{
+  std::vector<CTask*> unfinished; //tasks not completed
+  std::vector<CTask*> finished; //tasks completed
+  std::vector<CTask*> running; //tasks being performed
+  GetTasks(unfinished, finished);
+  GetRunning(running);
+
+  size_t nCandidates = 0; //number of candidates processed
+  double fDone = 0; //number of root tasks done, counting fractions
+  double fTotal = 0; //number of root tasks in this run, counting fractions
+
+  for(CTask* pTask: finished){
+    nCandidates += pTask->GetCandidates();
+    fDone += pTask->GetShare();
+    fTotal += pTask->GetShare();
+  } //for
+
+  for(CTask* pTask: unfinished){
+    nCandidates += pTask->GetCandidates();
+    fDone += pTask->GetShareDone();
+    fTotal += pTask->GetShare();
+  } //for
+
+  const size_t nTasks = finished.size() + unfinished.size(); //number of tasks
+  const double fFraction = fTotal > 0? std::min(fDone/fTotal, 1.0): 1; //fraction of search done
+  const double fRate = fSince > 0? (nCandidates - m_nCandidates)/fSince: 0; //candidates per second
+  const double fLeft = fFraction > 0? fElapsed*(1 - fFraction)/fFraction: -1; //seconds left, negative if unknown
+  m_nCandidates = nCandidates;
+
+  if(bPrint){ //print to console
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(1);
+    s << "Progress: " << finished.size() << " of " << nTasks << " tasks done, " <<
+      100*fFraction << "% of search, " << std::scientific << std::setprecision(3) <<
+      fRate << " candidates/sec, " <<
+      (fLeft < 0? "time left unknown": "time left " + CTimer::Format(fLeft));
+
+    s << std::endl << "Running:" << std::fixed << std::setprecision(1);
+
+    for(CTask* pTask: running)
+      s << " task " << pTask->GetIndex() << " " << 100*pTask->GetProgress() << "%";
+
+    std::cout << s.str() << std::endl;
+  } //if
+
+  if(m_strStatus.empty())
+    return; //no status file
+
+  const std::string strTemp = m_strStatus + ".tmp"; //temporary file name
+  std::ofstream f(strTemp);
+
+  f << std::setprecision(6);
+  f << "{" << std::endl;
+  f << "  \"elapsed_seconds\": " << fElapsed << "," << std::endl;
+  f << "  \"tasks_done\": " << finished.size() << "," << std::endl;
+  f << "  \"tasks\": " << nTasks << "," << std::endl;
+  f << "  \"fraction_done\": " << fFraction << "," << std::endl;
+  f << "  \"candidates\": " << nCandidates << "," << std::endl;
+  f << "  \"candidates_per_second\": " << fRate << "," << std::endl;
+  f << "  \"seconds_left\": ";
+
+  if(fLeft < 0)
+    f << "null";
+  else f << fLeft;
+
+  f << "," << std::endl;
+  f << "  \"running\": [";
+
+  for(size_t i=0; i<running.size(); i++)
+    f << (i? ", ": "") << "{\"task\": " << running[i]->GetIndex() <<
+      ", \"fraction_done\": " << running[i]->GetProgress() << "}";
+
+  f << "]" << std::endl;
+  f << "}" << std::endl;
+  f.close();
+
+  Replace(strTemp, m_strStatus);
+} //Progress
+
+/// Set the name of the checkpoint file and the header line that it starts
+/// with, which describes the search settings so that it can be resumed.
+/// \param strFile Checkpoint file name, or empty for no checkpoints.
+/// \param strHeader Header line, without the end of line.
+
+void CThreadManager::SetCheckpoint(const std::string& strFile,
+  const std::string& strHeader)
+{
+  m_strCheckpoint = strFile;
+  m_strHeader = strHeader;
+} //SetCheckpoint
+
+/// Save the resumable state of the search, that is, the header line, the
+/// index of the next task, the number of tasks in the whole search, the
+/// totals from the tasks that have completed and
+/// the checkpoints that they were resumed from, the root tasks covered, and
+/// a line for each task that has not completed, with its root task index.
+/// This must only be called while the threads are paused, or before they are
+/// spawned.
+/// \param s [out] Stream to save to.
+
+void CThreadManager::Checkpoint(std::ostream& s){
+  std::vector<CTask*> unfinished; //tasks not completed
+  std::vector<CTask*> finished; //tasks completed
+  GetTasks(unfinished, finished);
+
+  size_t nCount = m_nCount; //total found by completed tasks
+  size_t nPruned[MAXDEPTH] = {0}; //total pruned by completed tasks
+
+  for(size_t i=0; i<MAXDEPTH; i++)
+    nPruned[i] = m_nPruned[i];
+
+  for(CTask* pTask: finished){
+    nCount += pTask->GetCount();
+    pTask->GetPruneStats(nPruned);
+  } //for
+
+  s << m_strHeader << std::endl;
+  s << "done " << m_nNextIndex << " " << m_nNumTasks << " " << nCount;
+
+  for(size_t i=0; i<MAXDEPTH; i++)
+    s << " " << nPruned[i];
+
+  s << std::endl;
+
+  std::lock_guard<std::mutex> lock(m_stdRootMutex);
+  s << "covered " << m_stlCovered.size();
+
+  for(const size_t i: m_stlCovered)
+    s << " " << i;
+
+  s << std::endl;
+
+  for(CTask* pTask: unfinished){
+    s << "task " << pTask->GetRoot() << " ";
+    pTask->Checkpoint(s);
+    s << std::endl;
+  } //for
+} //Checkpoint
+
+/// Restore the index of the next task, the number of tasks in the whole
+/// search, the totals from the tasks that had completed, and the root tasks
+/// covered, from the two lines after the header of a checkpoint file. The
+/// tasks that had not completed are restored by the caller.
+/// \param s [in, out] Stream to restore from.
+/// \return true if the lines were read.
+
+bool CThreadManager::Resume(std::istream& s){
+  std::string strTag; //line tag
+  std::string strCovered; //second line tag
+  size_t nNextIndex = 0; //index of next task
+  size_t nCovered = 0; //number of root tasks covered
+  s >> strTag >> nNextIndex >> m_nNumTasks >> m_nCount;
+
+  for(size_t i=0; i<MAXDEPTH; i++)
+    s >> m_nPruned[i];
+
+  s >> strCovered >> nCovered;
+
+  for(size_t i=0; i<nCovered && s; i++){
+    size_t j = 0; //index of root task
+    s >> j;
+    m_stlCovered.insert(j);
+  } //for
+
+  m_nNextIndex = nNextIndex;
+
+  return !s.fail() && strTag == "done" && strCovered == "covered" &&
+    m_stlCovered.size() == nCovered;
+} //Resume
+
+/// Save a checkpoint to a temporary file and then replace the checkpoint file
+/// with it, so that an interruption while saving leaves the previous
+/// checkpoint intact.
+
+void CThreadManager::SaveCheckpoint(){
+  if(m_strCheckpoint.empty())
+    return; //no checkpoint file
+
+  const std::string strTemp = m_strCheckpoint + ".tmp"; //temporary file name
+  std::ofstream f(strTemp);
+  Checkpoint(f);
+  f.close();
+
+  Replace(strTemp, m_strCheckpoint);
+} //SaveCheckpoint
+
+/// Replace a file with a temporary file, so that the file is always either
+/// the old version or the new one.
+/// \param strTemp Temporary file name.
+/// \param strFile File name.
+
+void CThreadManager::Replace(const std::string& strTemp, const std::string& strFile){
+  #ifdef _WIN32 //rename will not replace an existing file
+    std::remove(strFile.c_str());
+  #endif //_WIN32
+
+  std::rename(strTemp.c_str(), strFile.c_str());
+} //Replace
+
+/// Signal handler for `SIGINT` and `SIGTERM`, which records the signal for
+/// `CThreadManager::Wait()` to act on.
+/// \param nSignal Signal number.
+
+void CThreadManager::Interrupt(int nSignal){
+  m_nSignal = nSignal;
+} //Interrupt
+
+/// Reader function for the number of tasks donated by busy threads.
+/// \return The number of tasks donated.
+
+const size_t CThreadManager::GetNumDonations() const{
+  return m_nDonations;
+} //GetNumDonations
+
+/// Reader function for the number of tasks in the whole search, in all shards.
+/// \return The number of tasks.
+
+const size_t CThreadManager::GetNumTasks() const{
+  return m_nNumTasks;
+} //GetNumTasks
+
+/// Get the indices of the tasks of the whole search that have been covered,
+/// that is, all of whose descendants have completed, in this run or in the
+/// runs that it resumed. This must only be called after the threads have
+/// finished.
+/// \return The task indices in increasing order.
+
+std::vector<size_t> CThreadManager::GetCovered() const{
+  return std::vector<size_t>(m_stlCovered.begin(), m_stlCovered.end());
+} //GetCovered
+
 /// Reader function for `m_nCount`, the number of sorting networks found.
 /// \return The count.
 
 const size_t CThreadManager::GetCount() const{
   return m_nCount;
 } //GetCount
+
+/// Reader function for `m_cWitnessStats`, whose counters are the totals of
+/// the counterexample cache counters from all tasks.
+/// \return Reference to the counterexample cache counters.
+
+const CWitnessCache& CThreadManager::GetWitnessStats() const{
+  return m_cWitnessStats;
+} //GetWitnessStats
+
+/// Reader function for `m_nPruned`, the total number of matchings skipped at
+/// each level by all tasks.
+/// \return Pointer to an array of `MAXDEPTH` counters.
+
+const size_t* CThreadManager::GetPruneStats() const{
+  return m_nPruned;
+} //GetPruneStats
+
+/// Reader function for `m_cStats`, whose counters are the totals of the
+/// search statistics counters from all tasks.
+/// \return Reference to the search statistics counters.
+
+const CStats& CThreadManager::GetStats() const{
+  return m_cStats;
+} //GetStats
+
+/// Reader function for `m_cTrace`, which holds the records of the tasks
+/// performed.
+/// \return Reference to the task trace.
+
+const CTrace& CThreadManager::GetTrace() const{
+  return m_cTrace;
+} //GetTrace
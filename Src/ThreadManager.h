@@ -26,26 +26,159 @@
 #ifndef __ThreadManager_h__
 #define __ThreadManager_h__
 
-#include "BaseThreadManager.h"
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TaskPool.h"
 #include "Task.h"
+#include "WitnessCache.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Defines.h"
+
+class CSearchableBase;
+class CTelemetry;
 
 /// \brief Thread manager.
 ///
 /// The thread manager takes care of the health and feeding of the threads.
-/// It is derived from `CBaseThreadManager<CTask>`. It has a function
-/// `CThreadManager::ProcessTask()` which overrides the virtual function
-/// `CBaseThreadManager::ProcessTask()` in order to process the results stored
-/// in the completed task descriptor.
+/// It is derived from the work-stealing task pool `CTaskPool<CTask>`.
+/// A busy searchable sorting network that sees a request for work from an
+/// idle thread claims it with `CTaskPool::Claim()`, splits off the unexplored
+/// part of the shallowest level of its search tree that has any, and hands it
+/// over with `CThreadManager::Donate()` as a new task on its own thread's
+/// queue, from which the idle thread steals it. Load balance therefore does
+/// not depend on how evenly the work is divided into tasks to begin with.
+/// It has a function `CThreadManager::ProcessTask()` which overrides the
+/// virtual function `CTaskPool::ProcessTask()` in order to process the results
+/// stored in the completed task descriptor.
+///
+/// While the threads run, `CThreadManager::Wait()` saves a checkpoint every
+/// `CHECKPOINTINTERVAL` seconds, and when interrupted by `SIGINT` or `SIGTERM`
+/// it saves one and exits. A checkpoint is taken with the threads paused, so
+/// that no task is part way through a candidate or a donation. It consists of
+/// a header line supplied by the caller, a line with the next task index and
+/// the totals from the completed tasks, and a line for each of the other
+/// tasks from `CTask::Checkpoint()`. It is written to a temporary file that
+/// then replaces the checkpoint file, so that the checkpoint file is always
+/// complete, and the checkpoint file is deleted when the search finishes.
+/// The counterexample cache counters and the search statistics counters,
+/// which are only statistics, are not saved.
+///
+/// Every few seconds, as set by `CThreadManager::SetProgress()`, `Wait()`
+/// also pauses the threads to report progress: the number of tasks completed
+/// out of the tasks in this run, the number of candidates processed per
+/// second since the last report, the fraction of the search done by each
+/// running task from the position of its stack, and an estimate of the time
+/// left, extrapolated from the fraction of the whole search done. The
+/// candidates are counted by each task, which only its own thread touches,
+/// and added up while the threads are paused, so counting them needs no
+/// atomic operations. The same data is saved as JSON to a status file.
+///
+/// If a metrics endpoint has been set with `CThreadManager::SetTelemetry()`,
+/// `Wait()` also answers scrapes from it, pausing the threads to gather the
+/// state of the search in the same way: the tasks queued, running and done,
+/// the fraction done by each running task, the candidates processed by each
+/// thread, the number of sorting networks found, the memory used, and the
+/// counterexample cache and search statistics counters. Each thread adds the
+/// candidates processed in a task to its own counter when it completes the
+/// task, in `CThreadManager::CompleteTask()`.
+///
+/// `CThreadManager::ProcessTask()` also adds the record of each task, made by
+/// the thread that performed it, to a trace (see `CTrace`), which shows where
+/// the time went and how long each thread spent idle.
+///
+/// When the search is divided into shards, this process performs only the
+/// tasks of one shard (see `CShard`). Tasks donated by them are given indices
+/// in the same residue class beyond the tasks of the whole search, so that
+/// the names of the files in which sorting networks are saved are distinct
+/// across shards.
+///
+/// Every task descends from a new task of the whole search, its root, either
+/// by being it or by having been split off one of its descendants. The thread
+/// manager counts the tasks of each root that have not completed, adding one
+/// when a task is inserted or donated and taking one away in
+/// `CThreadManager::CompleteTask()`, and when the count reaches zero it
+/// records the root as covered. The covered roots are saved in checkpoints
+/// and in the shard result, so that merging the shard results can check that
+/// every task of the whole search was completed exactly once.
+
+class CThreadManager: public CTaskPool<CTask>{
+  private:
+    std::atomic<size_t> m_nNextIndex; ///< Index of the next task.
+    std::atomic<size_t> m_nDonations; ///< Number of tasks donated.
+
+    size_t m_nShard = 0; ///< Shard number.
+    size_t m_nNumShards = 1; ///< Number of shards.
+    size_t m_nNumTasks = 0; ///< Number of tasks in the whole search.
+
+    std::string m_strCheckpoint; ///< Checkpoint file name, empty for none.
+    std::string m_strHeader; ///< First line of checkpoint file.
+
+    size_t m_nProgressInterval = 0; ///< Number of seconds between progress reports, 0 for none.
+    std::string m_strStatus; ///< Status file name.
+    size_t m_nCandidates = 0; ///< Number of candidates processed at the last progress report.
+
+    CTelemetry* m_pTelemetry = nullptr; ///< Metrics endpoint, if any.
+    std::vector<size_t> m_stlThreadCandidates; ///< Number of candidates processed in completed tasks by each thread.
+
+    std::mutex m_stdRootMutex; ///< Mutex for root task counters.
+    std::map<size_t, size_t> m_stlPieces; ///< Number of tasks not yet completed that descend from each root task.
+    std::set<size_t> m_stlCovered; ///< Indices of root tasks whose descendants have all completed.
+
+    static volatile std::sig_atomic_t m_nSignal; ///< Signal received, if any.
+
+    void SaveCheckpoint(); ///< Save checkpoint file.
+    void AddPiece(const size_t); ///< Count a task not yet completed under its root.
+    void Progress(const double, const double, const bool); ///< Report progress.
+
+    static void Replace(const std::string&, const std::string&); ///< Replace a file with a temporary file.
 
-class CThreadManager: public CBaseThreadManager<CTask>{
   protected:
     size_t m_nCount = 0; ///< Number of comparator networks found that sort.
+    CWitnessCache m_cWitnessStats; ///< Counterexample cache counters from all tasks.
+    size_t m_nPruned[MAXDEPTH] = {0}; ///< Number of matchings skipped at each level in all tasks.
+    CStats m_cStats; ///< Search statistics counters from all tasks.
+    CTrace m_cTrace; ///< Records of the tasks performed.
+
+    void CompleteTask(CTask*); ///< Count the candidates and root of a completed task.
     void ProcessTask(CTask*); ///< Process the result of a task.
 
   public:
-    CThreadManager(); ///< Constructor.
+    CThreadManager(const size_t=0); ///< Constructor.
+
+    void Insert(CTask*); ///< Insert a task.
+    void Donate(CSearchableBase*); ///< Donate work.
+    size_t GetTaskIndex(); ///< Get an index for a new task.
+    void SetShard(const size_t, const size_t); ///< Set shard.
+    bool Owns(const size_t) const; ///< Is a task in this shard?
+    void SetNumTasks(const size_t); ///< Set number of tasks in the whole search.
+    void Spawn(); ///< Spawn threads, starting the trace.
+    void Wait(); ///< Wait for threads to finish, saving checkpoints.
+
+    void SetCheckpoint(const std::string&, const std::string&); ///< Set checkpoint file.
+    void SetProgress(const size_t, const std::string&); ///< Set progress interval and status file.
+    void SetTelemetry(CTelemetry*); ///< Set metrics endpoint.
+    void Metrics(std::ostream&, const double); ///< Save metrics.
+    void Checkpoint(std::ostream&); ///< Save resumable state.
+    bool Resume(std::istream&); ///< Restore totals from a checkpoint.
+
+    static void Interrupt(int); ///< Signal handler.
 
     const size_t GetCount() const; ///< Get count.
+    const size_t GetNumDonations() const; ///< Get number of tasks donated.
+    const size_t GetNumTasks() const; ///< Get number of tasks in the whole search.
+    std::vector<size_t> GetCovered() const; ///< Get indices of root tasks completed.
+    const CWitnessCache& GetWitnessStats() const; ///< Get counterexample cache counters.
+    const size_t* GetPruneStats() const; ///< Get pruning counters.
+    const CStats& GetStats() const; ///< Get search statistics counters.
+    const CTrace& GetTrace() const; ///< Get task trace.
 }; //CThreadManager
 
 #endif //__ThreadManager_h__
@@ -0,0 +1,171 @@
+/// \file Timer.cpp
+/// \brief Code for the timer `CTimer`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include <cstdio>
+#include <ctime>
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#endif
+
+#include "Timer.h"
+
+/// Constructor. Start timing.
+
+CTimer::CTimer(){
+  Start();
+} //constructor
+
+/// Start timing, that is, record the current elapsed time and CPU time so
+/// that later times are measured from here.
+
+void CTimer::Start(){
+  m_tStart = std::chrono::steady_clock::now();
+  m_fStartCPU = GetProcessCPUTime();
+} //Start
+
+/// Get the CPU time used by all threads of this process so far. On Windows
+/// this is the sum of the user and kernel times from `GetProcessTimes()`,
+/// since `std::clock()` measures elapsed time there. Elsewhere it is
+/// `std::clock()`, which measures CPU time for the whole process.
+/// \return CPU time in seconds.
+
+double CTimer::GetProcessCPUTime(){
+  #ifdef _WIN32
+    FILETIME ftCreation, ftExit, ftKernel, ftUser; //in units of 100ns
+
+    if(!GetProcessTimes(GetCurrentProcess(), &ftCreation, &ftExit, &ftKernel, &ftUser))
+      return 0;
+
+    ULARGE_INTEGER k, u; //kernel and user times as 64-bit integers
+    k.LowPart = ftKernel.dwLowDateTime; k.HighPart = ftKernel.dwHighDateTime;
+    u.LowPart = ftUser.dwLowDateTime; u.HighPart = ftUser.dwHighDateTime;
+
+    return (k.QuadPart + u.QuadPart)*1e-7;
+  #else
+    return (double)std::clock()/CLOCKS_PER_SEC;
+  #endif
+} //GetProcessCPUTime
+
+/// Get the CPU time used by the calling thread so far. On Windows this is the
+/// sum of the user and kernel times from `GetThreadTimes()`. Elsewhere it is
+/// from `clock_gettime()` with `CLOCK_THREAD_CPUTIME_ID`.
+/// \return CPU time in seconds.
+
+double CTimer::GetThreadCPUTime(){
+  #ifdef _WIN32
+    FILETIME ftCreation, ftExit, ftKernel, ftUser; //in units of 100ns
+
+    if(!GetThreadTimes(GetCurrentThread(), &ftCreation, &ftExit, &ftKernel, &ftUser))
+      return 0;
+
+    ULARGE_INTEGER k, u; //kernel and user times as 64-bit integers
+    k.LowPart = ftKernel.dwLowDateTime; k.HighPart = ftKernel.dwHighDateTime;
+    u.LowPart = ftUser.dwLowDateTime; u.HighPart = ftUser.dwHighDateTime;
+
+    return (k.QuadPart + u.QuadPart)*1e-7;
+  #else
+    timespec t; //CPU time
+
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) != 0)
+      return 0;
+
+    return t.tv_sec + 1e-9*t.tv_nsec;
+  #endif
+} //GetThreadCPUTime
+
+/// Format a time in hours, minutes, and seconds, omitting leading fields
+/// that are zero, for example "1 hr 2 min 3.45 sec".
+/// \param t Time in seconds.
+/// \return Time as a string.
+
+std::string CTimer::Format(const double t){
+  const size_t nSeconds = (size_t)t; //whole seconds
+  const size_t h = nSeconds/3600; //hours
+  const size_t m = (nSeconds/60)%60; //minutes
+  const double s = t - 60.0*(60.0*h + m); //seconds
+
+  char buffer[64];
+  
+  if(h > 0)
+    snprintf(buffer, sizeof(buffer), "%zu hr %zu min %.2f sec", h, m, s);
+  else if(m > 0)
+    snprintf(buffer, sizeof(buffer), "%zu min %.2f sec", m, s);
+  else snprintf(buffer, sizeof(buffer), "%.2f sec", s);
+
+  return std::string(buffer);
+} //Format
+
+/// Get the elapsed time since `CTimer::Start()` was last called.
+/// \return Elapsed time in seconds.
+
+double CTimer::GetElapsedSeconds() const{
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - m_tStart;
+  return t.count();
+} //GetElapsedSeconds
+
+/// Get the CPU time used by all threads since `CTimer::Start()` was last
+/// called.
+/// \return CPU time in seconds.
+
+double CTimer::GetCPUSeconds() const{
+  return GetProcessCPUTime() - m_fStartCPU;
+} //GetCPUSeconds
+
+/// Get the elapsed time since `CTimer::Start()` was last called.
+/// \return Elapsed time as a string.
+
+std::string CTimer::GetElapsedTime() const{
+  return Format(GetElapsedSeconds());
+} //GetElapsedTime
+
+/// Get the CPU time used by all threads since `CTimer::Start()` was last
+/// called.
+/// \return CPU time as a string.
+
+std::string CTimer::GetCPUTime() const{
+  return Format(GetCPUSeconds());
+} //GetCPUTime
+
+/// Get the current local time and date.
+/// \return Time and date as a string.
+
+std::string CTimer::GetTimeAndDate() const{
+  const std::time_t t = std::time(nullptr); //current time
+  std::tm tm; //broken down into fields
+
+  #ifdef _WIN32
+    localtime_s(&tm, &t);
+  #else
+    localtime_r(&t, &tm);
+  #endif
+
+  char buffer[64];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+
+  return std::string(buffer);
+} //GetTimeAndDate
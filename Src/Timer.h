@@ -0,0 +1,62 @@
+/// \file Timer.h
+/// \brief Header for the timer `CTimer`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Timer_h__
+#define __Timer_h__
+
+#include <chrono>
+#include <string>
+
+/// \brief Timer.
+///
+/// A portable timer for the elapsed (wall clock) time and the CPU time
+/// used by all threads of this process since it was started, together with
+/// the current time and date, all formatted as strings for the log file.
+/// `CTimer::GetThreadCPUTime()` gets the CPU time used by the calling thread,
+/// so that the CPU time of a single task can be measured.
+/// This replaces `CTimer` from the `thread++` library.
+
+class CTimer{
+  private:
+    std::chrono::steady_clock::time_point m_tStart; ///< Elapsed time at start.
+    double m_fStartCPU = 0; ///< CPU time at start, in seconds.
+
+    static double GetProcessCPUTime(); ///< Get CPU time used by this process.
+
+  public:
+    CTimer(); ///< Constructor.
+
+    void Start(); ///< Start timing.
+    double GetElapsedSeconds() const; ///< Get elapsed time in seconds.
+    double GetCPUSeconds() const; ///< Get CPU time in seconds.
+    std::string GetElapsedTime() const; ///< Get elapsed time as a string.
+    std::string GetCPUTime() const; ///< Get CPU time as a string.
+    std::string GetTimeAndDate() const; ///< Get current time and date as a string.
+
+    static std::string Format(const double); ///< Format a time in seconds.
+    static double GetThreadCPUTime(); ///< Get CPU time used by this thread.
+}; //CTimer
+
+#endif //__Timer_h__
@@ -0,0 +1,157 @@
+/// \file Trace.cpp
+/// \brief Code for the task trace `CTrace`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Trace.h"
+#include "Timer.h"
+
+/// Compare task records by the time that they took, for sorting the slowest
+/// first.
+/// \param r0 A task record.
+/// \param r1 Another task record.
+/// \return true if the first task took longer than the second.
+
+static bool Slower(const CTaskRecord& r0, const CTaskRecord& r1){
+  return r0.m_tFinish - r0.m_tStart > r1.m_tFinish - r1.m_tStart;
+} //Slower
+
+/// Start the run, discarding any task records from a previous run.
+/// \param n Number of threads.
+
+void CTrace::Start(const size_t n){
+  m_stlRecord.clear();
+  m_nNumThreads = n;
+  m_tStart = m_tFinish = std::chrono::steady_clock::now();
+} //Start
+
+/// Finish the run, after all threads have finished.
+
+void CTrace::Finish(){
+  m_tFinish = std::chrono::steady_clock::now();
+} //Finish
+
+/// Add the record of a task that has been performed.
+/// \param r Task record.
+
+void CTrace::Add(const CTaskRecord& r){
+  m_stlRecord.push_back(r);
+} //Add
+
+/// Get the time from the start of the run to a given time.
+/// \param t Time.
+/// \return Number of seconds since the start of the run.
+
+const double CTrace::GetSeconds(const std::chrono::steady_clock::time_point& t) const{
+  const std::chrono::duration<double> d = t - m_tStart; //time since start
+  return d.count();
+} //GetSeconds
+
+/// Save the task records to a trace file in the Chrome trace event format,
+/// that is, a JSON object with an array of events, one complete event for
+/// each task on the track of the thread that performed it, with its CPU
+/// time, number of matchings visited, number of candidates processed, and
+/// number of sorting networks found as arguments. The tracks are named after
+/// the threads by metadata events. Times are in microseconds from the start
+/// of the run.
+/// \param strFile File name.
+/// \return true if the file was written.
+
+bool CTrace::Save(const std::string& strFile) const{
+  std::ofstream f(strFile);
+
+  if(!f.is_open())
+    return false;
+
+  f << std::fixed << std::setprecision(3);
+  f << "{" << std::endl;
+  f << "  \"displayTimeUnit\": \"ms\"," << std::endl;
+  f << "  \"traceEvents\": [";
+
+  for(size_t i=0; i<m_nNumThreads; i++)
+    f << (i? ",": "") << std::endl << "    {\"name\": \"thread_name\", " <<
+      "\"ph\": \"M\", \"pid\": 0, \"tid\": " << i << ", " <<
+      "\"args\": {\"name\": \"thread " << i << "\"}}";
+
+  for(const CTaskRecord& r: m_stlRecord)
+    f << "," << std::endl << "    {\"name\": \"task " << r.m_nIndex << "\", " <<
+      "\"cat\": \"task\", \"ph\": \"X\", " <<
+      "\"ts\": " << 1e6*GetSeconds(r.m_tStart) << ", " <<
+      "\"dur\": " << 1e6*(GetSeconds(r.m_tFinish) - GetSeconds(r.m_tStart)) << ", " <<
+      "\"pid\": 0, \"tid\": " << r.m_nThread << ", " <<
+      "\"args\": {\"cpu_seconds\": " << r.m_fCPUSeconds << ", " <<
+      "\"nodes\": " << r.m_nNodes << ", " <<
+      "\"candidates\": " << r.m_nCandidates << ", " <<
+      "\"found\": " << r.m_nCount << "}}";
+
+  f << std::endl << "  ]" << std::endl;
+  f << "}" << std::endl;
+
+  return !f.fail();
+} //Save
+
+/// Print the slowest tasks, with the time and CPU time that they took and
+/// the numbers of matchings visited and candidates processed, followed by
+/// the time that each thread spent busy and idle.
+/// \param s [out] Stream to print to.
+/// \param n Maximum number of tasks to print.
+
+void CTrace::Summarize(std::ostream& s, const size_t n) const{
+  std::vector<CTaskRecord> slowest(m_stlRecord); //task records, slowest first
+  const size_t nSlowest = std::min(n, slowest.size()); //number of tasks to print
+  std::partial_sort(slowest.begin(), slowest.begin() + nSlowest, slowest.end(), Slower);
+
+  if(nSlowest > 0)
+    s << "Slowest tasks:" << std::endl;
+
+  for(size_t i=0; i<nSlowest; i++){
+    const CTaskRecord& r = slowest[i]; //task record
+
+    s << "  task " << r.m_nIndex << " on thread " << r.m_nThread << " took " <<
+      CTimer::Format(GetSeconds(r.m_tFinish) - GetSeconds(r.m_tStart)) <<
+      " using " << CTimer::Format(r.m_fCPUSeconds) << " CPU time, " <<
+      r.m_nNodes << " nodes, " << r.m_nCandidates << " candidates" << std::endl;
+  } //for
+
+  const double fElapsed = GetSeconds(m_tFinish); //length of run
+  std::vector<double> busy(m_nNumThreads, 0); //time each thread spent on tasks
+
+  for(const CTaskRecord& r: m_stlRecord)
+    if(r.m_nThread < m_nNumThreads)
+      busy[r.m_nThread] += GetSeconds(r.m_tFinish) - GetSeconds(r.m_tStart);
+
+  for(size_t i=0; i<m_nNumThreads; i++){
+    const double fIdle = std::max(fElapsed - busy[i], 0.0); //time idle
+    std::ostringstream percent; //idle time as a percentage of the run
+    percent << std::fixed << std::setprecision(1) <<
+      (fElapsed > 0? 100*fIdle/fElapsed: 0) << "%";
+
+    s << "Thread " << i << " busy " << CTimer::Format(busy[i]) << ", idle " <<
+      CTimer::Format(fIdle) << " (" << percent.str() << ")" << std::endl;
+  } //for
+} //Summarize
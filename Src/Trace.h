@@ -0,0 +1,80 @@
+/// \file Trace.h
+/// \brief Header for the task trace `CTrace`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Trace_h__
+#define __Trace_h__
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// \brief Task record.
+///
+/// The record of one task performed by a thread, made by `CTask::Perform()`
+/// and completed by `CTask::GetRecord()` with the counters of its searchable
+/// sorting network.
+
+class CTaskRecord{
+  public:
+    size_t m_nIndex = 0; ///< Task index.
+    size_t m_nThread = 0; ///< Index of the thread that performed it.
+    std::chrono::steady_clock::time_point m_tStart; ///< When it started.
+    std::chrono::steady_clock::time_point m_tFinish; ///< When it finished.
+    double m_fCPUSeconds = 0; ///< CPU time used, in seconds.
+    size_t m_nNodes = 0; ///< Number of matchings visited.
+    size_t m_nCandidates = 0; ///< Number of candidates processed.
+    size_t m_nCount = 0; ///< Number of sorting networks found.
+}; //CTaskRecord
+
+/// \brief Task trace.
+///
+/// The records of the tasks performed in a run of the thread manager, from
+/// which it can save a trace file in the Chrome trace event format, which can
+/// be viewed in `chrome://tracing` or Perfetto with a track for each thread,
+/// and summarize the slowest tasks and the time that each thread spent idle,
+/// to show how well the tasks are split and ordered. A thread is idle from
+/// the start of the run to the end, apart from the time that it spends
+/// performing tasks.
+
+class CTrace{
+  private:
+    std::vector<CTaskRecord> m_stlRecord; ///< Task records.
+    std::chrono::steady_clock::time_point m_tStart; ///< Start of the run.
+    std::chrono::steady_clock::time_point m_tFinish; ///< End of the run.
+    size_t m_nNumThreads = 0; ///< Number of threads.
+
+    const double GetSeconds(const std::chrono::steady_clock::time_point&) const; ///< Get time since start.
+
+  public:
+    void Start(const size_t); ///< Start the run.
+    void Finish(); ///< Finish the run.
+    void Add(const CTaskRecord&); ///< Add a task record.
+
+    bool Save(const std::string&) const; ///< Save trace file.
+    void Summarize(std::ostream&, const size_t) const; ///< Summarize the slowest tasks and idle time.
+}; //CTrace
+
+#endif //__Trace_h__
@@ -0,0 +1,198 @@
+/// \file WitnessCache.cpp
+/// \brief Code for the counterexample cache `CWitnessCache`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "WitnessCache.h"
+#include "Kernel.h"
+
+/// Move a witness to the front of the cache, shifting the ones in front of
+/// it back by one place.
+/// \param i Index of witness.
+
+void CWitnessCache::MoveToFront(const size_t i){
+  if(i == 0 || i >= m_nSize)return; //nothing to do
+
+  uint32_t nMask[MAXINPUTS]; //temporary copy of witness i
+  uint8_t nTarget[MAXWITNESSLEN]; //and its sorted output channels
+  const size_t nLength = m_nLength[i]; //and its length
+
+  for(size_t j=0; j<m_nWidth; j++)
+    nMask[j] = m_nMask[i][j];
+
+  for(size_t t=0; t<nLength; t++)
+    nTarget[t] = m_nTarget[i][t];
+
+  for(size_t w=i; w>0; w--){ //shift the others back
+    for(size_t j=0; j<m_nWidth; j++)
+      m_nMask[w][j] = m_nMask[w - 1][j];
+
+    for(size_t t=0; t<m_nLength[w - 1]; t++)
+      m_nTarget[w][t] = m_nTarget[w - 1][t];
+
+    m_nLength[w] = m_nLength[w - 1];
+  } //for
+
+  for(size_t j=0; j<m_nWidth; j++)
+    m_nMask[0][j] = nMask[j];
+
+  for(size_t t=0; t<nLength; t++)
+    m_nTarget[0][t] = nTarget[t];
+
+  m_nLength[0] = nLength;
+} //MoveToFront
+
+/// Insert a new witness at the front of the cache, evicting the least
+/// recently used one if the cache is full. Duplicate test input changes are
+/// dropped, and the witness is truncated if it is too long.
+/// \param witness Array of encoded test input changes.
+/// \param n Number of entries in the witness array.
+
+void CWitnessCache::Insert(const uint32_t witness[], const size_t n){
+  if(m_nSize < MAXWITNESSES)
+    m_nSize++;
+
+  MoveToFront(m_nSize - 1); //recycle the last slot
+
+  uint32_t* mask = m_nMask[0]; //bit-sliced witness
+  size_t& nLength = m_nLength[0]; //its length
+  nLength = 0;
+
+  for(size_t j=0; j<m_nWidth; j++)
+    mask[j] = 0;
+
+  for(size_t i=0; i<n && nLength<MAXWITNESSLEN; i++){
+    bool bDuplicate = false; //whether witness[i] is already there
+
+    for(size_t s=0; s<i && !bDuplicate; s++)
+      bDuplicate = witness[s] == witness[i];
+
+    if(!bDuplicate){
+      const size_t nInput = witness[i] & 0xFFFF; //input before change
+      const size_t delta = witness[i] >> 16; //channel to flip
+      const size_t nOutput = nInput ^ ((size_t)1 << delta); //input after change
+      const size_t nZeros = m_nWidth - PopCount(nInput); //zeros before change
+
+      for(size_t j=0; j<m_nWidth; j++){
+        mask[j] |= (uint32_t)((nInput >> j) & 1) << nLength;
+        mask[j] |= (uint32_t)((nOutput >> j) & 1) << (nLength + 16);
+      } //for
+
+      m_nTarget[0][nLength++] = (uint8_t)((nInput >> delta) & 1? nZeros: nZeros - 1);
+    } //if
+  } //for
+} //Insert
+
+/// Count a lookup, that is, a candidate that the cached witnesses are about
+/// to be tried on.
+
+void CWitnessCache::Lookup(){
+  m_nLookups++;
+} //Lookup
+
+/// Count a hit, that is, a candidate refuted by a cached witness, and move
+/// that witness to the front of the cache.
+/// \param i Index of witness.
+
+void CWitnessCache::Hit(const size_t i){
+  m_nHits++;
+  MoveToFront(i);
+} //Hit
+
+/// Count a rejected candidate.
+/// \param n Number of test input changes tried before it was rejected.
+
+void CWitnessCache::Reject(const size_t n){
+  m_nRejects++;
+  m_nRejectTests += n;
+} //Reject
+
+/// Add the counters from another cache to the ones in this cache.
+/// \param c Another cache.
+
+void CWitnessCache::Accumulate(const CWitnessCache& c){
+  m_nLookups += c.m_nLookups;
+  m_nHits += c.m_nHits;
+  m_nRejects += c.m_nRejects;
+  m_nRejectTests += c.m_nRejectTests;
+} //Accumulate
+
+/// Reader function for the number of witnesses in the cache.
+/// \return Number of witnesses.
+
+const size_t CWitnessCache::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+/// Reader function for the length of a witness.
+/// \param i Index of witness.
+/// \return Number of test input changes in witness i.
+
+const size_t CWitnessCache::GetLength(const size_t i) const{
+  return m_nLength[i];
+} //GetLength
+
+/// Reader function for a bit-sliced witness.
+/// \param i Index of witness.
+/// \return Pointer to the channel masks of witness i.
+
+const uint32_t* CWitnessCache::GetMask(const size_t i) const{
+  return m_nMask[i];
+} //GetMask
+
+/// Reader function for the sorted output channels that change in a witness.
+/// \param i Index of witness.
+/// \return Pointer to the sorted output channels of witness i.
+
+const uint8_t* CWitnessCache::GetTarget(const size_t i) const{
+  return m_nTarget[i];
+} //GetTarget
+
+/// Reader function for the number of lookups.
+/// \return Number of lookups.
+
+const size_t CWitnessCache::GetLookups() const{
+  return m_nLookups;
+} //GetLookups
+
+/// Reader function for the number of hits.
+/// \return Number of hits.
+
+const size_t CWitnessCache::GetHits() const{
+  return m_nHits;
+} //GetHits
+
+/// Reader function for the number of rejected candidates.
+/// \return Number of rejected candidates.
+
+const size_t CWitnessCache::GetRejects() const{
+  return m_nRejects;
+} //GetRejects
+
+/// Reader function for the number of test input changes tried on rejected
+/// candidates.
+/// \return Number of test input changes.
+
+const size_t CWitnessCache::GetRejectTests() const{
+  return m_nRejectTests;
+} //GetRejectTests
@@ -0,0 +1,89 @@
+/// \file WitnessCache.h
+/// \brief Interface for the counterexample cache `CWitnessCache`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __WitnessCache_h__
+#define __WitnessCache_h__
+
+#include <cstdint>
+
+#include "Defines.h"
+#include "Settings.h"
+
+/// \brief Counterexample cache.
+///
+/// Most candidate comparator networks fail the sorting test, and consecutive
+/// candidates differ only in their bottom levels, so the test inputs that
+/// caused one candidate to fail will usually cause the next one to fail too.
+/// A _witness_ is a short list of test input changes, each of which is given
+/// to `CWitnessCache::Insert()` encoded as the input to the second level in
+/// the low 16 bits and the index of the channel to flip in the high 16 bits.
+/// A witness refutes a candidate if the pairs of channels that these changes
+/// connect already break the test. The cache keeps the most recent witnesses
+/// in move-to-front order so that they can be tried before the full Gray code
+/// sweep.
+///
+/// Each witness is stored bit-sliced in the manner of `CBitSlice`, with one
+/// 32-bit mask per channel. Bit `t` of a mask holds the value on that channel
+/// before test input change `t`, and bit `t + 16` holds the value after it, so
+/// that a witness can be pushed through a comparator network all at once.
+/// The channel of the sorted output that changes is stored alongside.
+///
+/// The cache also counts lookups, hits, rejected candidates, and the number of
+/// test input changes that were tried before each rejection, so that the
+/// effect of the cache can be measured.
+
+class CWitnessCache: public CSettings{
+  private:
+    uint32_t m_nMask[MAXWITNESSES][MAXINPUTS] = {{0}}; ///< Bit-sliced witnesses, most recent first.
+    uint8_t m_nTarget[MAXWITNESSES][MAXWITNESSLEN] = {{0}}; ///< Sorted output channel that changes.
+    size_t m_nLength[MAXWITNESSES] = {0}; ///< Number of test input changes in each witness.
+    size_t m_nSize = 0; ///< Number of witnesses in the cache.
+
+    size_t m_nLookups = 0; ///< Number of candidates looked up.
+    size_t m_nHits = 0; ///< Number of candidates refuted by a cached witness.
+    size_t m_nRejects = 0; ///< Number of candidates rejected.
+    size_t m_nRejectTests = 0; ///< Test input changes tried on rejected candidates.
+
+    void MoveToFront(const size_t); ///< Move a witness to the front.
+
+  public:
+    void Insert(const uint32_t[], const size_t); ///< Insert a new witness.
+    void Lookup(); ///< Count a lookup.
+    void Hit(const size_t); ///< Count a hit on a witness.
+    void Reject(const size_t); ///< Count a rejected candidate.
+    void Accumulate(const CWitnessCache&); ///< Add counters from another cache.
+
+    const size_t GetSize() const; ///< Get number of witnesses.
+    const size_t GetLength(const size_t) const; ///< Get length of a witness.
+    const uint32_t* GetMask(const size_t) const; ///< Get bit-sliced witness.
+    const uint8_t* GetTarget(const size_t) const; ///< Get sorted output channels.
+
+    const size_t GetLookups() const; ///< Get number of lookups.
+    const size_t GetHits() const; ///< Get number of hits.
+    const size_t GetRejects() const; ///< Get number of rejected candidates.
+    const size_t GetRejectTests() const; ///< Get number of tests on rejected candidates.
+}; //CWitnessCache
+
+#endif //__WitnessCache_h__
@@ -0,0 +1,181 @@
+/// \file Worker.cpp
+/// \brief Code for the worker `CWorker`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include <chrono>
+#include <sstream>
+
+#include "Worker.h"
+#include "Defines.h"
+
+/// Destructor. Disconnect if still connected.
+
+CWorker::~CWorker(){
+  Disconnect();
+} //destructor
+
+/// Connect to the coordinator and start the heartbeat thread.
+/// \param strHost Host name or address of the coordinator.
+/// \param strPort Port number of the coordinator.
+/// \return true if connected.
+
+bool CWorker::Connect(const std::string& strHost, const std::string& strPort){
+  if(!m_cSocket.Connect(strHost, strPort))
+    return false;
+
+  m_bConnected = true;
+  m_stdHeartbeat = std::thread(&CWorker::Heartbeat, this);
+
+  return true;
+} //Connect
+
+/// Stop the heartbeat thread and disconnect from the coordinator.
+
+void CWorker::Disconnect(){
+  {
+    std::lock_guard<std::mutex> lock(m_stdHeartbeatMutex);
+    m_bConnected = false;
+    m_stdHeartbeatCV.notify_all();
+  }
+
+  if(m_stdHeartbeat.joinable())
+    m_stdHeartbeat.join();
+
+  m_cSocket.Close();
+} //Disconnect
+
+/// Send a message to the coordinator. The heartbeat thread sends messages
+/// too, so this is done under a mutex.
+/// \param strLine Message.
+/// \return true if it was sent.
+
+bool CWorker::Send(const std::string& strLine){
+  std::lock_guard<std::mutex> lock(m_stdSendMutex);
+  return m_cSocket.Send(strLine);
+} //Send
+
+/// Send `alive` to the coordinator every `HEARTBEATINTERVAL` seconds until
+/// disconnected.
+
+void CWorker::Heartbeat(){
+  std::unique_lock<std::mutex> lock(m_stdHeartbeatMutex);
+
+  while(m_bConnected){
+    m_stdHeartbeatCV.wait_for(lock, std::chrono::seconds(HEARTBEATINTERVAL));
+
+    if(m_bConnected)
+      Send("alive");
+  } //while
+} //Heartbeat
+
+/// Say hello to the coordinator and get the settings line in reply.
+/// \param strSettings [out] Settings line.
+/// \return true if the settings line was received.
+
+bool CWorker::GetSettings(std::string& strSettings){
+  const std::string strTag = "settings "; //reply tag
+
+  if(!Send("hello") || !m_cSocket.ReadLine(strSettings) ||
+    strSettings.compare(0, strTag.size(), strTag) != 0)
+    return false;
+
+  strSettings.erase(0, strTag.size());
+  return true;
+} //GetSettings
+
+/// Get the next task from the coordinator, waiting a second and asking again
+/// for as long as the coordinator says to wait.
+/// \param strTask [out] Task description.
+/// \return true if a task was received, false if the search is done or the
+/// connection has failed.
+
+bool CWorker::GetTask(std::string& strTask){
+  const std::string strTag = "task "; //reply tag
+
+  while(Send("next") && m_cSocket.ReadLine(strTask)){
+    if(strTask.compare(0, strTag.size(), strTag) == 0){ //got one
+      strTask.erase(0, strTag.size());
+      return true;
+    } //if
+
+    if(strTask != "wait")
+      return false; //done, or something unexpected
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  } //while
+
+  return false;
+} //GetTask
+
+/// Report the result of a task to the coordinator, that is, send each of
+/// the sorting networks that it found, as kept in memory by `C2NF::Save()`,
+/// with the task index and the order in which it was found, followed by the
+/// count and CPU time.
+/// \param index Task index.
+/// \param nCount Number of sorting networks found.
+/// \param fCPU CPU time used, in seconds.
+/// \param networks Sorting networks found, one line per level.
+/// \return true if the result was sent.
+
+bool CWorker::Report(const size_t index, const size_t nCount, const double fCPU,
+  const std::vector<std::string>& networks)
+{
+  for(size_t i=0; i<networks.size(); i++){ //for each sorting network found
+    std::istringstream f(networks[i]);
+    std::string strLine; //one line of the network
+    std::string strContents; //lines separated by '|'
+
+    for(size_t j=0; std::getline(f, strLine); j++)
+      strContents += (j > 0? "|": "") + strLine;
+
+    if(!Send("network " + std::to_string(index) + " " + std::to_string(i) +
+      " " + strContents))
+      return false;
+  } //for
+
+  std::ostringstream s;
+  s << "result " << index << " " << nCount << " " << fCPU;
+
+  if(!Send(s.str()))
+    return false;
+
+  m_nNumTasks++;
+  m_nCount += nCount;
+
+  return true;
+} //Report
+
+/// Reader function for the number of tasks performed.
+/// \return The number of tasks performed.
+
+const size_t CWorker::GetNumTasks() const{
+  return m_nNumTasks;
+} //GetNumTasks
+
+/// Reader function for the number of sorting networks found.
+/// \return The count.
+
+const size_t CWorker::GetCount() const{
+  return m_nCount;
+} //GetCount
@@ -0,0 +1,79 @@
+/// \file Worker.h
+/// \brief Header for the worker `CWorker`.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef __Worker_h__
+#define __Worker_h__
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Socket.h"
+
+/// \brief Worker.
+///
+/// A worker's end of the connection to the coordinator `CCoordinator`, whose
+/// comments describe the messages. The worker asks for tasks one at a time,
+/// performs each of them with `CTask::Perform()`, keeping the sorting
+/// networks found in memory (see `CSearchableBase::KeepNetworks()`), and then
+/// sends them and the count to the coordinator, which saves them to files.
+/// The worker saves no files, so any number of workers can share a folder. While it is connected, a heartbeat thread
+/// tells the coordinator every `HEARTBEATINTERVAL` seconds that it is still
+/// alive, however long a task takes.
+
+class CWorker{
+  private:
+    CSocket m_cSocket; ///< Socket connected to the coordinator.
+    std::mutex m_stdSendMutex; ///< Mutex for sending.
+
+    std::thread m_stdHeartbeat; ///< Heartbeat thread.
+    std::mutex m_stdHeartbeatMutex; ///< Mutex for stopping the heartbeat.
+    std::condition_variable m_stdHeartbeatCV; ///< Condition variable for stopping the heartbeat.
+    bool m_bConnected = false; ///< Whether the heartbeat is to keep going.
+
+    size_t m_nNumTasks = 0; ///< Number of tasks performed.
+    size_t m_nCount = 0; ///< Number of sorting networks found.
+
+    bool Send(const std::string&); ///< Send a message.
+    void Heartbeat(); ///< Send heartbeats until disconnected.
+
+  public:
+    ~CWorker(); ///< Destructor.
+
+    bool Connect(const std::string&, const std::string&); ///< Connect to the coordinator.
+    void Disconnect(); ///< Disconnect from the coordinator.
+
+    bool GetSettings(std::string&); ///< Get the settings line.
+    bool GetTask(std::string&); ///< Get a task.
+    bool Report(const size_t, const size_t, const double,
+      const std::vector<std::string>&); ///< Report the result of a task.
+
+    const size_t GetNumTasks() const; ///< Get number of tasks performed.
+    const size_t GetCount() const; ///< Get count.
+}; //CWorker
+
+#endif //__Worker_h__
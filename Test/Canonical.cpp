@@ -0,0 +1,186 @@
+/// \file Canonical.cpp
+/// \brief Canonical forms of sorting networks for the regression checks.
+
+// MIT License
+//
+// Copyright (c) 2023 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// Print one line for each sorting network file named on the command line,
+// in the format saved by `CComparatorNetwork::Save()`, giving a canonical
+// form of the network up to symmetry. Two first normal form networks get
+// the same canonical form if and only if one is mapped to the other by
+// permuting the channels, possibly exchanging min and max, and untwisting.
+//
+// Untwisting a comparator that sends its minimum to the channel below its
+// maximum turns it the right way up and exchanges its two channels in the
+// levels below it, so the untwisted image of a network depends only on which
+// channel each comparator's minimum is sent to, and the images of a network
+// with identity first level that also have identity first level are those
+// under the permutations of its first level pairs, with or without min and
+// max exchanged. The canonical form is the smallest of these.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \brief Comparator network.
+///
+/// The levels of a comparator network, each a list of comparators that send
+/// the minimum to the first channel and the maximum to the second.
+
+typedef std::vector<std::vector<std::pair<size_t, size_t>>> Network;
+
+/// \brief Read a comparator network.
+///
+/// Read a comparator network from a file with one line per level, each
+/// consisting of pairs of channels, and find its width.
+/// \param strFile File name.
+/// \param net [out] Comparator network.
+/// \param n [out] Width, that is, one more than the largest channel.
+/// \return true if the file was read.
+
+bool Read(const std::string& strFile, Network& net, size_t& n){
+  std::ifstream f(strFile); //input file
+  std::string strLine; //a level
+
+  if(!f.is_open())
+    return false;
+
+  while(std::getline(f, strLine)){ //for each level
+    std::istringstream s(strLine);
+    std::vector<std::pair<size_t, size_t>> level; //comparators in this level
+    size_t a = 0, b = 0; //channels of a comparator
+
+    while(s >> a >> b){
+      level.push_back(std::make_pair(a, b));
+      n = std::max(n, std::max(a, b) + 1);
+    } //while
+
+    net.push_back(level);
+  } //while
+
+  return true;
+} //Read
+
+/// \brief Untwisted image of a comparator network.
+///
+/// Map the channels of a comparator network, possibly exchanging min and
+/// max, untwist it, and describe the result with its comparators in order.
+/// \param net Comparator network.
+/// \param pi Channel that each channel is mapped to.
+/// \param bNegate true to exchange min and max.
+/// \return Description of the untwisted image.
+
+std::string Image(const Network& net, std::vector<size_t> pi, const bool bNegate){
+  std::string str; //result
+
+  for(const std::vector<std::pair<size_t, size_t>>& level: net){ //for each level
+    std::vector<std::pair<size_t, size_t>> image; //image of this level
+
+    for(const std::pair<size_t, size_t>& c: level){ //for each comparator
+      size_t u = pi[c.first]; //channel that gets the minimum
+      size_t v = pi[c.second]; //channel that gets the maximum
+
+      if(bNegate)
+        std::swap(u, v);
+
+      if(u > v){ //upside down, so untwist
+        for(size_t& x: pi)
+          if(x == u)x = v;
+          else if(x == v)x = u;
+
+        std::swap(u, v);
+      } //if
+
+      image.push_back(std::make_pair(u, v));
+    } //for
+
+    std::sort(image.begin(), image.end());
+
+    for(const std::pair<size_t, size_t>& c: image)
+      str += std::to_string(c.first) + " " + std::to_string(c.second) + " ";
+
+    str += "|";
+  } //for
+
+  return str;
+} //Image
+
+/// \brief Canonical form of a comparator network.
+///
+/// Find the smallest untwisted image of a first normal form comparator
+/// network under the permutations of its first level pairs, with and
+/// without min and max exchanged.
+/// \param net Comparator network with first level (0, 1), (2, 3), and so on.
+/// \param n Width.
+/// \return Canonical form.
+
+std::string Canonical(const Network& net, const size_t n){
+  std::vector<size_t> q(n/2); //permutation of pairs
+  std::string strMin; //smallest image so far
+
+  for(size_t i=0; i<q.size(); i++)
+    q[i] = i;
+
+  do{ //for each permutation of pairs
+    std::vector<size_t> pi(n); //permutation of channels
+
+    for(size_t j=0; j<n; j++)
+      pi[j] = j < 2*q.size()? 2*q[j/2] + (j & 1): j;
+
+    for(size_t r=0; r<2; r++){ //without and with min and max exchanged
+      const std::string str = Image(net, pi, r == 1); //image
+
+      if(strMin.empty() || str < strMin)
+        strMin = str;
+    } //for
+  }while(std::next_permutation(q.begin(), q.end()));
+
+  return strMin;
+} //Canonical
+
+/// \brief Main.
+///
+/// Print the canonical form of the comparator network in each file named on
+/// the command line, one per line, in the same order.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
+/// \return 0 if every file was read, 1 otherwise.
+
+int main(int argc, char* argv[]){
+  for(int i=1; i<argc; i++){ //for each file
+    Network net; //comparator network
+    size_t n = 0; //width
+
+    if(!Read(argv[i], net, n)){
+      std::cerr << "Cannot read " << argv[i] << std::endl;
+      return 1;
+    } //if
+
+    std::cout << Canonical(net, n) << std::endl;
+  } //for
+
+  return 0;
+} //main
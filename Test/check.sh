@@ -0,0 +1,212 @@
+#!/bin/sh
+# Regression checks for the sorting network search. Run with `make check`,
+# which builds ./search first. Each check runs the search in a scratch
+# directory, answering its prompts from a string, and compares the number
+# of sorting networks found with a known count.
+
+set -u
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+SEARCH=$ROOT/search
+CANONICAL=$ROOT/Build/canonical
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cd "$DIR" || exit 1
+FAILED=0
+
+# count answers [option...]: run a search in a fresh directory, answering its
+# prompts with answers, and print the number of sorting networks found.
+
+count(){
+  answers=$1; shift
+  rm -f ./*.txt ./*.json
+  printf "$answers" | "$SEARCH" "$@" 2>&1 | sed -n 's/^\([0-9]*\) found in .*/\1/p'
+}
+
+# expect name expected actual: report whether a check got the expected value.
+
+expect(){
+  if [ "$3" = "$2" ]; then
+    echo "pass: $1"
+  else
+    echo "FAIL: $1: expected $2, got '$3'"
+    FAILED=1
+  fi
+}
+
+# second answers: print the number of second level candidates, which is
+# reported before the search starts, so stop reading there.
+
+second(){
+  rm -f ./*.txt ./*.json
+  printf "$1" | "$SEARCH" --estimate 2>&1 |
+    sed -n '/second levels found/{s/^[^0-9]*\([0-9]*\) second levels found.*/\1/p;q;}'
+}
+
+# Reducing second levels by reflection must leave this many candidates for
+# each width and depth, out of this many without it. It almost halves them
+# for odd widths, but hardly changes them for even widths, where the mirror
+# image of a second level is nearly always a permutation of its pairs. The
+# networks that it maps to each other are found only once.
+
+for width in "3 3 3 2" "4 3 3 3" "5 5 9 6" "6 5 5 5" "7 6 23 14" "8 6 12 12" \
+  "9 6 58 35" "10 6 20 20" "11 7 136 78" "12 7 44 43"; do
+  set -- $width
+  if [ $2 -ge 5 ]; then ns2='n\n'; else ns2=''; fi
+  expect "$1 inputs second levels" $3 "$(second "$1\n$2\n${ns2}n\nn\nn\nn\nn\n0\n0\n")"
+  expect "$1 inputs second levels with reflection" $4 "$(second "$1\n$2\n${ns2}n\nn\nn\ny\nn\n0\n0\n")"
+done
+
+# classes answers: run a search like count, and print the number of sorting
+# networks found that are distinct up to symmetry, and a checksum of their
+# canonical forms.
+
+classes(){
+  rm -f ./*.txt ./*.json
+  printf "$1" | "$SEARCH" >/dev/null 2>&1
+  "$CANONICAL" w*.txt | sort -u >canonical.txt
+  echo $(wc -l <canonical.txt) $(cksum <canonical.txt)
+}
+
+# Without reduction by reflection or skipping symmetric third levels, the
+# search must find as many as earlier versions. Each of them, and both
+# together, may find fewer, but only by leaving out networks equivalent up to
+# symmetry to ones that are found, so the canonical forms of the networks
+# found must be the same.
+
+for size in "5 5 90 78 56 44" "6 5 20 12 20 12" "7 6 2086 1926 1055 969" \
+  "8 6 861 627 861 627"; do
+  set -- $size
+  all=$(classes "$1\n$2\nn\nn\nn\nn\nn\nn\n0\n0\n")
+  expect "$1x$2 without symmetries" $3 "$(count "$1\n$2\nn\nn\nn\nn\nn\nn\n0\n0\n")"
+  expect "$1x$2 skipping symmetric third levels" $4 "$(count "$1\n$2\nn\nn\nn\nn\nn\ny\n0\n0\n")"
+  expect "$1x$2 reducing by reflection" $5 "$(count "$1\n$2\nn\nn\nn\nn\ny\nn\n0\n0\n")"
+  expect "$1x$2 with both" $6 "$(count "$1\n$2\nn\nn\nn\nn\ny\ny\n0\n0\n")"
+  expect "$1x$2 classes skipping symmetric third levels" "$all" "$(classes "$1\n$2\nn\nn\nn\nn\nn\ny\n0\n0\n")"
+  expect "$1x$2 classes reducing by reflection" "$all" "$(classes "$1\n$2\nn\nn\nn\nn\ny\nn\n0\n0\n")"
+  expect "$1x$2 classes with both" "$all" "$(classes "$1\n$2\nn\nn\nn\nn\ny\ny\n0\n0\n")"
+done
+
+# Every sorting test engine, and every bit-sliced sorting test kernel that
+# this CPU supports, with and without the nearsort2 heuristic, must find as
+# many as known.
+
+KERNELS=""
+for kernel in scalar sse2 avx2 avx-512; do
+  if printf '5\n5\nn\ny\nn\ny\ny\n0\n0\n' | "$SEARCH" --kernel $kernel 2>&1 | grep -q "with .* kernel"; then
+    KERNELS="$KERNELS $kernel"
+  fi
+done
+
+for size in "5 5 44" "6 5 12" "7 6 969" "8 6 627"; do
+  set -- $size
+  for ns2 in n y; do
+    expect "$1x$2 nearsort2 $ns2 Gray code" $3 "$(count "$1\n$2\n$ns2\nn\nn\nn\ny\ny\n0\n0\n")"
+    expect "$1x$2 nearsort2 $ns2 level tables" $3 "$(count "$1\n$2\n$ns2\nn\ny\nn\ny\ny\n0\n0\n")"
+    for kernel in $KERNELS; do
+      expect "$1x$2 nearsort2 $ns2 $kernel kernel" $3 "$(count "$1\n$2\n$ns2\ny\nn\ny\ny\n0\n0\n" --kernel $kernel)"
+    done
+  done
+done
+
+# Several threads, with and without splitting tasks so that idle threads are
+# given work donated by busy ones, must find as many as one thread.
+
+for threads in 2 4; do
+  expect "7x6 on $threads threads" 969 "$(count '7\n6\nn\nn\nn\nn\ny\ny\n0\n0\n' --threads $threads)"
+  expect "8x6 on $threads threads" 627 "$(count '8\n6\nn\nn\nn\nn\ny\ny\n0\n0\n' --threads $threads)"
+  expect "7x6 split on $threads threads" 969 "$(count '7\n6\nn\nn\nn\nn\ny\ny\n0\n2\n4\n' --threads $threads)"
+  expect "8x6 split on $threads threads" 627 "$(count '8\n6\nn\nn\nn\nn\ny\ny\n0\n2\n4\n' --threads $threads)"
+done
+
+# merged answers k: run a search as k shards on several threads, so that
+# tasks are split between threads, and print the number of sorting networks
+# found by merging their results.
+
+merged(){
+  rm -f ./*.txt ./*.json
+  i=0
+  while [ $i -lt $2 ]; do
+    printf "$1" | "$SEARCH" --threads 4 --shard $i/$2 >/dev/null 2>&1
+    i=$((i + 1))
+  done
+  "$SEARCH" --merge shard-*.txt 2>&1 | sed -n 's/^Merged .*: \([0-9]*\) found in .*/\1/p'
+}
+
+# The shards of a search must cover every task exactly once and find as many
+# as the whole search, and a merge with a shard missing must fail.
+
+expect "7x6 in 3 shards" 969 "$(merged '7\n6\nn\nn\nn\nn\ny\ny\n0\n0\n' 3)"
+expect "8x6 in 2 shards" 627 "$(merged '8\n6\nn\nn\nn\nn\ny\ny\n0\n0\n' 2)"
+expect "7x6 split in 3 shards" 969 "$(merged '7\n6\nn\nn\nn\nn\ny\ny\n0\n2\n4\n' 3)"
+rm -f shard-1-of-3.txt
+expect "merge with a shard missing" "" "$("$SEARCH" --merge shard-*.txt 2>&1 | sed -n 's/^Merged .*: \([0-9]*\) found in .*/\1/p')"
+
+# networks directory: print a checksum of the names and contents of the
+# sorting network files in a directory.
+
+networks(){
+  (cd "$1" && for file in w*.txt; do echo "$file $(cksum <"$file")"; done) | cksum
+}
+
+# distributed answers k: run a search as a coordinator on a port of the
+# loopback interface and k workers, each in a directory of its own, and print
+# the number of sorting networks that the coordinator reports.
+
+distributed(){
+  rm -rf coordinator worker-*
+  mkdir coordinator
+  port=$((20000 + $$ % 20000))
+  (cd coordinator && printf "$1" | timeout 300 "$SEARCH" --coordinate $port >out.txt 2>&1) &
+  sleep 1
+  i=0
+  while [ $i -lt $2 ]; do
+    mkdir worker-$i
+    (cd worker-$i && timeout 300 "$SEARCH" --worker 127.0.0.1:$port >/dev/null 2>&1) &
+    i=$((i + 1))
+  done
+  wait
+  sed -n 's/^\([0-9]*\) found in .*/\1/p' coordinator/out.txt
+}
+
+# A coordinator and several workers must find as many as a single process
+# on one thread, in network files with the same names and contents, since
+# both name the files after the tasks that found them.
+
+for size in "7 6 969 2 0\n" "8 6 627 3 0\n" "7 6 969 3 2\n4\n"; do
+  set -- $size
+  answers="$1\n$2\nn\nn\nn\nn\ny\ny\n0\n$5"
+  expect "$1x$2 on $4 workers" $3 "$(distributed "$answers" $4)"
+  mkdir -p single
+  (cd single && rm -f ./*.txt ./*.json &&
+    printf "$answers" | "$SEARCH" --threads 1 >/dev/null 2>&1)
+  expect "$1x$2 on $4 workers network files" "$(networks single)" "$(networks coordinator)"
+done
+
+# A search that is interrupted and resumed from its checkpoint, twice, must
+# still cover every task exactly once, including tasks donated between
+# threads, so that its result merges on its own. 9x6 has no sorting networks
+# but runs long enough on the level transfer table engine to be interrupted.
+
+interrupted(){
+  printf "$1" | timeout -s INT 2 "$SEARCH" --threads 2 --shard 0/1 2>&1 |
+    sed -n 's/^Interrupted, checkpoint saved to //p'
+}
+
+rm -f ./*.txt ./*.json
+expect "9x6 interrupted" checkpoint-0-of-1.txt "$(interrupted '9\n6\nn\nn\ny\nn\ny\ny\n0\n0\n')"
+expect "9x6 resumed and interrupted" checkpoint-0-of-1.txt "$(interrupted 'y\n')"
+printf 'y\n' | "$SEARCH" --threads 2 --shard 0/1 >/dev/null 2>&1
+expect "9x6 resumed twice" 0 "$("$SEARCH" --merge shard-0-of-1.txt 2>&1 | sed -n 's/^Merged .*: \([0-9]*\) found in .*/\1/p')"
+
+# A checkpoint with a task whose fixed levels are not matchings on the width
+# must be rejected rather than resumed.
+
+rm -f ./*.txt ./*.json
+interrupted '9\n6\nn\nn\ny\nn\ny\ny\n0\n0\n' >/dev/null
+sed 's/^\(task [0-9]* [0-9]* [0-9]*\) [0-9]*/\1 9/' checkpoint-0-of-1.txt >corrupt.txt
+mv corrupt.txt checkpoint-0-of-1.txt
+expect "9x6 corrupt checkpoint rejected" checkpoint-0-of-1.txt "$(printf 'y\n' | "$SEARCH" --threads 2 --shard 0/1 2>&1 |
+  sed -n 's/^Tasks in \(.*\) do not match its settings/\1/p')"
+
+exit $FAILED